@@ -17,7 +17,7 @@ CardComboBattleState::CardComboBattleState(SelectedCardsUI& ui, PA& programAdvan
   hasPA = -1;
   paStepIndex = 0;
 
-  programAdvanceSprite = sf::Sprite(*Textures().LoadFromFile(TexturePaths::PROGRAM_ADVANCE));
+  programAdvanceSprite = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::PROGRAM_ADVANCE));
   programAdvanceSprite.setScale(2.f, 2.f);
   programAdvanceSprite.setOrigin(0, programAdvanceSprite.getLocalBounds().height / 2.0f);
   programAdvanceSprite.setPosition(40.0f, 58.f);
@@ -22,8 +22,8 @@ CardSelectBattleState::CardSelectBattleState() :
   cardSelectInputCooldown = maxCardSelectInputCooldown;
 
   // Load assets
-  mobBackdropSprite = sf::Sprite(*Textures().LoadFromFile(TexturePaths::MOB_NAME_BACKDROP));
-  mobEdgeSprite = sf::Sprite(*Textures().LoadFromFile(TexturePaths::MOB_NAME_EDGE));
+  mobBackdropSprite = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::MOB_NAME_BACKDROP));
+  mobEdgeSprite = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::MOB_NAME_EDGE));
 
   mobBackdropSprite.setScale(2.f, 2.f);
   mobEdgeSprite.setScale(2.f, 2.f);
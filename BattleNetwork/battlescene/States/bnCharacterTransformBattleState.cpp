@@ -8,7 +8,7 @@
 
 CharacterTransformBattleState::CharacterTransformBattleState()
 {
-  shine = sf::Sprite(*Textures().LoadFromFile(TexturePaths::MOB_BOSS_SHINE));
+  shine = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::MOB_BOSS_SHINE));
   shine.setScale(2.f, 2.f);
 }
 
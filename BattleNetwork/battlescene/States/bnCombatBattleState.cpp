@@ -18,7 +18,7 @@ CombatBattleState::CombatBattleState(double customDuration) :
   pauseShader(Shaders().GetShader(ShaderType::BLACK_FADE))
 {
   // PAUSE
-  pause.setTexture(*Textures().LoadFromFile("resources/ui/pause.png"));
+  pause.setTexture(*Textures().LoadPinnedFromFile("resources/ui/pause.png"));
   pause.setScale(2.f, 2.f);
   pause.setOrigin(pause.getLocalBounds().width * 0.5f, pause.getLocalBounds().height * 0.5f);
   pause.setPosition(sf::Vector2f(240.f, 145.f));
@@ -32,16 +32,16 @@ CombatBattleState::CombatBattleState(double customDuration) :
   // COMBO DELETE AND COUNTER LABELS
   auto labelPosition = sf::Vector2f(240.0f, 50.f);
 
-  doubleDelete = sf::Sprite(*Textures().LoadFromFile(TexturePaths::DOUBLE_DELETE));
+  doubleDelete = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::DOUBLE_DELETE));
   doubleDelete.setOrigin(doubleDelete.getLocalBounds().width / 2.0f, doubleDelete.getLocalBounds().height / 2.0f);
   doubleDelete.setPosition(labelPosition);
   doubleDelete.setScale(2.f, 2.f);
 
   tripleDelete = doubleDelete;
-  tripleDelete.setTexture(*Textures().LoadFromFile(TexturePaths::TRIPLE_DELETE));
+  tripleDelete.setTexture(*Textures().LoadPinnedFromFile(TexturePaths::TRIPLE_DELETE));
 
   counterHit = doubleDelete;
-  counterHit.setTexture(*Textures().LoadFromFile(TexturePaths::COUNTER_HIT));
+  counterHit.setTexture(*Textures().LoadPinnedFromFile(TexturePaths::COUNTER_HIT));
 }
 
 const bool CombatBattleState::IsMobCleared() const
@@ -6,6 +6,7 @@
 #include "../../bnTextureResourceManager.h"
 #include "../../bnAnimatedTextBox.h"
 #include "../../bnMessage.h"
+#include "../../bnRandom.h"
 
 RetreatBattleState::RetreatBattleState(AnimatedTextBox& textbox, const sf::Sprite& mug, const Animation& anim) : 
   textbox(textbox),
@@ -16,7 +17,7 @@ RetreatBattleState::RetreatBattleState(AnimatedTextBox& textbox, const sf::Sprit
 
 void RetreatBattleState::onStart(const BattleSceneState*)
 {
-  if (rand() % 10 < 5) {
+  if (SyncedRandRange(0, 9) < 5) {
     textbox.EnqueMessage(mug, anim, new Message("\x01...\x01 It's no good!\nWe can't run away!"));
   }
   else {
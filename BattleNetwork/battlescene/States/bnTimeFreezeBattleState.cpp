@@ -46,9 +46,7 @@ void TimeFreezeBattleState::CleanupStuntDouble()
 std::shared_ptr<Character> TimeFreezeBattleState::CreateStuntDouble(std::shared_ptr<Character> from)
 {
   CleanupStuntDouble();
-  std::shared_ptr<StuntDouble> stuntDouble = std::make_shared<StuntDouble>(from);
-  stuntDouble->Init();
-  return stuntDouble;
+  return stuntDoubles.Acquire(from);
 }
 
 void TimeFreezeBattleState::SkipToAnimateState()
@@ -212,7 +210,7 @@ void TimeFreezeBattleState::onUpdate(double elapsed)
 
 void TimeFreezeBattleState::onDraw(sf::RenderTexture& surface)
 {
-  static sf::Sprite alertSprite(*Textures().LoadFromFile("resources/ui/alert.png"));
+  static sf::Sprite alertSprite(*Textures().LoadPinnedFromFile("resources/ui/alert.png"));
   static sf::RectangleShape bar;
 
   if (tfEvents.empty()) return;
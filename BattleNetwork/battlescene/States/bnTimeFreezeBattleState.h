@@ -9,6 +9,7 @@
 #include "../../bnText.h"
 #include "../../bnCardAction.h"
 #include "../../bnCardUseListener.h"
+#include "../../bnStuntDouble.h"
 #include "../../frame_time_t.h"
 
 class Character;
@@ -43,6 +44,7 @@ struct TimeFreezeBattleState final : public BattleSceneState, CardActionUseListe
   frame_time_t summonTick{ frames(0) };
   double backdropInc{ 1.25 }; //!< alpha increase per frame (max 255)
   std::vector<EventData> tfEvents;
+  StuntDoublePool stuntDoubles; /*!< Reused by every time freeze in the battle */
   Text summonsLabel = Text(Font::Style::thick);
   mutable Text multiplier;
   mutable Text dmg; /*!< Text displays card damage */
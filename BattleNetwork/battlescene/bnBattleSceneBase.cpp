@@ -1,6 +1,7 @@
 #include "bnBattleSceneBase.h"
 
 #include <assert.h>
+#include <set>
 #include <Segues/WhiteWashFade.h>
 #include <Segues/BlackWashFade.h>
 #include <Segues/PixelateBlackWashFade.h>
@@ -10,6 +11,7 @@
 #include "../bnInputManager.h"
 #include "../bnMob.h"
 #include "../bnCardAction.h"
+#include "../bnCardFolder.h"
 #include "../bnPlayerHealthUI.h"
 #include "../bnPlayerEmotionUI.h"
 #include "../bnUndernetBackground.h"
@@ -25,6 +27,7 @@
 #include "../bnVirusBackground.h"
 #include "../bnFadeInState.h"
 #include "../bnRandom.h"
+#include "../bnProfiler.h"
 
 // Combos are counted if more than one enemy is hit within x frames
 // The game is clocked to display 60 frames per second
@@ -35,9 +38,42 @@ using swoosh::types::segue;
 using swoosh::Activity;
 using swoosh::ActivityController;
 
+namespace {
+  std::vector<PackageAssets> BattlePackages(const BattleSceneBaseProps& props, CardPackagePartitioner& partitions) {
+    std::vector<PackageAssets> packages = props.preloadPackages;
+
+    if (!props.folder) return packages;
+
+    std::set<std::string> seen;
+
+    for (auto iter = props.folder->Begin(); iter != props.folder->End(); iter++) {
+      const std::string uuid = (*iter)->GetUUID();
+
+      if (!seen.insert(uuid).second) continue;
+
+      stx::result_t<PackageAddress> maybe_addr = PackageAddress::FromStr(uuid);
+
+      if (maybe_addr.is_error()) continue;
+
+      PackageAddress addr = maybe_addr.value();
+
+      if (!partitions.HasNamespace(addr.namespaceId)) continue;
+
+      CardPackageManager& cardPackageManager = partitions.GetPartition(addr.namespaceId);
+
+      if (cardPackageManager.HasPackage(addr.packageId)) {
+        packages.push_back(PackageAssets::Of(cardPackageManager.FindPackageByID(addr.packageId)));
+      }
+    }
+
+    return packages;
+  }
+}
+
 BattleSceneBase::BattleSceneBase(ActivityController& controller, BattleSceneBaseProps& props, BattleResultsFunc onEnd) :
   Scene(controller),
   cardActionListener(this->getController().CardPackagePartitioner()),
+  preloader(BattlePackages(props, getController().CardPackagePartitioner())),
   localPlayer(props.player),
   programAdvance(props.programAdvance),
   comboDeleteCounter(0),
@@ -133,8 +169,8 @@ BattleSceneBase::BattleSceneBase(ActivityController& controller, BattleSceneBase
   counterCombatRule = std::make_shared<CounterCombatRule>(this);
 
   // MOB UI
-  mobBackdropSprite = sf::Sprite(*Textures().LoadFromFile(TexturePaths::MOB_NAME_BACKDROP));
-  mobEdgeSprite = sf::Sprite(*Textures().LoadFromFile(TexturePaths::MOB_NAME_EDGE));
+  mobBackdropSprite = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::MOB_NAME_BACKDROP));
+  mobEdgeSprite = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::MOB_NAME_EDGE));
 
   mobBackdropSprite.setScale(2.f, 2.f);
   mobEdgeSprite.setScale(2.f, 2.f);
@@ -621,6 +657,7 @@ void BattleSceneBase::StartStateGraph(StateNode& start) {
 void BattleSceneBase::onStart()
 {
   isSceneInFocus = true;
+  preloader.BeginTracking();
 
   // Stream battle music
   if (blueTeamMob && blueTeamMob->HasCustomMusicPath()) {
@@ -638,6 +675,7 @@ void BattleSceneBase::onStart()
 }
 
 void BattleSceneBase::onUpdate(double elapsed) {
+  BN_PROFILE_ZONE("BattleSceneBase::onUpdate");
   this->elapsed = elapsed;
 
   if (getController().CommandLineValue<bool>("debug")) {
@@ -828,6 +866,7 @@ void BattleSceneBase::onUpdate(double elapsed) {
 }
 
 void BattleSceneBase::onDraw(sf::RenderTexture& surface) {
+  BN_PROFILE_ZONE("BattleSceneBase::onDraw");
   int tint = static_cast<int>((1.0f - backdropOpacity) * 255);
 
   if (!backdropAffectBG) {
@@ -838,17 +877,22 @@ void BattleSceneBase::onDraw(sf::RenderTexture& surface) {
 
   surface.draw(*background);
 
-  auto uis = std::vector<std::shared_ptr<UIComponent>>();
+  // The tile layout never changes after the field is made
+  if (drawTiles.empty()) {
+    drawTiles = field->FindTiles([](Battle::Tile* tile) { return true; });
+  }
 
-  std::vector<Battle::Tile*> allTiles = field->FindTiles([](Battle::Tile* tile) { return true; });
   sf::Vector2f viewOffset = getController().CameraViewOffset(camera);
+  const sf::Color tintColor = sf::Color(tint, tint, tint, 255);
+  const bool isCleared = (redTeamMob && redTeamMob->IsCleared()) || (blueTeamMob && blueTeamMob->IsCleared());
 
-  for (Battle::Tile* tile : allTiles) {
+  // Tiles in a row never overlap so they share a depth and are batched by texture.
+  // The bottom lip of a tile overlaps the row below it so rows keep their order.
+  for (Battle::Tile* tile : drawTiles) {
     if (tile->IsEdgeTile()) continue;
 
     bool yellowBlock = false;
 
-    bool isCleared = (redTeamMob && redTeamMob->IsCleared()) || (blueTeamMob && blueTeamMob->IsCleared());
     if (tile->IsHighlighted() && !isCleared) {
       if (!yellowShader) {
         yellowBlock = true;
@@ -862,101 +906,133 @@ void BattleSceneBase::onDraw(sf::RenderTexture& surface) {
       tile->setColor(sf::Color::White);
     }
 
+    const uint64_t depth = RenderQueue::Depth(1, tile->GetY());
     sf::Vector2f flipOffset = PerspectiveOffset(tile->getPosition());
-    tile->PerspectiveFlip(perspectiveFlip);
-    tile->move(viewOffset + flipOffset);
-    tile->setColor(sf::Color(tint, tint, tint, 255));
-    surface.draw(*tile);
-    tile->setColor(sf::Color::White);
+    sf::RenderStates states;
+    states.transform.translate(viewOffset + flipOffset);
+
+    if (tile->GetShader().HasShader() || tile->GetChildNodes().size()) {
+      // Drawn as-is when the queue is flushed so the tile has to be set up again at that time
+      renderQueue.Push(depth, [tile, states, tintColor, flip = perspectiveFlip](sf::RenderTarget& target) {
+        tile->PerspectiveFlip(flip);
+        tile->setColor(tintColor);
+        target.draw(*tile, states);
+        tile->setColor(sf::Color::White);
+        tile->PerspectiveFlip(false);
+      });
+    }
+    else if (tile->IsVisible()) {
+      // Sprites are baked into vertices when pushed
+      tile->PerspectiveFlip(perspectiveFlip);
+      tile->setColor(tintColor);
+      states.transform *= tile->getTransform();
+      renderQueue.Push(depth, tile->getSpriteConst(), states);
+      tile->setColor(sf::Color::White);
+      tile->PerspectiveFlip(false);
+    }
 
     if (yellowBlock) {
-      sf::RectangleShape block;
-      block.setSize({40, 30});
-      block.setScale(2.f, 2.f);
-      block.setOrigin(20, 15);
-      block.setFillColor(sf::Color::Yellow);
-      block.setPosition(tile->getPosition());
-      surface.draw(block);
+      sf::Vector2f position = tile->getPosition() + viewOffset + flipOffset;
+
+      renderQueue.Push(RenderQueue::Depth(1, tile->GetY(), 1), [position](sf::RenderTarget& target) {
+        sf::RectangleShape block;
+        block.setSize({40, 30});
+        block.setScale(2.f, 2.f);
+        block.setOrigin(20, 15);
+        block.setFillColor(sf::Color::Yellow);
+        block.setPosition(position);
+        target.draw(block);
+      });
     }
-
-    tile->move(-(viewOffset+flipOffset));
-    tile->PerspectiveFlip(false);
   }
 
-  std::vector<Entity*> allEntities;
+  drawEntities.clear();
 
-  for (Battle::Tile* tile : allTiles) {
-    std::vector<Entity*> tileEntities;
-    tile->FindEntities([&tileEntities, &allEntities](std::shared_ptr<Entity>& ent) {
-      tileEntities.push_back(ent.get());
-      allEntities.push_back(ent.get());
+  for (Battle::Tile* tile : drawTiles) {
+    drawTileEntities.clear();
+    tile->FindEntities([this](std::shared_ptr<Entity>& ent) {
+      drawTileEntities.push_back(ent.get());
       return false;
     });
 
-    std::sort(tileEntities.begin(), tileEntities.end(), [](Entity* A, Entity* B) { return A->GetLayer() > B->GetLayer(); });
+    std::sort(drawTileEntities.begin(), drawTileEntities.end(), [](Entity* A, Entity* B) { return A->GetLayer() > B->GetLayer(); });
 
-    for (Entity* node : tileEntities) {
+    for (Entity* node : drawTileEntities) {
       sf::Vector2f offset = viewOffset + sf::Vector2f(0, -node->GetElevation());
       sf::Vector2f flipOffset = PerspectiveOffset(node->getPosition());
-      node->move(offset+flipOffset);
-
-      sf::Vector2f ogScale = node->getScale();
+      sf::RenderStates states;
+      states.transform.translate(offset + flipOffset);
 
       if (perspectiveFlip) {
-        node->setScale(-ogScale.x, ogScale.y);
+        // mirror the entity about its own position
+        const sf::Vector2f pos = node->getPosition();
+        states.transform.translate(pos).scale(-1.f, 1.f).translate(-pos);
       }
 
       node->ShiftShadow();
-      surface.draw(*node);
-
-      if (perspectiveFlip) {
-        node->setScale(ogScale.x, ogScale.y);
-      }
 
-      node->move(-(offset+flipOffset));
+      // Entities are not batched. They draw their children and apply their shader uniforms while drawn,
+      // so each one stays a whole drawable and the queue only sorts them.
+      renderQueue.Push(RenderQueue::Depth(2, drawEntities.size()), *node, states);
+      drawEntities.push_back(node);
     }
   }
 
-  std::vector<Character*> allCharacters;
+  drawCharacters.clear();
+  size_t uiCount = 0;
 
   // draw ui on top
-  for (Entity* ent : allEntities) {
+  for (Entity* ent : drawEntities) {
     std::vector<std::shared_ptr<UIComponent>> uis = ent->GetComponentsDerivedFrom<UIComponent>();
     sf::Vector2f flipOffset = PerspectiveOffset(ent->getPosition());
+    sf::RenderStates states;
+    states.transform.translate(viewOffset + flipOffset);
+
     for (std::shared_ptr<UIComponent>& ui : uis) {
       if (ui->DrawOnUIPass()) {
-        ui->move(viewOffset + flipOffset);
-        surface.draw(*ui);
-        ui->move(-(viewOffset + flipOffset));
+        renderQueue.Push(RenderQueue::Depth(3, uiCount++), *ui, states);
       }
     }
 
     // collect characters while drawing ui
     if (Character* character = dynamic_cast<Character*>(ent)) {
-      allCharacters.push_back(character);
+      drawCharacters.push_back(character);
     }
   }
 
+  size_t actionCount = 0;
+
   // draw extra card action graphics
-  for (Character* c : allCharacters) {
+  for (Character* c : drawCharacters) {
     const std::vector<std::shared_ptr<CardAction>> actionList = c->AsyncActionList();
     std::shared_ptr<CardAction> currAction = c->CurrentCardAction();
 
     for (const std::shared_ptr<CardAction>& action : actionList) {
-      surface.draw(*action);
+      renderQueue.Push(RenderQueue::Depth(4, actionCount++), *action);
     }
 
     if (currAction) {
-      surface.draw(*currAction);
+      renderQueue.Push(RenderQueue::Depth(4, actionCount++), *currAction);
     }
   }
 
+  {
+    BN_PROFILE_ZONE("RenderQueue::Flush");
+    renderQueue.Flush(surface);
+  }
+
+  const RenderQueue::Stats& stats = renderQueue.GetStats();
+  Profiler::SetCounter("field items", static_cast<int64_t>(stats.items));
+  Profiler::SetCounter("field draw calls", static_cast<int64_t>(stats.drawCalls));
+
   // Draw whatever extra state stuff we want to have
   if (current) current->onDraw(surface);
 }
 
 void BattleSceneBase::onEnd()
 {
+  preloader.LogHitRate();
+
   if (onEndCallback) {
     onEndCallback(battleResults);
   }
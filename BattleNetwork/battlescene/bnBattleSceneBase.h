@@ -28,6 +28,8 @@
 #include "../bnPlayerEmotionUI.h"
 #include "../bnBattleResults.h"
 #include "../bnEventBus.h"
+#include "../bnRenderQueue.h"
+#include "../bnAssetPreloader.h"
 
 // Battle scene specific classes
 #include "bnBattleSceneState.h"
@@ -66,6 +68,7 @@ struct BattleSceneBaseProps {
   std::unique_ptr<CardFolder> folder{ nullptr };
   std::shared_ptr<Field> field{ nullptr };
   std::shared_ptr<Background> background{ nullptr };
+  std::vector<PackageAssets> preloadPackages{}; //!< Mob and player packages. Card packages are found from the folder.
 };
 
 /**
@@ -108,6 +111,7 @@ private:
   double backdropFadeIncrements{ 125 }; /*!< x/255 per tick */
   double backdropMaxOpacity{ 1.0 };
   RealtimeCardActionUseListener cardActionListener; /*!< Card use listener handles one card at a time */
+  AssetPreloader preloader; /*!< Loads package assets before the folder is handed to cardCustGUI */
   std::shared_ptr<PlayerSelectedCardsUI> cardUI{ nullptr }; /*!< Player's Card UI implementation */
   std::shared_ptr<PlayerEmotionUI> emotionUI{ nullptr }; /*!< Player's Emotion Window */
   Camera camera; /*!< Camera object - will shake screen */
@@ -159,6 +163,12 @@ private:
   sf::Shader* backdropShader;
   sf::Vector2u textureSize; /*!< Size of distorton effect */
 
+  // draw pass
+  RenderQueue renderQueue; /*!< Batches tiles and orders everything drawn on the field */
+  std::vector<Battle::Tile*> drawTiles; /*!< Every tile on the field, cached on first draw */
+  std::vector<Entity*> drawEntities, drawTileEntities; /*!< Scratch lists reused every frame */
+  std::vector<Character*> drawCharacters;
+
   // backdrop status enum
   enum class backdrop : int {
     fadeout = 0,
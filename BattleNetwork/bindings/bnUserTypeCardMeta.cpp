@@ -54,6 +54,9 @@ void DefineCardMetaUserTypes(ScriptResourceManager* scriptManager, sol::state& s
     "set_preview_texture", &CardMeta::SetPreviewTexture,
     "set_icon_texture", &CardMeta::SetIconTexture,
     "set_codes", &CardMeta::SetCodes,
+    "declare_asset", [] (CardMeta& meta, const std::string& path) {
+      meta.DeclareAsset(path);
+    },
     "declare_package_id", [setPackageId] (CardMeta& meta, const std::string& packageId) {
       setPackageId(packageId);
       meta.SetPackageID(packageId);
@@ -3,6 +3,7 @@ using sf::Sprite;
 using sf::IntRect;
 
 #include "bnAnimation.h"
+#include "bnAnimationBinary.h"
 #include "bnFileUtil.h"
 #include "bnLogger.h"
 #include "bnEntity.h"
@@ -10,17 +11,42 @@ using sf::IntRect;
 #include <chrono>
 #include <string_view>
 #include <cstdlib>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+namespace {
+  // Parsed files stay cached only while some animation is using them
+  std::mutex cacheMutex;
+  std::unordered_map<std::string, std::weak_ptr<const Animation::FrameLists>> cache;
+  Animation::CacheStats cacheStats;
+  bool recordCacheMisses{ false };
+  std::set<std::string> cacheMisses;
+
+  const std::shared_ptr<const Animation::FrameLists>& NoFrameLists() {
+    static const std::shared_ptr<const Animation::FrameLists> empty = std::make_shared<const Animation::FrameLists>();
+    return empty;
+  }
 
-Animation::Animation() : animator(), path("") {
+  const FrameList& NoFrameList() {
+    static const FrameList empty;
+    return empty;
+  }
+}
+
+Animation::Animation() : animator(), path(""), animations(NoFrameLists()) {
   progress = frames(0);
+  ResolveCurrent();
 }
 
-Animation::Animation(const char* _path) : animator(), path(std::string(_path)) {
+Animation::Animation(const char* _path) : animator(), path(std::string(_path)), animations(NoFrameLists()) {
   Reload();
+  ResolveCurrent();
 }
 
-Animation::Animation(const string& _path) : animator(), path(_path) {
+Animation::Animation(const string& _path) : animator(), path(_path), animations(NoFrameLists()) {
   Reload();
+  ResolveCurrent();
 }
 
 Animation::Animation(const Animation& rhs) {
@@ -31,10 +57,12 @@ Animation & Animation::operator=(const Animation & rhs)
 {
   noAnim = rhs.noAnim;
   animations = rhs.animations;
+  ownsAnimations = false;
   animator = rhs.animator;
   currAnimation = rhs.currAnimation;
   path = rhs.path;
   progress = rhs.progress;
+  ResolveCurrent();
   return *this;
 }
 
@@ -48,8 +76,8 @@ void Animation::CopyFrom(const Animation& rhs)
 
 void Animation::Reload() {
   if (path != "") {
-    string data = FileUtil::Read(path);
-    LoadWithData(data);
+    progress = frames(0);
+    Merge(LoadShared(path), false);
   }
 }
 
@@ -150,8 +178,129 @@ static bool GetBoolValue(std::string_view line, std::string_view key) {
   return valueView == "1" || valueView == "true";
 }
 
+std::shared_ptr<const Animation::FrameLists> Animation::LoadShared(const string& path, bool counted)
+{
+  {
+    std::scoped_lock lock(cacheMutex);
+    auto iter = cache.find(path);
+
+    if (iter != cache.end()) {
+      if (std::shared_ptr<const FrameLists> cached = iter->second.lock()) {
+        if (counted) cacheStats.hits++;
+        return cached;
+      }
+    }
+
+    if (counted) {
+      cacheStats.misses++;
+
+      if (recordCacheMisses) {
+        cacheMisses.insert(path);
+      }
+    }
+  }
+
+  // Read and parse without the lock so loading threads do not wait on each other
+  FrameLists lists;
+
+  if (!AnimationBinary::Load(path, lists)) {
+    lists = Parse(FileUtil::Read(path), path);
+  }
+
+  std::shared_ptr<const FrameLists> parsed = std::make_shared<const FrameLists>(std::move(lists));
+
+  std::scoped_lock lock(cacheMutex);
+  std::weak_ptr<const FrameLists>& entry = cache[path];
+
+  // Another thread may have finished parsing the same file first
+  if (std::shared_ptr<const FrameLists> cached = entry.lock()) {
+    return cached;
+  }
+
+  entry = parsed;
+
+  for (auto iter = cache.begin(); iter != cache.end();) {
+    iter = iter->second.expired() ? cache.erase(iter) : std::next(iter);
+  }
+
+  return parsed;
+}
+
+Animation::CacheStats Animation::GetCacheStats()
+{
+  std::scoped_lock lock(cacheMutex);
+  return cacheStats;
+}
+
+void Animation::RecordCacheMisses(bool enabled)
+{
+  std::scoped_lock lock(cacheMutex);
+  recordCacheMisses = enabled;
+}
+
+std::vector<std::string> Animation::TakeCacheMisses()
+{
+  std::scoped_lock lock(cacheMutex);
+  std::vector<std::string> out(cacheMisses.begin(), cacheMisses.end());
+  cacheMisses.clear();
+  return out;
+}
+
+void Animation::Merge(const std::shared_ptr<const FrameLists>& loaded, bool owned)
+{
+  if (animations->empty()) {
+    animations = loaded;
+    ownsAnimations = owned;
+    ResolveCurrent();
+    return;
+  }
+
+  FrameLists& lists = EditAnimations();
+
+  for (const auto& [state, list] : *loaded) {
+    lists.insert(std::make_pair(state, list));
+  }
+
+  ResolveCurrent();
+}
+
+Animation::FrameLists& Animation::EditAnimations()
+{
+  if (!ownsAnimations || animations.use_count() > 1) {
+    animations = std::make_shared<FrameLists>(*animations);
+    ownsAnimations = true;
+    ResolveCurrent();
+  }
+
+  // Owned maps are never created const and only this instance refers to it
+  return const_cast<FrameLists&>(*animations);
+}
+
+const FrameList& Animation::FindFrameList(const std::string& state) const
+{
+  auto iter = animations->find(state);
+
+  if (iter == animations->end()) {
+    return NoFrameList();
+  }
+
+  return iter->second;
+}
+
+void Animation::ResolveCurrent()
+{
+  current = &FindFrameList(currAnimation);
+}
+
 void Animation::LoadWithData(const string& data)
 {
+  progress = frames(0);
+  Merge(std::make_shared<FrameLists>(Parse(data, path)), true);
+}
+
+Animation::FrameLists Animation::Parse(const string& data, const string& path)
+{
+  FrameLists animations;
   int frameAnimationIndex = -1;
   vector<FrameList> frameLists;
   string currentState = "";
@@ -159,7 +308,6 @@ void Animation::LoadWithData(const string& data)
   int currentWidth = 0;
   int currentHeight = 0;
   bool legacySupport = false;
-  progress = frames(0);
 
   std::string_view dataView = data;
   size_t endLine = 0;
@@ -281,9 +429,7 @@ void Animation::LoadWithData(const string& data)
       int x = GetIntValue(line, "x");
       int y = GetIntValue(line, "y");
 
-      std::transform(pointName.begin(), pointName.end(), pointName.begin(), ::toupper);
-
-      frameLists[frameAnimationIndex].SetPoint(pointName, x, y);
+      frameLists[frameAnimationIndex].SetPoint(AnimationPointId(pointName), x, y);
     }
 
   } while (endLine < data.length());
@@ -293,6 +439,8 @@ void Animation::LoadWithData(const string& data)
     std::transform(currentState.begin(), currentState.end(), currentState.begin(), ::toupper);
     animations.insert(std::make_pair(currentState, frameLists.at(frameAnimationIndex)));
   }
+
+  return animations;
 }
 
 void Animation::HandleInterrupted()
@@ -300,7 +448,7 @@ void Animation::HandleInterrupted()
   if (handlingInterrupt) return;
   handlingInterrupt = true;
 
-  if (interruptCallback && progress < animations[currAnimation].GetTotalDuration()) {
+  if (interruptCallback && progress < current->GetTotalDuration()) {
     interruptCallback();
     interruptCallback = nullptr;
   }
@@ -315,26 +463,29 @@ void Animation::Refresh(sf::Sprite& target) {
 void Animation::Update(double elapsed, sf::Sprite& target) {
   progress += frames(std::ceil(elapsed * (float)std::fabs(playbackSpeed)));
 
-  std::string stateNow = currAnimation;
+  const uint32_t stateNow = stateChanges;
+
+  // Callbacks may edit or reload this animation. Keep the frame list being played alive.
+  const std::shared_ptr<const FrameLists> playing = animations;
 
   if (noAnim == false) {
-    animator(progress, target, animations[currAnimation]);
+    animator(progress, target, *current);
   }
   else {
     // effectively hide
     target.setTextureRect(sf::IntRect(0, 0, 0, 0));
   }
 
-  if(currAnimation != stateNow) {
+  if(stateChanges != stateNow) {
     // it was changed during a callback
     // apply new state to target on same frame
-    animator(frames(0), target, animations[currAnimation]);
+    animator(frames(0), target, *current);
     progress = frames(0);
     
     HandleInterrupted();
   }
 
-  const frame_time_t duration = animations[currAnimation].GetTotalDuration();
+  const frame_time_t duration = current->GetTotalDuration();
 
   if(duration <= frames(0)) return;
 
@@ -348,7 +499,7 @@ void Animation::SyncTime(frame_time_t newTime)
 {
   progress = newTime;
 
-  const frame_time_t duration = animations[currAnimation].GetTotalDuration();
+  const frame_time_t duration = current->GetTotalDuration();
 
   if (duration <= frames(0)) return;
 
@@ -360,21 +511,22 @@ void Animation::SyncTime(frame_time_t newTime)
 
 void Animation::SetFrame(int frame, sf::Sprite& target)
 {
-  if(path.empty() || animations.empty() || animations.find(currAnimation) == animations.end()) return;
+  if(path.empty() || animations->empty() || animations->find(currAnimation) == animations->end()) return;
 
-  auto size = animations[currAnimation].GetFrameCount();
+  const FrameList& list = *current;
+  auto size = list.GetFrameCount();
 
   if (frame <= 0 || frame > size) {
     progress = frames(0);
-    animator.SetFrame(int(size), target, animations[currAnimation]);
+    animator.SetFrame(int(size), target, list);
 
   }
   else {
-    animator.SetFrame(frame, target, animations[currAnimation]);
+    animator.SetFrame(frame, target, list);
     progress = frames(0);
 
     while (frame) {
-      progress += animations[currAnimation].GetFrame(--frame).duration;
+      progress += list.GetFrame(--frame).duration;
     }
   }
 }
@@ -386,11 +538,11 @@ void Animation::SetAnimation(string state) {
 
   std::transform(state.begin(), state.end(), state.begin(), ::toupper);
 
-  auto pos = animations.find(state);
+  auto pos = animations->find(state);
 
   noAnim = false; // presumptious reset
 
-  if (pos == animations.end()) {
+  if (pos == animations->end()) {
 #ifdef BN_LOG_MISSING_STATE
     Logger::Log("No animation found in file for \"" + state + "\"");
 #endif
@@ -402,6 +554,8 @@ void Animation::SetAnimation(string state) {
 
   // Even if we don't have this animation, switch to it anyway
   currAnimation = state;
+  stateChanges++;
+  ResolveCurrent();
 }
 
 void Animation::RemoveCallbacks()
@@ -415,10 +569,10 @@ const std::string Animation::GetAnimationString() const
   return currAnimation;
 }
 
-FrameList & Animation::GetFrameList(std::string animation)
+const FrameList& Animation::GetFrameList(std::string animation) const
 {
   std::transform(animation.begin(), animation.end(), animation.begin(), ::toupper);
-  return animations[animation];
+  return FindFrameList(animation);
 }
 
 Animation & Animation::operator<<(const Animator::On& rhs)
@@ -445,12 +599,12 @@ void Animation::operator<<(const std::function<void()>& onFinish)
 
 sf::Vector2f Animation::GetPoint(const std::string & pointName)
 {
-  std::string point = pointName;
-  std::transform(point.begin(), point.end(), point.begin(), ::toupper);
-
-  auto res = animator.GetPoint(point);
+  return animator.GetPoint(pointName);
+}
 
-  return res;
+sf::Vector2f Animation::GetPoint(PointId point) const
+{
+  return animator.GetPoint(point);
 }
 
 char Animation::GetMode()
@@ -460,9 +614,9 @@ char Animation::GetMode()
 
 frame_time_t Animation::GetStateDuration(const std::string& state) const
 {
-  auto iter = animations.find(state);
+  auto iter = animations->find(state);
   
-  if (iter != animations.end()) {
+  if (iter != animations->end()) {
     return iter->second.GetTotalDuration();
   }
   
@@ -478,15 +632,18 @@ void Animation::OverrideAnimationFrames(const std::string& animation, const std:
     uuid = animation + "@" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
   }
 
-  if (animations.find(uuid) != animations.end()) return;
+  if (animations->find(uuid) != animations->end()) return;
 
-  animations.emplace(uuid, std::move(animations[animation].MakeNewFromOverrideData(data)));
+  FrameList overrides = FindFrameList(animation).MakeNewFromOverrideData(data);
+  EditAnimations().emplace(uuid, std::move(overrides));
 }
 
 void Animation::SyncAnimation(Animation& other)
 {
   other.progress = progress;
   other.currAnimation = currAnimation;
+  other.stateChanges++;
+  other.ResolveCurrent();
 }
 
 void Animation::SetInterruptCallback(const std::function<void()> onInterrupt)
@@ -496,7 +653,7 @@ void Animation::SetInterruptCallback(const std::function<void()> onInterrupt)
 
 const bool Animation::HasAnimation(const std::string& state) const
 {
-  return animations.find(state) != animations.end();
+  return animations->find(state) != animations->end();
 }
 
 const double Animation::GetPlaybackSpeed() const
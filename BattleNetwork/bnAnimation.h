@@ -4,6 +4,9 @@
 #include <functional>
 
 #include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
 
 #include "bnAnimator.h"
 
@@ -44,9 +47,47 @@ using std::to_string;
  * ```
  *
  * etc.
+ *
+ * Each file is parsed once. Every animation loaded from the same path shares
+ * the parsed frame lists until one of them is edited, e.g. with
+ * OverrideAnimationFrames(), which gives that animation its own copy.
  */
 class Animation {
 public:
+  using FrameLists = std::map<string, FrameList>;
+
+  /**
+   * @brief Parses the text of an animation file
+   * @param path used in error messages
+   */
+  static FrameLists Parse(const string& data, const string& path);
+
+  /*! \brief Requests made to the shared frame list cache */
+  struct CacheStats {
+    size_t hits{};
+    size_t misses{}; //!< Requests that read and parsed the file
+  };
+
+  /**
+   * @brief Parsed frame lists for a file, shared with every other animation using it
+   * @param counted if false the request is left out of GetCacheStats() and the recorded misses
+   *
+   * The file stays cached as long as the returned pointer is held
+   */
+  static std::shared_ptr<const FrameLists> LoadShared(const string& path, bool counted = true);
+
+  static CacheStats GetCacheStats();
+
+  /**
+   * @brief While enabled, paths that had to be parsed are kept for TakeCacheMisses()
+   */
+  static void RecordCacheMisses(bool enabled);
+
+  /**
+   * @brief Paths missed while recording since the last call, each listed once
+   */
+  static std::vector<string> TakeCacheMisses();
+
   /**
    * @brief No frame list is loaded*/
   Animation();
@@ -140,9 +181,9 @@ public:
    * @brief Get the frame list corresponding to this animation state
    * @param animation name of the animation
    * @return FrameList&
-   * @warning Make sure this animation exists otherwise could return an empty frame list or throw
+   * @warning Make sure this animation exists otherwise returns an empty frame list
    */
-  FrameList& GetFrameList(std::string animation);
+  const FrameList& GetFrameList(std::string animation) const;
 
   /**
    * @brief Append frame callback
@@ -173,6 +214,11 @@ public:
 
   sf::Vector2f GetPoint(const std::string& pointName);
 
+  /**
+   * @brief Point lookup without the name search. Get the id once with AnimationPointId().
+   */
+  sf::Vector2f GetPoint(PointId point) const;
+
   char GetMode();
 
   frame_time_t GetStateDuration(const std::string& state) const;
@@ -204,6 +250,29 @@ public:
 
 private:
   void HandleInterrupted();
+
+  /**
+   * @brief Frame list for a state or an empty list if there is none
+   */
+  const FrameList& FindFrameList(const std::string& state) const;
+
+  /**
+   * @brief Points current at the frame list of currAnimation. Call when either changes.
+   */
+  void ResolveCurrent();
+
+  /**
+   * @brief Frame lists this animation may change. Copies them first if they are shared.
+   */
+  FrameLists& EditAnimations();
+
+  /**
+   * @brief Adds states that are not loaded yet. Existing states are kept.
+   * @param loaded parsed frame lists
+   * @param owned true if no other animation or the cache refers to loaded
+   */
+  void Merge(const std::shared_ptr<const FrameLists>& loaded, bool owned);
+
 protected:
   bool noAnim{ false }; /*!< If the requested state was not found, hide the sprite when updating */
   bool handlingInterrupt{ false }; /*!< Whether or not the interupt handler is executing (for nested animations) */
@@ -212,6 +281,9 @@ protected:
   string currAnimation; /*!< Name of the current animation state */
   frame_time_t progress; /*!< Current progress of animation */
   double playbackSpeed{ 1.0 }; /*!< Factor to multiply against update `dt`*/
-  std::map<string, FrameList> animations; /*!< Dictionary of FrameLists read from file */
+  std::shared_ptr<const FrameLists> animations; /*!< Dictionary of FrameLists read from file. May be shared. */
+  bool ownsAnimations{ false }; /*!< animations was made by this instance and is not in the cache */
+  const FrameList* current{ nullptr }; /*!< Frame list of currAnimation so updates skip the lookup */
+  uint32_t stateChanges{}; /*!< Incremented by SetAnimation() to detect changes made by callbacks */
   std::function<void()> interruptCallback;
 };
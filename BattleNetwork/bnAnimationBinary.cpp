@@ -0,0 +1,417 @@
+#include "bnAnimationBinary.h"
+#include "bnFileUtil.h"
+#include "bnLogger.h"
+#include "bnMappedFile.h"
+#include "crypto/md5.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+  const char ANIMATION_MAGIC[4] = { 'O', 'N', 'B', 'A' };
+  constexpr size_t SOURCE_HASH_SIZE = 16;
+  constexpr int64_t UNKNOWN_MODIFIED = 0;
+
+  enum FrameFlags : uint8_t {
+    applyOrigin = 1 << 0,
+    flipX = 1 << 1,
+    flipY = 1 << 2
+  };
+
+  void WriteVarint(std::string& out, uint64_t value) {
+    do {
+      unsigned char byte = value & 0x7F;
+      value >>= 7;
+
+      if (value) {
+        byte |= 0x80;
+      }
+
+      out.push_back(static_cast<char>(byte));
+    } while (value);
+  }
+
+  void WriteSigned(std::string& out, int64_t value) {
+    WriteVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+  }
+
+  void WriteFloat(std::string& out, float value) {
+    uint32_t bits{};
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    for (int i = 0; i < 4; i++) {
+      out.push_back(static_cast<char>((bits >> (i * 8)) & 0xFF));
+    }
+  }
+
+  void WriteString(std::string& out, const std::string& str) {
+    WriteVarint(out, str.size());
+    out += str;
+  }
+
+  //!< Reads values out of a compiled animation. Any read past the end flags the reader as failed.
+  struct AnimationReader {
+    const char* data;
+    size_t size;
+    size_t pos{};
+    bool failed{};
+
+    uint64_t Varint() {
+      uint64_t value{};
+      unsigned shift{};
+
+      while (!failed) {
+        if (pos >= size || shift > 63) {
+          failed = true;
+          break;
+        }
+
+        unsigned char byte = static_cast<unsigned char>(data[pos++]);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0) break;
+
+        shift += 7;
+      }
+
+      return value;
+    }
+
+    int64_t Signed() {
+      uint64_t value = Varint();
+      return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    uint8_t Byte() {
+      if (failed || pos >= size) {
+        failed = true;
+        return 0;
+      }
+
+      return static_cast<uint8_t>(data[pos++]);
+    }
+
+    float Float() {
+      if (failed || size - pos < 4) {
+        failed = true;
+        return 0.f;
+      }
+
+      uint32_t bits{};
+      for (int i = 0; i < 4; i++) {
+        bits |= static_cast<uint32_t>(static_cast<unsigned char>(data[pos++])) << (i * 8);
+      }
+
+      float value{};
+      std::memcpy(&value, &bits, sizeof(value));
+      return value;
+    }
+
+    std::string String() {
+      uint64_t len = Varint();
+
+      if (failed || len > size - pos) {
+        failed = true;
+        return {};
+      }
+
+      std::string out(data + pos, static_cast<size_t>(len));
+      pos += static_cast<size_t>(len);
+      return out;
+    }
+
+    std::string Bytes(size_t len) {
+      if (failed || len > size - pos) {
+        failed = true;
+        return {};
+      }
+
+      std::string out(data + pos, len);
+      pos += len;
+      return out;
+    }
+  };
+
+  std::string SourceHash(const std::string& source) {
+    std::string digest(SOURCE_HASH_SIZE, '\0');
+    MD5(digest.data(), const_cast<char*>(source.data()), source.size());
+    return digest;
+  }
+
+  //!< What the file system says about a text file without reading it
+  struct SourceStat {
+    bool found{};
+    uint64_t size{};
+    int64_t modified{ UNKNOWN_MODIFIED };
+
+    bool operator==(const SourceStat& other) const {
+      return found == other.found && size == other.size && modified == other.modified;
+    }
+  };
+
+  //!< The text a compiled file was made from, as recorded in its header
+  struct SourceInfo {
+    uint64_t size{};
+    int64_t modified{ UNKNOWN_MODIFIED };
+    std::string hash;
+  };
+
+  //!< Result of hashing a text file against a compiled header, kept so the text is hashed once per run
+  struct SourceCheck {
+    SourceStat stat;
+    std::string hash;
+    bool fresh{};
+  };
+
+  std::mutex checksMutex;
+  std::unordered_map<std::string, SourceCheck> checks;
+
+  SourceStat StatSource(const std::string& path) {
+    std::error_code error;
+    SourceStat stat;
+    stat.size = std::filesystem::file_size(path, error);
+
+    // e.g. no text file, or an asset packed inside an Android APK
+    if (error) return {};
+
+    stat.found = true;
+
+    // not every platform reports modified times. The hash decides then.
+    std::filesystem::file_time_type time = std::filesystem::last_write_time(path, error);
+
+    if (!error) {
+      stat.modified = static_cast<int64_t>(time.time_since_epoch().count());
+    }
+
+    return stat;
+  }
+
+  //!< Reads the magic, version and source fields. The reader is left at the point name table.
+  bool ReadHeader(AnimationReader& reader, SourceInfo& source) {
+    if (reader.size < sizeof(ANIMATION_MAGIC) || !std::equal(std::begin(ANIMATION_MAGIC), std::end(ANIMATION_MAGIC), reader.data)) {
+      return false;
+    }
+
+    reader.pos = sizeof(ANIMATION_MAGIC);
+
+    if (reader.Varint() != AnimationBinary::VERSION) {
+      return false;
+    }
+
+    source.size = reader.Varint();
+    source.modified = reader.Signed();
+    source.hash = reader.Bytes(SOURCE_HASH_SIZE);
+    return !reader.failed;
+  }
+
+  //!< true if the text file at path is still the text the compiled file was made from, or there is no text file
+  bool IsSourceUnchanged(const std::string& path, const SourceInfo& recorded) {
+    const SourceStat stat = StatSource(path);
+
+    // A different size or an untouched file is decided without reading the text
+    if (stat.found) {
+      if (stat.size != recorded.size) return false;
+      if (stat.modified != UNKNOWN_MODIFIED && stat.modified == recorded.modified) return true;
+    }
+
+    {
+      std::scoped_lock lock(checksMutex);
+      auto iter = checks.find(path);
+
+      if (iter != checks.end() && iter->second.stat == stat && iter->second.hash == recorded.hash) {
+        return iter->second.fresh;
+      }
+    }
+
+    // Same size but another modified time, e.g. after a copy, or no file times at all
+    const std::string text = FileUtil::Read(path);
+    const bool fresh = text.empty() || (text.size() == recorded.size && SourceHash(text) == recorded.hash);
+
+    std::scoped_lock lock(checksMutex);
+    checks[path] = SourceCheck{ stat, recorded.hash, fresh };
+    return fresh;
+  }
+}
+
+std::string AnimationBinary::Encode(const Animation::FrameLists& lists, const std::string& source, int64_t sourceModified)
+{
+  // Point ids are only valid in this process, so names are written to a table
+  std::vector<PointId> names;
+  std::unordered_map<PointId, size_t> nameIndex;
+
+  for (const auto& [state, list] : lists) {
+    for (size_t i = 0; i < list.GetFrameCount(); i++) {
+      for (const auto& [id, point] : list.GetFrame(static_cast<int>(i)).points) {
+        if (nameIndex.emplace(id, names.size()).second) {
+          names.push_back(id);
+        }
+      }
+    }
+  }
+
+  std::string out;
+  out.append(ANIMATION_MAGIC, sizeof(ANIMATION_MAGIC));
+  WriteVarint(out, VERSION);
+  WriteVarint(out, source.size());
+  WriteSigned(out, sourceModified);
+  out += SourceHash(source);
+
+  WriteVarint(out, names.size());
+  for (PointId id : names) {
+    WriteString(out, AnimationPointName(id));
+  }
+
+  WriteVarint(out, lists.size());
+  for (const auto& [state, list] : lists) {
+    WriteString(out, state);
+    WriteVarint(out, list.GetFrameCount());
+
+    for (size_t i = 0; i < list.GetFrameCount(); i++) {
+      const Frame& frame = list.GetFrame(static_cast<int>(i));
+
+      uint8_t flags = (frame.applyOrigin ? applyOrigin : 0) | (frame.flipX ? flipX : 0) | (frame.flipY ? flipY : 0);
+
+      WriteSigned(out, frame.duration.count());
+      out.push_back(static_cast<char>(flags));
+      WriteSigned(out, frame.subregion.left);
+      WriteSigned(out, frame.subregion.top);
+      WriteSigned(out, frame.subregion.width);
+      WriteSigned(out, frame.subregion.height);
+      WriteFloat(out, frame.origin.x);
+      WriteFloat(out, frame.origin.y);
+
+      WriteVarint(out, frame.points.size());
+      for (const auto& [id, point] : frame.points) {
+        WriteVarint(out, nameIndex[id]);
+        WriteFloat(out, point.x);
+        WriteFloat(out, point.y);
+      }
+    }
+  }
+
+  return out;
+}
+
+bool AnimationBinary::Decode(const char* data, size_t size, Animation::FrameLists& out)
+{
+  AnimationReader reader{ data, size };
+  SourceInfo source;
+
+  if (!ReadHeader(reader, source)) {
+    return false;
+  }
+
+  uint64_t nameCount = reader.Varint();
+  std::vector<PointId> names;
+
+  for (uint64_t i = 0; i < nameCount && !reader.failed; i++) {
+    names.push_back(AnimationPointId(reader.String()));
+  }
+
+  uint64_t stateCount = reader.Varint();
+
+  for (uint64_t i = 0; i < stateCount && !reader.failed; i++) {
+    std::string state = reader.String();
+    uint64_t frameCount = reader.Varint();
+    FrameList list;
+
+    for (uint64_t j = 0; j < frameCount && !reader.failed; j++) {
+      frame_time_t duration = frames(reader.Signed());
+      uint8_t flags = reader.Byte();
+
+      sf::IntRect rect;
+      rect.left = static_cast<int>(reader.Signed());
+      rect.top = static_cast<int>(reader.Signed());
+      rect.width = static_cast<int>(reader.Signed());
+      rect.height = static_cast<int>(reader.Signed());
+
+      sf::Vector2f origin;
+      origin.x = reader.Float();
+      origin.y = reader.Float();
+
+      if (flags & applyOrigin) {
+        list.Add(duration, rect, origin, flags & flipX, flags & flipY);
+      }
+      else {
+        list.Add(duration, rect);
+      }
+
+      uint64_t pointCount = reader.Varint();
+
+      for (uint64_t k = 0; k < pointCount && !reader.failed; k++) {
+        uint64_t name = reader.Varint();
+        sf::Vector2f point;
+        point.x = reader.Float();
+        point.y = reader.Float();
+
+        if (name >= names.size()) {
+          reader.failed = true;
+          break;
+        }
+
+        list.SetPoint(names[name], point);
+      }
+    }
+
+    out.insert(std::make_pair(std::move(state), std::move(list)));
+  }
+
+  return !reader.failed;
+}
+
+std::string AnimationBinary::CompiledPath(const std::string& path)
+{
+  return path + ANIMATION_BINARY_EXTENSION;
+}
+
+bool AnimationBinary::Load(const std::string& path, Animation::FrameLists& out)
+{
+  const std::string compiled = CompiledPath(path);
+  MappedFile file;
+
+  if (!file.Open(compiled)) return false;
+
+  // A text file edited after it was compiled wins
+  AnimationReader reader{ file.Data(), file.Size() };
+  SourceInfo recorded;
+
+  if (ReadHeader(reader, recorded) && !IsSourceUnchanged(path, recorded)) {
+    return false;
+  }
+
+  if (!Decode(file.Data(), file.Size(), out)) {
+    Logger::Logf(LogLevel::warning, "%s is not a valid compiled animation. Using the text file.", compiled.c_str());
+    out.clear();
+    return false;
+  }
+
+  return true;
+}
+
+bool AnimationBinary::Compile(const std::string& path)
+{
+  const std::string text = FileUtil::Read(path);
+
+  if (text.empty()) {
+    Logger::Logf(LogLevel::critical, "Could not read animation %s", path.c_str());
+    return false;
+  }
+
+  const std::string out = Encode(Animation::Parse(text, path), text, StatSource(path).modified);
+  const std::string compiled = CompiledPath(path);
+
+  std::ofstream file(compiled, std::ios::binary);
+
+  if (!file.is_open()) {
+    Logger::Logf(LogLevel::critical, "Could not open compiled animation %s for writing", compiled.c_str());
+    return false;
+  }
+
+  file.write(out.data(), out.size());
+  return file.good();
+}
@@ -0,0 +1,67 @@
+/*! \brief Precompiled form of .animation files
+ *
+ * Text animation files are parsed line by line with string searches. The
+ * compiled form stores the same frame lists so loading is a straight read.
+ * A compiled file sits next to its text file with ANIMATION_BINARY_EXTENSION
+ * appended, e.g. `player.animation.bin`, and is used in its place unless the
+ * text file has changed since it was compiled.
+ *
+ * The header records the size, modified time and md5 of the text. A text file
+ * of another size is stale and one with the same size and modified time is
+ * not, without reading it. Only when the size matches but the time does not,
+ * e.g. after a copy or archive extraction, or when the file cannot be checked
+ * at all, such as assets inside an Android APK, is the text read and hashed.
+ * That result is kept for the rest of the run. Packages may ship either form or both.
+ *
+ * File layout (integers are unsigned LEB128 varints, signed ones are zigzag
+ * encoded first, floats are 4 little endian bytes, strings are a varint length then bytes):
+ *   "ONBA" version, source text size, source modified time (signed, 0 if unknown), source text md5 (16 bytes)
+ *   point name table size, each name
+ *   state count, each state (name, frame count, each frame)
+ *   frame: duration in frames, flags (applyOrigin | flipX << 1 | flipY << 2),
+ *          rect left top width height, origin x y, point count, each point (name index, x, y)
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "bnAnimation.h"
+
+#define ANIMATION_BINARY_EXTENSION ".bin"
+
+class AnimationBinary {
+public:
+  static constexpr uint32_t VERSION = 3;
+
+  /**
+   * @brief Serializes parsed frame lists
+   * @param source the text the lists were parsed from, recorded to tell when the compiled form is stale
+   * @param sourceModified modified time of the text file in file clock ticks, 0 if unknown
+   */
+  static std::string Encode(const Animation::FrameLists& lists, const std::string& source, int64_t sourceModified = 0);
+
+  /**
+   * @brief Reads frame lists written by Encode()
+   * @return false if the data is not a compiled animation or is truncated. out is left incomplete.
+   */
+  static bool Decode(const char* data, size_t size, Animation::FrameLists& out);
+
+  /**
+   * @brief Path of the compiled file for a text animation path
+   */
+  static std::string CompiledPath(const std::string& path);
+
+  /**
+   * @brief Maps and decodes the compiled file for a text animation path
+   *
+   * If there is no text file the compiled file is used without checking it.
+   * @return false if there is no usable compiled file or it was compiled from other text and the text should be parsed instead
+   */
+  static bool Load(const std::string& path, Animation::FrameLists& out);
+
+  /**
+   * @brief Parses a text animation file and writes its compiled form next to it
+   */
+  static bool Compile(const std::string& path);
+};
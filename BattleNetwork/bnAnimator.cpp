@@ -1,6 +1,51 @@
 #include "bnAnimator.h"
 
+#include <algorithm>
+#include <deque>
 #include <iostream>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+  struct PointNames {
+    std::mutex mutex;
+    std::unordered_map<std::string, PointId> ids;
+    std::deque<std::string> names; // push_back never moves existing names
+  };
+
+  PointNames& Names() {
+    static PointNames names;
+    return names;
+  }
+}
+
+PointId AnimationPointId(const std::string& name)
+{
+  std::string upper = name;
+  std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+
+  PointNames& names = Names();
+  std::scoped_lock lock(names.mutex);
+
+  auto iter = names.ids.find(upper);
+
+  if (iter != names.ids.end()) {
+    return iter->second;
+  }
+
+  PointId id = static_cast<PointId>(names.names.size());
+  names.names.push_back(upper);
+  names.ids.emplace(std::move(upper), id);
+  return id;
+}
+
+const std::string& AnimationPointName(PointId id)
+{
+  // Names are only ever appended so the reference stays valid after the lock is released
+  PointNames& names = Names();
+  std::scoped_lock lock(names.mutex);
+  return names.names[id];
+}
 
 Animator::Mode::Mode(int playback)
 {
@@ -104,18 +149,20 @@ Animator::~Animator() {
   queuedOnFinish = nullptr;
 }
 
-void Animator::UpdateCurrentPoints(int frameIndex, FrameList& sequence) {
+void Animator::UpdateCurrentPoints(int frameIndex, const FrameList& sequence) {
   if (sequence.frames.size() <= frameIndex) return;
 
   auto& data = sequence.frames[frameIndex];
-  currentPoints = data.points;
+
+  // assign() keeps the capacity so this does not allocate once warmed up
+  currentPoints.assign(data.points.begin(), data.points.end());
 
   for (auto& [key, point] : currentPoints) {
     point = CalculatePointData(point, data);
   }
 }
 
-void Animator::operator() (frame_time_t progress, sf::Sprite& target, FrameList& sequence) {
+void Animator::operator() (frame_time_t progress, sf::Sprite& target, const FrameList& sequence) {
   frame_time_t startProgress = progress;
 
   // If we did not progress while in an update, do not merge the queues and ignore this request 
@@ -177,19 +224,19 @@ void Animator::operator() (frame_time_t progress, sf::Sprite& target, FrameList&
     return;
   }
 
-  // We may modify the frame order, make a copy
-  std::vector<Frame> copy = sequence.frames;
-
-  // If the playback mode is reverse, flip the frames
-  if ((playbackMode & Mode::Reverse) == Mode::Reverse) {
-    reverse(copy.begin(), copy.end());
-  }
+  // Walk the frames by position instead of copying them.
+  // When reversed, position 0 is the last frame of the sequence.
+  const size_t count = sequence.frames.size();
+  bool reversed = (playbackMode & Mode::Reverse) == Mode::Reverse;
+  auto frameAt = [&sequence, count, &reversed](size_t position) -> const Frame& {
+    return sequence.frames[reversed ? count - 1 - position : position];
+  };
 
   // frame index
   int index = 0;
 
-  // Iterator to the frame itself
-  std::vector<Frame>::const_iterator iter = copy.begin();
+  // Position of the frame itself
+  size_t position = 0;
 
   // While there is time left in the progress loop
   while (progress > frames(0)) {
@@ -197,13 +244,13 @@ void Animator::operator() (frame_time_t progress, sf::Sprite& target, FrameList&
     index++;
 
     // Subtract from the progress
-    progress -= (*iter).duration;
+    progress -= frameAt(position).duration;
 
     // Must be <= and not <, to handle case (progress == frame.duration) correctly
     // We assume progress hits zero because we use it as a decrementing counter
     // We add a check to ensure the start progress wasn't also 0
     // If it did not start at zero, we know we came across the end of the animation
-    bool reachedLastFrame = &(*iter) == &copy.back() && startProgress != frames(0);
+    bool reachedLastFrame = position == count - 1 && startProgress != frames(0);
 
     if (progress <= frames(0) || reachedLastFrame) {
       FrameCallbackHash::iterator callbackIter = callbacks.begin();
@@ -266,16 +313,15 @@ void Animator::operator() (frame_time_t progress, sf::Sprite& target, FrameList&
       }
 
       // If the playback mode was set to loop...
-      if ((playbackMode & Mode::Loop) == Mode::Loop && &(*iter) == &copy.back() && startProgress >= sequence.totalDuration) {
+      if ((playbackMode & Mode::Loop) == Mode::Loop && position == count - 1 && startProgress >= sequence.totalDuration) {
         // But it was also set to bounce, reverse the list and start over
         if ((playbackMode & Mode::Bounce) == Mode::Bounce) {
-          reverse(copy.begin(), copy.end());
-          iter = copy.begin();
-          iter++;
+          reversed = !reversed;
+          position = 1;
         }
         else {
           // It was set only to loop, start from the beginning
-          iter = copy.begin();
+          position = 0;
         }
 
         if (callbacksAreValid) {
@@ -293,7 +339,7 @@ void Animator::operator() (frame_time_t progress, sf::Sprite& target, FrameList&
       }
 
       // apply rect, flip, and origin attributes
-      UpdateSpriteAttributes(target, *iter);
+      UpdateSpriteAttributes(target, frameAt(position));
 
       UpdateCurrentPoints(index - 1, sequence);
 
@@ -301,13 +347,13 @@ void Animator::operator() (frame_time_t progress, sf::Sprite& target, FrameList&
     }
 
     // If not finish, go to next frame
-    iter++;
+    position++;
   }
 
   // If we prematurely ended the loop, update the sprite
-  if (iter != copy.end()) {
+  if (position < count) {
     // apply rect, flip, and origin attributes
-    UpdateSpriteAttributes(target, *iter);
+    UpdateSpriteAttributes(target, frameAt(position));
   }
 
   // End updating flag
@@ -392,15 +438,24 @@ char Animator::GetMode()
 }
 
 const sf::Vector2f Animator::GetPoint(const std::string& pointName) {
-  auto str = pointName;
-  std::transform(str.begin(), str.end(), str.begin(), ::toupper);
-  if (currentPoints.find(str) == currentPoints.end()) {
+  PointId id = AnimationPointId(pointName);
+
+  for (const auto& [key, point] : currentPoints) {
+    if (key == id) return point;
+  }
+
 #ifdef BN_LOG_MISSING_POINT
-    Logger::Log("Could not find point in current sequence named " + str);
+  Logger::Log("Could not find point in current sequence named " + pointName);
 #endif
-    return sf::Vector2f();
+  return sf::Vector2f();
+}
+
+const sf::Vector2f Animator::GetPoint(PointId id) const {
+  for (const auto& [key, point] : currentPoints) {
+    if (key == id) return point;
   }
-  return currentPoints[str];
+
+  return sf::Vector2f();
 }
 
 void Animator::Clear() {
@@ -417,10 +472,10 @@ void Animator::Clear() {
   }
 }
 
-void Animator::SetFrame(int frameIndex, sf::Sprite& target, FrameList& sequence)
+void Animator::SetFrame(int frameIndex, sf::Sprite& target, const FrameList& sequence)
 {
   int index = 0;
-  for (Frame& frame : sequence.frames) {
+  for (const Frame& frame : sequence.frames) {
     index++;
 
     if (index == frameIndex) {
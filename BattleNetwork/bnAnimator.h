@@ -2,7 +2,9 @@
 
 #include <SFML/Graphics.hpp>
 #include <map>
+#include <cstdint>
 #include <functional>
+#include <vector>
 #include <assert.h>
 #include <iostream>
 #include <list>
@@ -13,7 +15,19 @@
 using FrameCallback = std::function<void()>;
 using FrameFinishCallback = std::function<void()>;
 using FrameCallbackHash = std::multimap<int, FrameCallback>;
-using PointHash = std::map<std::string, sf::Vector2f>;
+using PointId = uint32_t;
+using PointList = std::vector<std::pair<PointId, sf::Vector2f>>; //!< A frame has a handful of points. Searched in order.
+
+/**
+ * @brief Interns a point name so frames can look points up by id
+ * @param name case insensitive
+ */
+PointId AnimationPointId(const std::string& name);
+
+/**
+ * @brief Upper case name of an interned point
+ */
+const std::string& AnimationPointName(PointId id);
 
 /**
  * @struct OverrideFrame
@@ -35,7 +49,7 @@ struct Frame {
   bool applyOrigin{}, flipX{}, flipY{};
   sf::Vector2f origin;
 
-  PointHash points;
+  PointList points;
 
   Frame(frame_time_t duration, sf::IntRect subregion, bool applyOrigin, sf::Vector2f origin, bool flipX, bool flipY) :
     duration(duration),
@@ -45,7 +59,22 @@ struct Frame {
     flipX(flipX),
     flipY(flipY)
   {
-    points["ORIGIN"] = origin;
+    static const PointId originId = AnimationPointId("ORIGIN");
+    SetPoint(originId, origin);
+  }
+
+  /**
+   * @brief Adds a point or overwrites the point with the same id
+   */
+  void SetPoint(PointId id, sf::Vector2f point) {
+    for (auto& [key, value] : points) {
+      if (key == id) {
+        value = point;
+        return;
+      }
+    }
+
+    points.emplace_back(id, point);
   }
 
   Frame(const Frame& rhs) {
@@ -110,7 +139,7 @@ public:
     totalDuration = rhs.totalDuration;
   }
 
-  FrameList MakeNewFromOverrideData(const std::list<OverrideFrame>& data) {
+  FrameList MakeNewFromOverrideData(const std::list<OverrideFrame>& data) const {
     FrameList res;
     if (frames.empty()) return res;
 
@@ -164,23 +193,29 @@ public:
   * Will overwrite any other point with the same name in the frame - unique names only
   */
   inline void SetPoint(const std::string& name, int x, int y) {
-    auto str = name;
-    std::transform(str.begin(), str.end(), str.begin(), ::toupper);
-    frames[frames.size() - 1].points[name] = sf::Vector2f(float(x), float(y));
+    SetPoint(AnimationPointId(name), x, y);
+  }
+
+  inline void SetPoint(PointId id, int x, int y) {
+    SetPoint(id, sf::Vector2f(float(x), float(y)));
+  }
+
+  inline void SetPoint(PointId id, sf::Vector2f point) {
+    frames[frames.size() - 1].SetPoint(id, point);
   }
 
   /**
  * @brief Get the total number of frames in this list
  * @return const unsigned int
  */
-  inline const size_t GetFrameCount() { return frames.size(); }
+  inline const size_t GetFrameCount() const { return frames.size(); }
 
   /**
   * @brief Get the frame data at the given index
   * @param index of the frame in the list (base 0)
   * @return const Frame immutable
   */
-  inline const Frame& GetFrame(const int index) { return frames[index]; }
+  inline const Frame& GetFrame(const int index) const { return frames[index]; }
 
   /**
    * @brief Get the total duration for the list of frames
@@ -214,7 +249,7 @@ private:
   FrameCallbackHash queuedCallbacks; /*!< used for adding new callbacks while updating */
   FrameCallbackHash queuedOnetimeCallbacks; /*!< adding new one-time callbacks in update */
   
-  PointHash currentPoints;
+  PointList currentPoints;
   
   FrameFinishCallback onFinish; /*!< special callback that fires when the animation is completed */
   FrameFinishCallback queuedOnFinish; /*!< Queues onFinish callback when used in the middle of update */
@@ -288,6 +323,7 @@ public:
   char GetMode();
   
   const sf::Vector2f GetPoint(const std::string& pointName);
+  const sf::Vector2f GetPoint(PointId point) const;
   
   /**
    * @brief Clears all callback functors
@@ -300,7 +336,7 @@ public:
    * @param target sprite to apply frames to
    * @param sequence list of frames
    */
-  void operator() (frame_time_t progress, sf::Sprite& target, FrameList& sequence);
+  void operator() (frame_time_t progress, sf::Sprite& target, const FrameList& sequence);
   
   /**
    * @brief Applies a callback
@@ -328,7 +364,7 @@ public:
    * @param target sprite to apply frame to
    * @param sequence frame is pulled from list using index
    */
-  void SetFrame(int frameIndex, sf::Sprite& target, FrameList& sequence);
+  void SetFrame(int frameIndex, sf::Sprite& target, const FrameList& sequence);
 
   /**
  * @brief Updates the internal points hash from the frame list for a given frame
@@ -338,5 +374,5 @@ public:
  * Once this function is complete, the currentpoints stored inside the animator
  * is refreshed with latest data
  */
-  void UpdateCurrentPoints(int frameIndex, FrameList& sequence);
+  void UpdateCurrentPoints(int frameIndex, const FrameList& sequence);
 };
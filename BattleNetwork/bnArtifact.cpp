@@ -1,6 +1,10 @@
 #include "bnArtifact.h"
 
 Artifact::Artifact() : Entity() {
+  Reset();
+}
+
+void Artifact::Reset() {
   SetTeam(Team::unknown);
   SetPassthrough(true);
 }
\ No newline at end of file
@@ -8,6 +8,11 @@ class Artifact : public Entity {
 public:
   Artifact();
 
+  /**
+   * @brief Restores the constructed artifact state when recycled from an EntityPool
+   */
+  void Reset();
+
   virtual void OnUpdate(double _elapsed) = 0;
   virtual void OnDelete() = 0;
 };
@@ -0,0 +1,152 @@
+#include "bnAssetPreloader.h"
+#include "bnTextureResourceManager.h"
+#include "bnLogger.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <set>
+
+namespace {
+  enum class AssetKind { texture, animation, other };
+
+  AssetKind KindOf(const std::filesystem::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    if (ext == ".png") return AssetKind::texture;
+    if (ext == ".animation") return AssetKind::animation;
+    return AssetKind::other;
+  }
+
+  // Paths are built the way scripts build them from _modpath so they match the cache keys
+  std::vector<std::string> Discover(const std::string& directory) {
+    std::vector<std::string> found;
+    std::error_code error;
+    std::filesystem::recursive_directory_iterator iter(directory, error);
+
+    if (error) return found;
+
+    for (const auto end = std::filesystem::recursive_directory_iterator(); iter != end; iter.increment(error)) {
+      if (error) break;
+      if (!iter->is_regular_file(error) || KindOf(iter->path()) == AssetKind::other) continue;
+
+      if (found.size() == BN_PRELOAD_MAX_DISCOVERED_ASSETS) {
+        Logger::Logf(LogLevel::debug, "Package %s has more than %d assets. Declare the ones used in battle to preload them all.",
+          directory.c_str(), BN_PRELOAD_MAX_DISCOVERED_ASSETS);
+        break;
+      }
+
+      std::filesystem::path relative = iter->path().lexically_relative(directory);
+      found.push_back(directory + "/" + relative.generic_string());
+    }
+
+    return found;
+  }
+
+  double Rate(size_t hits, size_t misses) {
+    size_t total = hits + misses;
+    return total == 0 ? 100.0 : 100.0 * static_cast<double>(hits) / static_cast<double>(total);
+  }
+
+  void LogMisses(const char* kind, const std::vector<std::string>& misses) {
+    size_t count = std::min(misses.size(), static_cast<size_t>(BN_PRELOAD_MAX_LOGGED_MISSES));
+
+    for (size_t i = 0; i < count; i++) {
+      Logger::Logf(LogLevel::debug, "  %s missed: %s", kind, misses[i].c_str());
+    }
+
+    if (misses.size() > count) {
+      Logger::Logf(LogLevel::debug, "  and %zu more %s", misses.size() - count, kind);
+    }
+  }
+}
+
+AssetPreloader::AssetPreloader(const std::vector<PackageAssets>& packages)
+{
+  std::set<std::string> seen;
+
+  for (const PackageAssets& package : packages) {
+    const std::vector<std::string> paths = package.declared.empty() && !package.directory.empty() ? Discover(package.directory) : package.declared;
+
+    for (const std::string& path : paths) {
+      if (!seen.insert(path).second) continue;
+
+      switch (KindOf(path)) {
+      case AssetKind::texture:
+        textures.push_back(Textures().LoadFromFileAsync(path));
+        break;
+      case AssetKind::animation:
+        animationPaths.push_back(path);
+        break;
+      default:
+        Logger::Logf(LogLevel::warning, "Declared asset %s is not a texture or animation and will not be preloaded", path.c_str());
+      }
+    }
+  }
+
+  Logger::Logf(LogLevel::debug, "Preloading %zu textures and %zu animations from %zu packages", textures.size(), animationPaths.size(), packages.size());
+
+  if (animationPaths.empty()) return;
+
+  animationThread = std::thread([this] {
+    for (const std::string& path : animationPaths) {
+      // preloads are left out of the hit rate so it only reflects requests made by the battle
+      animations.push_back(Animation::LoadShared(path, false));
+    }
+  });
+}
+
+AssetPreloader::~AssetPreloader()
+{
+  StopTracking();
+
+  if (animationThread.joinable()) {
+    animationThread.join();
+  }
+}
+
+void AssetPreloader::BeginTracking()
+{
+  textureStart = Textures().GetCacheStats();
+  animationStart = Animation::GetCacheStats();
+
+  // drop misses left over from before the battle
+  Textures().TakeCacheMisses();
+  Animation::TakeCacheMisses();
+  Textures().RecordCacheMisses(true);
+  Animation::RecordCacheMisses(true);
+  tracking = true;
+}
+
+void AssetPreloader::LogHitRate()
+{
+  if (!tracking) return;
+
+  ResourceCacheStats textureEnd = Textures().GetCacheStats();
+  Animation::CacheStats animationEnd = Animation::GetCacheStats();
+  std::vector<std::string> textureMisses = Textures().TakeCacheMisses();
+  std::vector<std::string> animationMisses = Animation::TakeCacheMisses();
+  StopTracking();
+
+  size_t textureHits = textureEnd.hits - textureStart.hits;
+  size_t textureMissCount = textureEnd.misses - textureStart.misses;
+  size_t animationHits = animationEnd.hits - animationStart.hits;
+  size_t animationMissCount = animationEnd.misses - animationStart.misses;
+
+  Logger::Logf(LogLevel::info, "Battle warm cache hit rate: textures %.1f%% (%zu/%zu), animations %.1f%% (%zu/%zu)",
+    Rate(textureHits, textureMissCount), textureHits, textureHits + textureMissCount,
+    Rate(animationHits, animationMissCount), animationHits, animationHits + animationMissCount);
+
+  LogMisses("textures", textureMisses);
+  LogMisses("animations", animationMisses);
+}
+
+void AssetPreloader::StopTracking()
+{
+  if (!tracking) return;
+
+  Textures().RecordCacheMisses(false);
+  Animation::RecordCacheMisses(false);
+  tracking = false;
+}
@@ -0,0 +1,77 @@
+/*! \brief Loads the textures and animations of battle packages ahead of time
+ *
+ * Spells and viruses load their files the first time they appear, which stalls
+ * that frame. The preloader requests the files of every package in a battle
+ * while the battle is still being set up so they are cached by then.
+ *
+ * Textures are decoded by TextureResourceManager::LoadFromFileAsync() and
+ * animations are parsed on a thread of their own. Both are held until the
+ * preloader is destroyed so the caches keep them for the whole battle.
+ *
+ * Between BeginTracking() and LogHitRate() the texture and animation caches
+ * remember which paths they missed, showing what the preload did not cover.
+ */
+
+#pragma once
+#include "bnResourceHandle.h"
+#include "bnAnimation.h"
+#include "bnResourceCache.h"
+
+#include <SFML/Graphics/Texture.hpp>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BN_PRELOAD_MAX_DISCOVERED_ASSETS 64 //!< Files taken from a package folder that declares none
+#define BN_PRELOAD_MAX_LOGGED_MISSES 16 //!< Missed paths listed by LogHitRate()
+
+/*! \brief Files to preload for one package */
+struct PackageAssets {
+  std::string directory; //!< Searched for files when nothing is declared
+  std::vector<std::string> declared;
+
+  template<typename MetaClass>
+  static PackageAssets Of(const MetaClass& meta) {
+    return { meta.GetFilePath(), meta.GetDeclaredAssets() };
+  }
+};
+
+class AssetPreloader : public ResourceHandle {
+public:
+  AssetPreloader() = default;
+
+  /**
+   * @brief Starts loading the files of each package. Files shared by packages are loaded once.
+   */
+  explicit AssetPreloader(const std::vector<PackageAssets>& packages);
+
+  /**
+   * @brief Waits for the animation thread then releases everything loaded
+   */
+  ~AssetPreloader();
+
+  AssetPreloader(const AssetPreloader&) = delete;
+  AssetPreloader& operator=(const AssetPreloader&) = delete;
+
+  /**
+   * @brief Starts counting cache hits and recording missed paths
+   */
+  void BeginTracking();
+
+  /**
+   * @brief Logs the share of texture and animation requests served from the cache since BeginTracking() and the paths that were not
+   */
+  void LogHitRate();
+
+private:
+  bool tracking{ false };
+  ResourceCacheStats textureStart;
+  Animation::CacheStats animationStart;
+  std::vector<std::shared_ptr<sf::Texture>> textures;
+  std::vector<std::string> animationPaths;
+  std::vector<std::shared_ptr<const Animation::FrameLists>> animations; //!< Written only by the animation thread
+  std::thread animationThread;
+
+  void StopTracking();
+};
@@ -1,7 +1,20 @@
 #include "bnAudioResourceManager.h"
 #include "bnLogger.h"
 
-AudioResourceManager::AudioResourceManager(){
+#include <algorithm>
+#include <filesystem>
+
+namespace {
+  std::chrono::steady_clock::duration ToDuration(sf::Time time) {
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::microseconds(time.asMicroseconds()));
+  }
+
+  const auto DUPLICATE_WINDOW = std::chrono::milliseconds(AUDIO_DUPLICATES_ALLOWED_IN_X_MILLISECONDS);
+}
+
+AudioResourceManager::AudioResourceManager() :
+  cached(static_cast<size_t>(BN_AUDIO_CACHE_BUDGET_MB) * 1024u * 1024u)
+{
   midiMusic.loadSoundFontFromFile("resources/midi/soundfont.sf2");
 
   isEnabled = true;
@@ -12,6 +25,11 @@ AudioResourceManager::AudioResourceManager(){
     channels[i].buffer = sf::Sound();
   }
 
+  // taken from the back, so the first channel is used first
+  for (int i = NUM_OF_CHANNELS - 1; i >= 0; i--) {
+    freeChannels.push_back(i);
+  }
+
   sources = new sf::SoundBuffer[static_cast<size_t>(AudioType::AUDIO_TYPE_SIZE)];
 
   for (int i = 0; i < static_cast<size_t>(AudioType::AUDIO_TYPE_SIZE); i++) {
@@ -30,35 +48,33 @@ AudioResourceManager::~AudioResourceManager() {
     channels[i].buffer.stop();
   }
 
+  for (StreamVoice& voice : streamVoices) {
+    voice.music.stop();
+  }
+
   // Free memory
   delete[] channels;
   delete[] sources;
 }
 
 void AudioResourceManager::EnableAudio(bool status) {
+  std::scoped_lock lock(mutex);
   isEnabled = status;
 }
 
 void AudioResourceManager::Mute(bool status)
 {
+  std::scoped_lock lock(mutex);
   muted = status;
 
-  if (!muted) {
-    SetStreamVolume(streamVolume);
-    SetChannelVolume(channelVolume);
-  }
-  else {
-    float streamBefore = streamVolume;
-    float channelBefore = channelVolume;
-    SetStreamVolume(0);
-    SetChannelVolume(0);
-    streamVolume = streamBefore;
-    channelVolume = channelBefore;
-  }
+  // the volumes are kept so unmuting restores them
+  ApplyStreamVolume(muted ? 0.f : streamVolume);
+  ApplyChannelVolume(muted ? 0.f : channelVolume);
 }
 
 void AudioResourceManager::SetPitch(float pitch)
 {
+  std::scoped_lock lock(mutex);
   stream.setPitch(pitch);
 }
 
@@ -119,6 +135,8 @@ void AudioResourceManager::LoadAllSources(std::atomic<int> &status) {
 }
 
 void AudioResourceManager::LoadSource(AudioType type, const std::string& path) {
+  std::scoped_lock lock(mutex);
+
   if (!sources[static_cast<size_t>(type)].loadFromFile(path)) {
     Logger::Logf(LogLevel::critical, "Failed loading Audio(): %s\n", path.c_str());
 
@@ -129,224 +147,263 @@ void AudioResourceManager::LoadSource(AudioType type, const std::string& path) {
 
 std::shared_ptr<sf::SoundBuffer> AudioResourceManager::LoadFromFile(const std::string& path)
 {
-  auto iter = cached.find(path);
-  std::shared_ptr<sf::SoundBuffer> loaded;
-
-  if (iter == cached.end()) {
-    loaded = std::make_shared<sf::SoundBuffer>();
-    loaded->loadFromFile(path);
-    cached.insert(std::make_pair(path, CachedResource<sf::SoundBuffer>(loaded)));
+  if (std::shared_ptr<sf::SoundBuffer> loaded = cached.Find(path)) {
+    return loaded;
   }
-  else {
-    loaded = iter->second.GetResource();
+
+  // Large sounds, e.g. jingles or voice lines, would take megabytes once decoded
+  std::error_code error;
+  uintmax_t fileBytes = std::filesystem::file_size(path, error);
+
+  if (!error && fileBytes >= BN_AUDIO_STREAM_MIN_FILE_BYTES) {
+    auto file = std::make_shared<MappedFile>();
+
+    if (file->Open(path)) {
+      auto handle = std::make_shared<sf::SoundBuffer>();
+
+      {
+        std::scoped_lock lock(mutex);
+        streamed[handle.get()] = StreamedSample{ handle, file };
+      }
+
+      cached.Insert(path, handle, file->Size());
+
+      Logger::Logf(LogLevel::debug, "Streaming %s as it plays", path.c_str());
+      return handle;
+    }
   }
 
+  auto loaded = std::make_shared<sf::SoundBuffer>();
+  loaded->loadFromFile(path);
+  cached.Insert(path, loaded, SoundBufferBytes(*loaded));
+
   return loaded;
 }
 
+void AudioResourceManager::HandleExpiredAudioCache()
+{
+  cached.EvictExpired(BN_AUDIO_CACHE_EXPIRE_SECONDS);
+
+  // called from the event thread while the logic thread plays sounds
+  std::scoped_lock lock(mutex);
+
+  for (auto iter = streamed.begin(); iter != streamed.end();) {
+    iter = iter->second.handle.expired() ? streamed.erase(iter) : std::next(iter);
+  }
+}
+
+void AudioResourceManager::SetCacheBudget(size_t bytes)
+{
+  cached.SetBudget(bytes);
+}
+
+ResourceCacheStats AudioResourceManager::GetCacheStats() const
+{
+  return cached.GetStats();
+}
+
+size_t AudioResourceManager::SoundBufferBytes(const sf::SoundBuffer& buffer)
+{
+  return static_cast<size_t>(buffer.getSampleCount()) * sizeof(sf::Int16);
+}
+
 int AudioResourceManager::Play(AudioType type, AudioPriority priority) {
+  std::scoped_lock lock(mutex);
+
   if (!isEnabled) { return -1; }
 
   if (type < AudioType(0) || type >= AudioType::AUDIO_TYPE_SIZE) {
     return -1;
   }
 
-  // Annoying sound check. Make sure duplicate sounds are played only by a given amount of offset from the last time it was played.
-  // This prevents amplitude stacking when duplicate sounds are played on the same frame...
-  // NOTE: an Audio() queue would be a better place for this check. Then play() those sounds that pass the queue filter.
-  if (priority < AudioPriority::high) {
-    for (int i = 0; i < NUM_OF_CHANNELS; i++) {
-      if (channels[i].buffer.getBuffer() == &sources[static_cast<size_t>(type)] && channels[i].buffer.getStatus() == sf::SoundSource::Status::Playing) {
-        sf::Int32 howLongPlayed = channels[i].buffer.getPlayingOffset().asMilliseconds();
-        if (howLongPlayed <= AUDIO_DUPLICATES_ALLOWED_IN_X_MILLISECONDS) {
-          return -1;
-        }
-      }
+  return PlaySample(sources[static_cast<size_t>(type)], nullptr, priority);
+}
+
+int AudioResourceManager::Play(std::shared_ptr<sf::SoundBuffer> resource, AudioPriority priority)
+{
+  std::scoped_lock lock(mutex);
+
+  if (!isEnabled || !resource) { return -1; }
+
+  if (auto iter = streamed.find(resource.get()); iter != streamed.end()) {
+    if (iter->second.handle.lock() == resource) {
+      return PlayStreamed(resource.get(), iter->second.file, priority);
     }
+
+    streamed.erase(iter);
   }
 
-  // Priorities are LOWEST  (one at a time, if channel available),
-  //                LOW     (any free channels),
-  //                HIGH    (force a channel to play sound, but one at a time, and don't interrupt other high priorities),
-  //                HIGHEST (force a channel to play sound always)
-
-  // Highest priority plays over anything that isn't like it
-  // If it can, it will play in the first free channel but it will overwrite a sound if it cannot find one
-  if (priority == AudioPriority::highest) {
-    int lastFreeChannel = -1;
-    int lastDifferentChannel = -1;
-
-    auto changeSampleThunk = [this, priority, type](int index) {
-      channels[index].buffer.stop();
-      channels[index].buffer.setBuffer(sources[static_cast<size_t>(type)]);
-      channels[index].buffer.play();
-      channels[index].priority = priority;
-    };
-
-    for (int i = 0; i < NUM_OF_CHANNELS; i++) {
-      if (channels[i].buffer.getStatus() != sf::SoundSource::Status::Playing && lastFreeChannel == -1) {
-        lastFreeChannel = i;
-      }
+  const sf::SoundBuffer& sample = *resource;
+  return PlaySample(sample, std::move(resource), priority);
+}
 
-      if (channels[i].buffer.getBuffer() != &sources[static_cast<size_t>(type)] && lastDifferentChannel == -1) {
-        lastDifferentChannel = i;
-      }
-    }
+// Priorities are LOWEST  (one at a time, if channel available),
+//                LOW     (any free channels),
+//                HIGH    (force a channel to play sound, but one at a time, and don't interrupt other high priorities),
+//                HIGHEST (force a channel to play sound always)
+int AudioResourceManager::PlaySample(const sf::SoundBuffer& sample, std::shared_ptr<sf::SoundBuffer> resource, AudioPriority priority)
+{
+  const Clock::time_point now = Clock::now();
+  ReclaimChannels(now);
+
+  auto voices = sampleVoices.find(&sample);
 
-    if (lastFreeChannel != -1) {
-      changeSampleThunk(lastFreeChannel);
-      return 0;
-    } else if (lastDifferentChannel != -1) {
-      changeSampleThunk(lastDifferentChannel);
-      return 0;
+  if (voices != sampleVoices.end()) {
+    // Annoying sound check. Make sure duplicate sounds are played only by a given amount of offset from the last time it was played.
+    // This prevents amplitude stacking when duplicate sounds are played on the same frame...
+    if (priority < AudioPriority::high && now - voices->second.lastStart <= DUPLICATE_WINDOW) {
+      return -1;
     }
-    else {
-      // all channels are currently playing the same sound. That must be annoying to hear.
+
+    // Lowest priority or high priority sounds only play once
+    if (priority == AudioPriority::lowest || priority == AudioPriority::high) {
       return -1;
     }
   }
 
-  // For lowest priority or high priority sounds, scan and see if this sound is already playing...
-  // This step is also used as a pre-check for low priority sounds
-  if (priority == AudioPriority::lowest || priority == AudioPriority::high) {
-    for (int i = 0; i < NUM_OF_CHANNELS; i++) {
-      if (channels[i].buffer.getStatus() == sf::SoundSource::Status::Playing) {
-        if ((sf::SoundBuffer*)channels[i].buffer.getBuffer() == &sources[static_cast<size_t>(type)]) {
-          // Lowest priority or high priority sounds only play once 
-          return -1;
-        }
-      }
-    }
+  int index = -1;
+
+  if (!freeChannels.empty()) {
+    index = freeChannels.back();
+    freeChannels.pop_back();
   }
+  else {
+    // High priority sounds may interrupt others. Lower priorities skip playing.
+    index = StealChannel(priority, &sample);
 
-  // Play sound based on priortiy rules
-  for (int i = 0; i < NUM_OF_CHANNELS; i++) {
-    if (priority != AudioPriority::high) {
-      if (channels[i].buffer.getStatus() != sf::SoundSource::Status::Playing) {
-        channels[i].buffer.setBuffer(sources[static_cast<size_t>(type)]);
-        channels[i].buffer.play();
-        channels[i].priority = priority;
-        return 0;
-      }
-    }
-    else { // HIGH PRIORITY will not overwrite other HIGH priorities unless they have ended
-      bool canOverwrite = channels[i].priority < AudioPriority::high 
-        ||(channels[i].priority == AudioPriority::high && channels[i].buffer.getStatus() != sf::SoundSource::Status::Playing);
-      if (canOverwrite) {
-        channels[i].buffer.stop();
-        channels[i].buffer.setBuffer(sources[static_cast<size_t>(type)]);
-        channels[i].buffer.play();
-        channels[i].priority = priority;
-        return 0;
-      }
-    }
+    if (index == -1) return -1;
+
+    ReleaseChannel(index);
   }
 
-  // No free channel? Skip playing this sound.
-  return -1;
+  Channel& channel = channels[index];
+  channel.buffer.stop();
+  channel.buffer.setBuffer(sample);
+  channel.resource = std::move(resource);
+  channel.buffer.play();
+  channel.priority = priority;
+  channel.sample = &sample;
+  channel.endsAt = now + ToDuration(sample.getDuration());
+  channel.generation++;
+  channelEnds.emplace(channel.endsAt, index, channel.generation);
+
+  SampleVoices& sampleVoice = sampleVoices[&sample];
+  sampleVoice.playing++;
+  sampleVoice.lastStart = now;
+
+  return 0;
 }
 
-int AudioResourceManager::Play(std::shared_ptr<sf::SoundBuffer> resource, AudioPriority priority)
+int AudioResourceManager::PlayStreamed(const sf::SoundBuffer* sample, const std::shared_ptr<MappedFile>& file, AudioPriority priority)
 {
-  if (!isEnabled) { return -1; }
-
-  // Annoying sound check. Make sure duplicate sounds are played only by a given amount of offset from the last time it was played.
-  // This prevents amplitude stacking when duplicate sounds are played on the same frame...
-  // NOTE: an audio queue would be a better place for this check. Then play() those sounds that pass the queue filter.
-  if (priority < AudioPriority::high) {
-    for (int i = 0; i < NUM_OF_CHANNELS; i++) {
-      if (channels[i].buffer.getBuffer() == resource.get() && channels[i].buffer.getStatus() == sf::SoundSource::Status::Playing) {
-        sf::Int32 howLongPlayed = channels[i].buffer.getPlayingOffset().asMilliseconds();
-        if (howLongPlayed <= AUDIO_DUPLICATES_ALLOWED_IN_X_MILLISECONDS) {
-          return -1;
-        }
-      }
-    }
-  }
+  const Clock::time_point now = Clock::now();
+  StreamVoice* freeVoice = nullptr;
+  StreamVoice* stealVoice = nullptr;
 
-  // Priorities are LOWEST  (one at a time, if channel available),
-  //                LOW     (any free channels),
-  //                HIGH    (force a channel to play sound, but one at a time, and don't interrupt other high priorities),
-  //                HIGHEST (force a channel to play sound always)
-
-  // Highest priority plays over anything that isn't like it
-  // If it can, it will play in the first free channel but it will overwrite a sound if it cannot find one
-  if (priority == AudioPriority::highest) {
-    int lastFreeChannel = -1;
-    int lastDifferentChannel = -1;
-
-    auto changeSampleThunk = [this, priority, resource](int index) {
-      channels[index].buffer.stop();
-      channels[index].buffer.setBuffer(*resource.get());
-      channels[index].buffer.play();
-      channels[index].priority = priority;
-    };
-
-    for (int i = 0; i < NUM_OF_CHANNELS; i++) {
-      if (channels[i].buffer.getStatus() != sf::SoundSource::Status::Playing && lastFreeChannel == -1) {
-        lastFreeChannel = i;
-      }
+  // There are only a couple of stream voices so the same rules are checked by scanning them
+  for (StreamVoice& voice : streamVoices) {
+    bool playing = voice.music.getStatus() == sf::SoundSource::Status::Playing;
 
-      if (channels[i].buffer.getBuffer() != resource.get() && lastDifferentChannel == -1) {
-        lastDifferentChannel = i;
-      }
+    if (!playing) {
+      if (!freeVoice) freeVoice = &voice;
+      continue;
     }
 
-    if (lastFreeChannel != -1) {
-      changeSampleThunk(lastFreeChannel);
-      return 0;
-    }
-    else if (lastDifferentChannel != -1) {
-      changeSampleThunk(lastDifferentChannel);
-      return 0;
+    if (voice.sample == sample) {
+      if (priority < AudioPriority::high && now - voice.startedAt <= DUPLICATE_WINDOW) return -1;
+      if (priority == AudioPriority::lowest || priority == AudioPriority::high) return -1;
     }
-    else {
-      // all channels are currently playing the same sound. That must be annoying to hear.
-      return -1;
+
+    bool canSteal = priority == AudioPriority::highest ? voice.sample != sample
+      : priority == AudioPriority::high && voice.priority < AudioPriority::high;
+
+    if (canSteal && !stealVoice) {
+      stealVoice = &voice;
     }
   }
 
-  // For lowest priority or high priority sounds, scan and see if this sound is already playing...
-  // This step is also used as a pre-check for low priority sounds
-  if (priority == AudioPriority::lowest || priority == AudioPriority::high) {
-    for (int i = 0; i < NUM_OF_CHANNELS; i++) {
-      if (channels[i].buffer.getStatus() == sf::SoundSource::Status::Playing) {
-        if ((sf::SoundBuffer*)channels[i].buffer.getBuffer() == resource.get()) {
-          // Lowest priority or high priority sounds only play once 
-          return -1;
-        }
-      }
+  StreamVoice* voice = freeVoice ? freeVoice : stealVoice;
+
+  if (!voice) return -1;
+
+  voice->music.stop();
+
+  if (!voice->music.openFromMemory(file->Data(), file->Size())) {
+    Logger::Log(LogLevel::warning, "Failed to decode streamed sound");
+    voice->sample = nullptr;
+    voice->file.reset();
+    return -1;
+  }
+
+  voice->file = file;
+  voice->sample = sample;
+  voice->priority = priority;
+  voice->startedAt = now;
+  voice->music.play();
+
+  return 0;
+}
+
+void AudioResourceManager::ReclaimChannels(Clock::time_point now)
+{
+  while (!channelEnds.empty() && std::get<0>(channelEnds.top()) <= now) {
+    auto [endsAt, index, generation] = channelEnds.top();
+    channelEnds.pop();
+
+    Channel& channel = channels[index];
+
+    // the channel was given another sample since this entry was queued
+    if (channel.generation != generation || !channel.sample) continue;
+
+    // The device may start a sound a little after play() is called. Check again when it should be done.
+    if (channel.buffer.getStatus() == sf::SoundSource::Status::Playing) {
+      sf::Time left = channel.sample->getDuration() - channel.buffer.getPlayingOffset();
+      channel.endsAt = now + std::max(ToDuration(left), Clock::duration(std::chrono::milliseconds(1)));
+      channelEnds.emplace(channel.endsAt, index, generation);
+      continue;
     }
+
+    ReleaseChannel(index);
+    freeChannels.push_back(index);
+  }
+}
+
+void AudioResourceManager::ReleaseChannel(int index)
+{
+  Channel& channel = channels[index];
+
+  if (auto iter = sampleVoices.find(channel.sample); iter != sampleVoices.end() && --iter->second.playing == 0) {
+    sampleVoices.erase(iter);
   }
 
-  // Play sound based on priortiy rules
+  channel.sample = nullptr;
+  channel.resource.reset();
+}
+
+int AudioResourceManager::StealChannel(AudioPriority priority, const sf::SoundBuffer* sample) const
+{
+  if (priority < AudioPriority::high) return -1;
+
+  int found = -1;
+
   for (int i = 0; i < NUM_OF_CHANNELS; i++) {
-    if (priority != AudioPriority::high) {
-      if (channels[i].buffer.getStatus() != sf::SoundSource::Status::Playing) {
-        channels[i].buffer.setBuffer(*resource);
-        channels[i].buffer.play();
-        channels[i].priority = priority;
-        return 0;
-      }
-    }
-    else { // HIGH PRIORITY will not overwrite other HIGH priorities unless they have ended
-      bool canOverwrite = channels[i].priority < AudioPriority::high
-        || (channels[i].priority == AudioPriority::high && channels[i].buffer.getStatus() != sf::SoundSource::Status::Playing);
-      if (canOverwrite) {
-        channels[i].buffer.stop();
-        channels[i].buffer.setBuffer(*resource);
-        channels[i].buffer.play();
-        channels[i].priority = priority;
-        return 0;
-      }
+    const Channel& channel = channels[i];
+
+    // Highest priority plays over anything that isn't like it.
+    // High priority will not overwrite other high priorities unless they have ended.
+    bool canSteal = priority == AudioPriority::highest ? channel.sample != sample : channel.priority < AudioPriority::high;
+
+    if (canSteal && (found == -1 || channel.endsAt < channels[found].endsAt)) {
+      found = i;
     }
   }
 
-  // No free channel? Skip playing this sound.
-  return -1;
+  return found;
 }
 
 int AudioResourceManager::Stream(std::string path, bool loop, long long startMs, long long endMs) {
+  std::scoped_lock lock(mutex);
+
   if (!isEnabled) { return -1; }
 
   if (path == currStreamPath) { return -1; };
@@ -383,26 +440,41 @@ int AudioResourceManager::Stream(std::string path, bool loop) {
 }
 
 void AudioResourceManager::StopStream() {
+  std::scoped_lock lock(mutex);
   stream.stop();
   midiMusic.stop();
 }
 
 void AudioResourceManager::SetStreamVolume(float volume) {
+  std::scoped_lock lock(mutex);
+  ApplyStreamVolume(volume);
+  streamVolume = volume;
+}
+
+void AudioResourceManager::SetChannelVolume(float volume) {
+  std::scoped_lock lock(mutex);
+  ApplyChannelVolume(volume);
+  channelVolume = volume;
+}
+
+void AudioResourceManager::ApplyStreamVolume(float volume) {
   stream.setVolume(volume);
   midiMusic.setVolume(volume);
   midiMusic.setGain(1.0);
-  streamVolume = volume;
 }
 
-void AudioResourceManager::SetChannelVolume(float volume) {
+void AudioResourceManager::ApplyChannelVolume(float volume) {
   for (int i = 0; i < NUM_OF_CHANNELS; i++) {
     channels[i].buffer.setVolume(volume);
   }
 
-  channelVolume = volume;
+  for (StreamVoice& voice : streamVoices) {
+    voice.music.setVolume(volume);
+  }
 }
 
 const float AudioResourceManager::GetStreamVolume() const
 {
+  std::scoped_lock lock(mutex);
   return this->streamVolume;
 }
@@ -3,14 +3,22 @@
 #include <SFML/Audio/SoundBuffer.hpp>
 #include <SFML/Audio/Sound.hpp>
 #include <SFML/Audio/Music.hpp>
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 #include "sfMidi/include/sfMidi.h"
 #include "bnAudioType.h"
-#include "bnCachedResource.h"
+#include "bnMappedFile.h"
+#include "bnResourceCache.h"
 
 // For more retro experience, decrease available channels.
 #define NUM_OF_CHANNELS 15
@@ -19,6 +27,14 @@
 // Allows duplicate audio samples to play in X ms apart from eachother
 #define AUDIO_DUPLICATES_ALLOWED_IN_X_MILLISECONDS 58 // 58ms = ~3.5 frames @ 60fps
 
+// Memory for decoded sound effects loaded from file, e.g. by mods, kept after they stop playing
+#define BN_AUDIO_CACHE_BUDGET_MB 64
+#define BN_AUDIO_CACHE_EXPIRE_SECONDS 60.0f
+
+// Sound files at least this large are mapped and decoded while they play instead of all at once
+#define BN_AUDIO_STREAM_MIN_FILE_BYTES (512u * 1024u)
+#define BN_AUDIO_STREAM_VOICES 2
+
 /**
   * @class AudioPriority
   * @brief Each priority describes how or if a playing sample should be interrupted
@@ -75,7 +91,31 @@ public:
    */
   void LoadSource(AudioType type, const std::string& path);
 
+  /**
+   * @brief Loads a sample from disc. Samples are cached until evicted under the budget or expired.
+   *
+   * Files of BN_AUDIO_STREAM_MIN_FILE_BYTES or more are not decoded. The returned buffer is
+   * empty and only identifies the sound to Play(), which decodes it from the mapped file as it plays.
+   */
   std::shared_ptr<sf::SoundBuffer> LoadFromFile(const std::string& path);
+
+  /**
+   * @brief Drops cached samples that are not playing or held and were not requested recently
+   */
+  void HandleExpiredAudioCache();
+
+  /**
+   * @brief Sets how many bytes of samples loaded from file may stay cached
+   * @param bytes 0 is unlimited
+   */
+  void SetCacheBudget(size_t bytes);
+
+  ResourceCacheStats GetCacheStats() const;
+
+  /**
+   * @brief Estimated memory used by the samples of a sound buffer
+   */
+  static size_t SoundBufferBytes(const sf::SoundBuffer& buffer);
   
   /**
    * @brief Play a sound with an Audio() priority
@@ -99,20 +139,78 @@ public:
   ~AudioResourceManager();
 
 private:
+  using Clock = std::chrono::steady_clock;
+
   struct Channel {
     sf::Sound buffer;
     AudioPriority priority{ AudioPriority::lowest };
+    std::shared_ptr<sf::SoundBuffer> resource; /*!< Keeps a cached sample alive while the channel uses it */
+    const sf::SoundBuffer* sample{ nullptr }; /*!< Sample being played or nullptr if the channel is free */
+    Clock::time_point endsAt; /*!< When the sample is expected to finish */
+    unsigned generation{}; /*!< Incremented each time a sample starts so stale entries in channelEnds are skipped */
+  };
+
+  //!< Channels playing the same sample
+  struct SampleVoices {
+    unsigned playing{};
+    Clock::time_point lastStart;
+  };
+
+  //!< A sound loaded by LoadFromFile() that is decoded from its mapped file as it plays
+  struct StreamedSample {
+    std::weak_ptr<sf::SoundBuffer> handle; /*!< Address may be reused once this expires */
+    std::shared_ptr<MappedFile> file;
+  };
+
+  struct StreamVoice {
+    sf::Music music;
+    std::shared_ptr<MappedFile> file; /*!< Read by the music while it plays */
+    const sf::SoundBuffer* sample{ nullptr };
+    AudioPriority priority{ AudioPriority::lowest };
+    Clock::time_point startedAt;
   };
 
+  using ChannelEnd = std::tuple<Clock::time_point, int, unsigned>; //!< End time, channel, generation
+
   sfmidi::Midi midiMusic;
-  std::mutex mutex;
+  mutable std::mutex mutex; /*!< Held by every public function. Sounds are played from the logic thread and the cache expires on the event thread. */
   Channel* channels;
+  std::vector<int> freeChannels; /*!< Channels with nothing playing */
+  std::priority_queue<ChannelEnd, std::vector<ChannelEnd>, std::greater<ChannelEnd>> channelEnds; /*!< Busy channels, soonest to finish first */
+  std::unordered_map<const sf::SoundBuffer*, SampleVoices> sampleVoices; /*!< Samples with at least one channel playing them */
+  std::array<StreamVoice, BN_AUDIO_STREAM_VOICES> streamVoices;
+  std::unordered_map<const sf::SoundBuffer*, StreamedSample> streamed;
   sf::SoundBuffer* sources;
-  std::map<std::string, CachedResource<sf::SoundBuffer>> cached;
+  ResourceCache<sf::SoundBuffer> cached;
   sf::Music stream;
   std::string currStreamPath;
   float channelVolume{};
   float streamVolume{};
   bool isEnabled{true};
   bool muted{false};
+
+  /**
+   * @brief Frees the channels whose samples finished by now
+   */
+  void ReclaimChannels(Clock::time_point now);
+
+  /**
+   * @brief Forgets the sample on a channel. The caller decides whether the channel goes back in freeChannels.
+   */
+  void ReleaseChannel(int index);
+
+  /**
+   * @brief Busy channel a sound of this priority may interrupt, preferring the one closest to finishing
+   * @return -1 if there is none
+   */
+  int StealChannel(AudioPriority priority, const sf::SoundBuffer* sample) const;
+
+  /**
+   * @brief Sets the volume of the music or the sound channels without changing the volume restored by Mute(false)
+   */
+  void ApplyStreamVolume(float volume);
+  void ApplyChannelVolume(float volume);
+
+  int PlaySample(const sf::SoundBuffer& sample, std::shared_ptr<sf::SoundBuffer> resource, AudioPriority priority);
+  int PlayStreamed(const sf::SoundBuffer* sample, const std::shared_ptr<MappedFile>& file, AudioPriority priority);
 };
\ No newline at end of file
@@ -0,0 +1,360 @@
+#include "bnBattleReplay.h"
+#include "bnCardFolder.h"
+#include "bnCardPackageManager.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace {
+  const char REPLAY_MAGIC[4] = { 'O', 'N', 'B', 'R' };
+
+  void WriteVarint(std::string& out, uint64_t value) {
+    do {
+      unsigned char byte = value & 0x7F;
+      value >>= 7;
+
+      if (value) {
+        byte |= 0x80;
+      }
+
+      out.push_back(static_cast<char>(byte));
+    } while (value);
+  }
+
+  void WriteString(std::string& out, const std::string& str) {
+    WriteVarint(out, str.size());
+    out += str;
+  }
+
+  //!< Reads values out of a replay buffer. Any read past the end flags the reader as failed.
+  struct ReplayReader {
+    const std::string& buffer;
+    size_t pos{};
+    bool failed{};
+
+    uint64_t Varint() {
+      uint64_t value{};
+      unsigned shift{};
+
+      while (!failed) {
+        if (pos >= buffer.size() || shift > 63) {
+          failed = true;
+          break;
+        }
+
+        unsigned char byte = static_cast<unsigned char>(buffer[pos++]);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+        if ((byte & 0x80) == 0) break;
+
+        shift += 7;
+      }
+
+      return value;
+    }
+
+    std::string String() {
+      uint64_t len = Varint();
+
+      if (failed || len > buffer.size() - pos) {
+        failed = true;
+        return {};
+      }
+
+      std::string out = buffer.substr(pos, static_cast<size_t>(len));
+      pos += static_cast<size_t>(len);
+      return out;
+    }
+  };
+
+  void WritePackage(std::string& out, const BattleReplay::Package& package) {
+    WriteString(out, package.namespaceId);
+    WriteString(out, package.packageId);
+    WriteString(out, package.fingerprint);
+  }
+
+  BattleReplay::Package ReadPackage(ReplayReader& reader) {
+    BattleReplay::Package package;
+    package.namespaceId = reader.String();
+    package.packageId = reader.String();
+    package.fingerprint = reader.String();
+    return package;
+  }
+}
+
+uint32_t BattleReplay::InternName(const std::string& name)
+{
+  auto iter = nameToIndex.find(name);
+
+  if (iter != nameToIndex.end()) {
+    return iter->second;
+  }
+
+  uint32_t index = static_cast<uint32_t>(names.size());
+  names.push_back(name);
+  nameToIndex.insert(std::make_pair(name, index));
+  return index;
+}
+
+void BattleReplay::RecordFrame(size_t playerIndex, frame_time_t frame, const std::unordered_map<std::string, InputState>& state)
+{
+  if (players.size() <= playerIndex) {
+    players.resize(playerIndex + 1u);
+  }
+
+  frameCount = frame_time_t::max(frameCount, frame + frames(1));
+
+  PlayerLog& log = players[playerIndex];
+
+  if (!log.spans.empty()) {
+    const Span& last = log.spans.back();
+
+    if (frame < last.start + frames(last.repeat)) {
+      Logger::Logf(LogLevel::warning, "Replay frame %lld was already recorded for player %d", static_cast<long long>(frame.count()), static_cast<int>(playerIndex));
+      return;
+    }
+  }
+
+  // Frames without any input are implied by gaps between spans
+  std::vector<Event> events;
+  events.reserve(state.size());
+
+  for (auto& [name, inputState] : state) {
+    if (inputState == InputState::none) continue;
+    events.push_back(Event{ InternName(name), inputState });
+  }
+
+  if (events.empty()) return;
+
+  // Hash maps have no stable order, sort so identical states compare equal
+  std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.name < b.name; });
+
+  if (!log.spans.empty()) {
+    Span& last = log.spans.back();
+
+    bool isNextFrame = last.start + frames(last.repeat) == frame;
+    bool isSameState = last.eventCount == events.size() && std::equal(events.begin(), events.end(), log.events.begin() + last.firstEvent,
+      [](const Event& a, const Event& b) { return a.name == b.name && a.state == b.state; });
+
+    if (isNextFrame && isSameState) {
+      last.repeat++;
+      return;
+    }
+  }
+
+  Span span;
+  span.start = frame;
+  span.firstEvent = static_cast<uint32_t>(log.events.size());
+  span.eventCount = static_cast<uint32_t>(events.size());
+  log.spans.push_back(span);
+  log.events.insert(log.events.end(), events.begin(), events.end());
+}
+
+void BattleReplay::PlayFrame(size_t playerIndex, frame_time_t frame, const std::function<void(const InputEvent&)>& callback) const
+{
+  if (playerIndex >= players.size()) return;
+
+  const PlayerLog& log = players[playerIndex];
+
+  // Find the last span that starts on or before this frame
+  auto iter = std::upper_bound(log.spans.begin(), log.spans.end(), frame, [](const frame_time_t& frame, const Span& span) {
+    return frame < span.start;
+  });
+
+  if (iter == log.spans.begin()) return;
+
+  const Span& span = *std::prev(iter);
+
+  if (frame >= span.start + frames(span.repeat)) return;
+
+  for (uint32_t i = 0; i < span.eventCount; i++) {
+    const Event& event = log.events[span.firstEvent + i];
+    callback(InputEvent{ names[event.name], event.state });
+  }
+}
+
+frame_time_t BattleReplay::FrameCount() const
+{
+  return frameCount;
+}
+
+const size_t BattleReplay::PlayerCount() const
+{
+  return players.size();
+}
+
+void BattleReplay::RecordFolder(CardFolder& cardFolder, CardPackageManager& packageManager)
+{
+  folder.clear();
+
+  for (CardFolder::Iter iter = cardFolder.Begin(); iter != cardFolder.End(); iter++) {
+    const Battle::Card::Properties& props = (*iter)->props;
+
+    Card card;
+    card.code = props.code;
+
+    if (packageManager.HasPackage(props.uuid)) {
+      card.package = DescribePackage(packageManager, props.uuid);
+    }
+    else {
+      card.package = Package{ packageManager.GetNamespace(), props.uuid, "" };
+    }
+
+    folder.push_back(card);
+  }
+}
+
+std::unique_ptr<CardFolder> BattleReplay::BuildFolder(CardPackageManager& packageManager) const
+{
+  std::unique_ptr<CardFolder> cardFolder = std::make_unique<CardFolder>();
+
+  for (const Card& card : folder) {
+    if (!VerifyPackage(packageManager, card.package) && !packageManager.HasPackage(card.package.packageId)) {
+      continue;
+    }
+
+    Battle::Card::Properties props = packageManager.FindPackageByID(card.package.packageId).GetCardProperties();
+    props.code = card.code;
+    cardFolder->AddCard(props);
+  }
+
+  return cardFolder;
+}
+
+bool BattleReplay::Save(const std::string& path) const
+{
+  std::string out;
+  out.append(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+  WriteVarint(out, VERSION);
+  WriteVarint(out, seed);
+  WriteVarint(out, static_cast<uint64_t>(frameCount.count()));
+
+  WritePackage(out, player);
+  WritePackage(out, mob);
+
+  WriteVarint(out, folder.size());
+  for (const Card& card : folder) {
+    WritePackage(out, card.package);
+    out.push_back(card.code);
+  }
+
+  WriteVarint(out, names.size());
+  for (const std::string& name : names) {
+    WriteString(out, name);
+  }
+
+  WriteVarint(out, players.size());
+  for (const PlayerLog& log : players) {
+    WriteVarint(out, log.spans.size());
+
+    frame_time_t last{};
+    for (const Span& span : log.spans) {
+      WriteVarint(out, static_cast<uint64_t>((span.start - last).count()));
+      WriteVarint(out, span.repeat);
+      WriteVarint(out, span.eventCount);
+
+      for (uint32_t i = 0; i < span.eventCount; i++) {
+        const Event& event = log.events[span.firstEvent + i];
+        WriteVarint(out, (static_cast<uint64_t>(event.name) << 2) | static_cast<uint64_t>(event.state));
+      }
+
+      last = span.start;
+    }
+  }
+
+  std::ofstream file(path, std::ios::binary);
+
+  if (!file.is_open()) {
+    Logger::Logf(LogLevel::critical, "Could not open replay file %s for writing", path.c_str());
+    return false;
+  }
+
+  file.write(out.data(), out.size());
+  Logger::Logf(LogLevel::info, "Wrote replay %s (%d frames, %d bytes)", path.c_str(), static_cast<int>(frameCount.count()), static_cast<int>(out.size()));
+  return file.good();
+}
+
+stx::result_t<BattleReplay> BattleReplay::Load(const std::string& path)
+{
+  std::ifstream file(path, std::ios::binary);
+
+  if (!file.is_open()) {
+    return stx::error<BattleReplay>("Could not open replay file " + path);
+  }
+
+  std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  if (buffer.size() < sizeof(REPLAY_MAGIC) || !std::equal(std::begin(REPLAY_MAGIC), std::end(REPLAY_MAGIC), buffer.begin())) {
+    return stx::error<BattleReplay>(path + " is not a replay file");
+  }
+
+  ReplayReader reader{ buffer, sizeof(REPLAY_MAGIC) };
+
+  if (uint64_t version = reader.Varint(); version != VERSION) {
+    return stx::error<BattleReplay>("Unsupported replay version " + std::to_string(version));
+  }
+
+  BattleReplay replay;
+  replay.seed = static_cast<unsigned int>(reader.Varint());
+  replay.frameCount = frames(static_cast<int64_t>(reader.Varint()));
+  replay.player = ReadPackage(reader);
+  replay.mob = ReadPackage(reader);
+
+  uint64_t folderSize = reader.Varint();
+  for (uint64_t i = 0; i < folderSize && !reader.failed; i++) {
+    Card card;
+    card.package = ReadPackage(reader);
+
+    if (reader.pos >= buffer.size()) {
+      reader.failed = true;
+      break;
+    }
+
+    card.code = buffer[reader.pos++];
+    replay.folder.push_back(card);
+  }
+
+  uint64_t nameCount = reader.Varint();
+  for (uint64_t i = 0; i < nameCount && !reader.failed; i++) {
+    replay.InternName(reader.String());
+  }
+
+  uint64_t playerCount = reader.Varint();
+  for (uint64_t i = 0; i < playerCount && !reader.failed; i++) {
+    PlayerLog log;
+    frame_time_t last{};
+
+    uint64_t spanCount = reader.Varint();
+    for (uint64_t j = 0; j < spanCount && !reader.failed; j++) {
+      Span span;
+      span.start = last + frames(static_cast<int64_t>(reader.Varint()));
+      span.repeat = static_cast<uint32_t>(reader.Varint());
+      span.eventCount = static_cast<uint32_t>(reader.Varint());
+      span.firstEvent = static_cast<uint32_t>(log.events.size());
+
+      for (uint32_t k = 0; k < span.eventCount && !reader.failed; k++) {
+        uint64_t packed = reader.Varint();
+        Event event{ static_cast<uint32_t>(packed >> 2), static_cast<InputState>(packed & 0x3) };
+
+        if (event.name >= replay.names.size()) {
+          reader.failed = true;
+          break;
+        }
+
+        log.events.push_back(event);
+      }
+
+      log.spans.push_back(span);
+      last = span.start;
+    }
+
+    replay.players.push_back(std::move(log));
+  }
+
+  if (reader.failed) {
+    return stx::error<BattleReplay>(path + " is truncated or corrupt");
+  }
+
+  return stx::ok(replay);
+}
@@ -0,0 +1,155 @@
+/*! \file bnBattleReplay.h */
+
+/*! \brief Records everything needed to play a battle back frame for frame
+ *
+ * A replay stores the package addresses and fingerprints the battle was built
+ * from, the folder in draw order, the RNG seed, and the raw key events queued
+ * for every player on every frame, before VirtualInputState::Process() turned
+ * them into pressed, held, and released states. Queuing those events again
+ * with VirtualKeyEvent() makes Process() reproduce the same states, so a
+ * deterministic battle ends in the same state. The game and the headless
+ * simulator record the same events, so either can play the other's replays.
+ *
+ * Input logs are run-length encoded: consecutive frames with the same input
+ * state are stored once with a repeat count, and frames without input are not
+ * stored at all. Input names are kept in a string table and referenced by index.
+ *
+ * File layout (all integers are unsigned LEB128 varints, strings are a varint length then bytes):
+ *   "ONBR" version seed frameCount
+ *   player package, mob package (namespace, ID, fingerprint)
+ *   folder size, each card (package namespace, ID, fingerprint, code)
+ *   input name table size, each name
+ *   player count, each player's span count, each span (frame delta, repeat, event count, each (name index << 2 | state))
+ */
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "bnInputEvent.h"
+#include "frame_time_t.h"
+#include "bnLogger.h"
+#include "stx/result.h"
+
+class CardFolder;
+class CardPackageManager;
+
+class BattleReplay {
+public:
+  static constexpr uint32_t VERSION = 2;
+
+  struct Package {
+    std::string namespaceId, packageId, fingerprint;
+  };
+
+  struct Card {
+    Package package;
+    char code{ '*' };
+  };
+
+  unsigned int seed{};
+  Package player, mob;
+  std::vector<Card> folder; /*!< Cards in the same order as the CardFolder they were recorded from */
+
+  /**
+   * @brief Appends the key events queued for a player on a frame
+   * @param playerIndex index of the player. Players are created as needed.
+   * @param frame must be later than the last frame recorded for this player
+   * @param state raw key events e.g. from InputManager::EventsThisFrame(), not the processed state
+   */
+  void RecordFrame(size_t playerIndex, frame_time_t frame, const std::unordered_map<std::string, InputState>& state);
+
+  /**
+   * @brief Invokes `callback` for every input the player had on a frame
+   * @param playerIndex index of the player
+   * @param frame frame to look up
+   * @param callback receives each input event. Feed these into VirtualKeyEvent()
+   */
+  void PlayFrame(size_t playerIndex, frame_time_t frame, const std::function<void(const InputEvent&)>& callback) const;
+
+  /**
+   * @brief Number of frames from the first frame to the last recorded frame
+   */
+  frame_time_t FrameCount() const;
+
+  const size_t PlayerCount() const;
+
+  /**
+   * @brief Copies the folder out of a CardFolder in its current order
+   * @param folder the folder the battle will draw from. Record it after shuffling.
+   * @param packageManager card packages the folder was built from
+   */
+  void RecordFolder(CardFolder& folder, CardPackageManager& packageManager);
+
+  /**
+   * @brief Rebuilds the recorded folder in the recorded order
+   * @param packageManager installed card packages
+   * @return CardFolder. Cards that are not installed are skipped with a warning.
+   */
+  std::unique_ptr<CardFolder> BuildFolder(CardPackageManager& packageManager) const;
+
+  /**
+   * @brief Describes an installed package so playback can check it has not changed
+   */
+  template<typename PackageManagerT>
+  static Package DescribePackage(PackageManagerT& packageManager, const std::string& packageId);
+
+  /**
+   * @brief Checks a recorded package is installed and has the same fingerprint
+   * @return false if the package is missing or was modified. Playback may diverge.
+   */
+  template<typename PackageManagerT>
+  static bool VerifyPackage(PackageManagerT& packageManager, const Package& package);
+
+  bool Save(const std::string& path) const;
+  static stx::result_t<BattleReplay> Load(const std::string& path);
+
+private:
+  struct Event {
+    uint32_t name{};
+    InputState state{};
+  };
+
+  //!< A run of identical input state starting at `start` and lasting `repeat` frames
+  struct Span {
+    frame_time_t start{};
+    uint32_t repeat{ 1 };
+    uint32_t firstEvent{}, eventCount{};
+  };
+
+  struct PlayerLog {
+    std::vector<Span> spans;
+    std::vector<Event> events;
+  };
+
+  frame_time_t frameCount{};
+  std::vector<std::string> names;
+  std::unordered_map<std::string, uint32_t> nameToIndex;
+  std::vector<PlayerLog> players;
+
+  uint32_t InternName(const std::string& name);
+};
+
+template<typename PackageManagerT>
+BattleReplay::Package BattleReplay::DescribePackage(PackageManagerT& packageManager, const std::string& packageId) {
+  return Package{ packageManager.GetNamespace(), packageId, packageManager.FindPackageByID(packageId).GetPackageFingerprint() };
+}
+
+template<typename PackageManagerT>
+bool BattleReplay::VerifyPackage(PackageManagerT& packageManager, const Package& package) {
+  if (!packageManager.HasPackage(package.packageId)) {
+    Logger::Logf(LogLevel::critical, "Replay package %s is not installed", package.packageId.c_str());
+    return false;
+  }
+
+  if (packageManager.FindPackageByID(package.packageId).GetPackageFingerprint() != package.fingerprint) {
+    Logger::Logf(LogLevel::warning, "Replay package %s has changed since it was recorded. Playback may diverge.", package.packageId.c_str());
+    return false;
+  }
+
+  return true;
+}
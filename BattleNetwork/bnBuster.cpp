@@ -104,7 +104,7 @@ void Buster::OnCollision(const std::shared_ptr<Entity> entity)
     hitHeight /= 2;
   }
 
-  auto bhit = std::make_shared<BusterHit>(isCharged ? BusterHit::Type::CHARGED : BusterHit::Type::PEA);
+  auto bhit = GetField()->AllocEntity<BusterHit>(isCharged ? BusterHit::Type::CHARGED : BusterHit::Type::PEA);
   bhit->SetOffset({ random, -(GetHeight() + hitHeight) });
   GetField()->AddEntity(bhit, *GetTile());
 
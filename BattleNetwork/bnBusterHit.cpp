@@ -14,6 +14,17 @@ BusterHit::BusterHit(Type type) : Artifact(), type(type)
   setScale(2.f, 2.f);
 }
 
+void BusterHit::Reset(Type type)
+{
+  Artifact::Reset();
+
+  this->type = type;
+  offset = {};
+  animationComponent = nullptr;
+  SetLayer(0);
+  setScale(2.f, 2.f);
+}
+
 void BusterHit::Init()
 {
   Artifact::Init();
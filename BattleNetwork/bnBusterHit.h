@@ -21,6 +21,11 @@ public:
 
   BusterHit(Type type = Type::PEA);
   ~BusterHit();
+
+  /**
+   * @brief Restores the constructed state when recycled from an EntityPool
+   */
+  void Reset(Type type = Type::PEA);
   void SetOffset(const sf::Vector2f offset);
   void Init() override;
   void OnUpdate(double _elapsed) override;
@@ -36,9 +36,16 @@ public:
     return useCount;
   }
 
-  /*! \brief checks if this resource is still in use*/
+  /*! \brief checks if this resource is still in use
+    The cache holds one reference itself, so any other reference means it is in use.
+  */
   const bool IsInUse() const {
-    return resource.use_count() >= 1 || permanent;
+    return resource.use_count() > 1 || permanent;
+  }
+
+  /*! \brief keeps the resource cached no matter how long it goes unused */
+  void Pin() {
+    permanent = true;
   }
 
   /*! \brief returns the resource
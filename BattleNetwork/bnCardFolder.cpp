@@ -1,8 +1,13 @@
 #include "bnCardFolder.h"
+#include "bnCardPackageManager.h"
+#include "bnLogger.h"
+#include "stx/string.h"
 #include <assert.h>
 #include <sstream>
 #include <algorithm>
 #include <random>
+#include <fstream>
+#include <cctype>
 
 CardFolder::CardFolder() {
   folderSize = initialSize = 0;
@@ -65,3 +70,35 @@ CardFolder::Iter CardFolder::End()
 {
   return folderList.end();
 }
+
+std::unique_ptr<CardFolder> LoadFolderFromFile(const std::string& filePath, CardPackageManager& packageManager) {
+  std::unique_ptr<CardFolder> folder = std::make_unique<CardFolder>();
+  std::fstream file;
+  file.open(filePath, std::ios::in); 
+  const char space = ' ';
+
+  if (file.is_open()) {
+    std::string line;
+    while (std::getline(file, line)) { 
+      std::vector<std::string> tokens = stx::tokenize(line, space);
+
+      if (tokens.size() < 2) {
+        Logger::Logf(LogLevel::debug, "Card folder list needs two entries per line: `PACKAGE_ID CODE`");
+        continue;
+      }
+      const std::string packageID = tokens[0];
+      char code = tokens[1][0];
+      code = std::isalpha(code) ? code : '*';
+
+      if (packageManager.HasPackage(packageID)) {
+        Battle::Card::Properties props = packageManager.FindPackageByID(packageID).GetCardProperties();
+        props.code = code;
+        folder->AddCard(props);
+      }
+    }
+
+    file.close();
+  }
+
+  return folder;
+}
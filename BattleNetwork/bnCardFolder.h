@@ -3,6 +3,9 @@
 #include <vector>
 #include <algorithm>
 #include <memory>
+#include <string>
+
+class CardPackageManager;
 
 /**
  * @class CardFolder
@@ -83,3 +86,10 @@ public:
   Iter End();
 };
 
+/**
+ * @brief Reads a folder list on disk where each line contains a card package name and code e.g. `com.example.MockCard A`
+ * @param filePath path to the folder list
+ * @param packageManager card packages to look up each line in
+ * @return CardFolder in the same order as the list. Lines with unknown packages are skipped.
+ */
+std::unique_ptr<CardFolder> LoadFolderFromFile(const std::string& filePath, CardPackageManager& packageManager);
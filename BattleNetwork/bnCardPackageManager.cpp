@@ -11,7 +11,7 @@
 #endif
 
 CardMeta::CardMeta() :
-  iconTexture(), previewTexture(),
+  icon(), previewTexture(),
   PackageManager<CardMeta>::Meta<CardImpl>()
 { 
 }
@@ -21,7 +21,7 @@ CardMeta::~CardMeta() {
 
 CardMeta& CardMeta::SetIconTexture(const std::shared_ptr<sf::Texture> icon)
 {
-  CardMeta::iconTexture = icon;
+  CardMeta::icon = TextureRegion::Whole(icon);
 
   return *this;
 }
@@ -35,6 +35,14 @@ CardMeta& CardMeta::SetCodes(const std::vector<char> codes)
 void CardMeta::OnMetaParsed()
 {
   this->properties.uuid = this->GetPackageID();
+
+  // Hand and folder lists draw many icons in a row. From one page they share a texture.
+  // Icons that do not fit keep their own texture.
+  if (icon && !IconAtlas().Owns(icon.texture.get())) {
+    if (TextureRegion packed = IconAtlas().Add(icon.texture)) {
+      icon = packed;
+    }
+  }
 }
 
 CardMeta& CardMeta::SetPreviewTexture(const std::shared_ptr<Texture> texture)
@@ -43,9 +51,9 @@ CardMeta& CardMeta::SetPreviewTexture(const std::shared_ptr<Texture> texture)
   return *this;
 }
 
-const std::shared_ptr<Texture> CardMeta::GetIconTexture() const
+const TextureRegion& CardMeta::GetIconRegion() const
 {
-  return iconTexture;
+  return icon;
 }
 
 const std::shared_ptr<Texture> CardMeta::GetPreviewTexture() const
@@ -62,3 +70,9 @@ const std::vector<char> CardMeta::GetCodes() const
 {
   return codes;
 }
+
+TextureAtlas& CardMeta::IconAtlas()
+{
+  static TextureAtlas atlas(BN_CARD_ICON_ATLAS_PAGE_SIZE, BN_CARD_ICON_ATLAS_MAX_PAGES);
+  return atlas;
+}
@@ -6,11 +6,15 @@
 #include "bnPackageManager.h"
 #include "bnElements.h"
 #include "bnCard.h"
+#include "bnTextureAtlas.h"
 #include "bindings/bnCardImpl.h"
 
 /*! \brief Use this to register card mods with the engine
 */
 
+#define BN_CARD_ICON_ATLAS_PAGE_SIZE 256
+#define BN_CARD_ICON_ATLAS_MAX_PAGES 16
+
 class Character;
 class CardAction;
 
@@ -27,7 +31,7 @@ struct AdjacentCards {
 
 struct CardMeta final : public PackageManager<CardMeta>::Meta<CardImpl> {
   Battle::Card::Properties properties;
-  std::shared_ptr<sf::Texture> iconTexture; /*!< Icon used in hand */
+  TextureRegion icon; /*!< Icon used in hand. Moved into IconAtlas() once the package is parsed */
   std::shared_ptr<sf::Texture> previewTexture; /*!< Picture used in select widget */
   std::vector<char> codes;
   std::function<void(Battle::Card::Properties&, AdjacentCards&)> filterHandStep; // Unique filter 
@@ -56,10 +60,10 @@ struct CardMeta final : public PackageManager<CardMeta>::Meta<CardImpl> {
   CardMeta& SetCodes(const std::vector<char> codes);
 
   /**
-   * @brief Gets the icon texture to draw
-   * @return const sf::Texture&
+   * @brief Gets the icon to draw. Use both the texture and the rect, the texture is usually an atlas page.
+   * @return const TextureRegion&
    */
-  const std::shared_ptr<sf::Texture> GetIconTexture() const;
+  const TextureRegion& GetIconRegion() const;
 
   /**
    * @brief Gets the preview texture to draw
@@ -71,6 +75,11 @@ struct CardMeta final : public PackageManager<CardMeta>::Meta<CardImpl> {
   Battle::Card::Properties& GetCardProperties();
 
   const std::vector<char> GetCodes() const;
+
+  /**
+   * @brief Atlas shared by the icons of every card package
+   */
+  static TextureAtlas& IconAtlas();
 };
 
 class CardPackageManager : public PackageManager<CardMeta> {
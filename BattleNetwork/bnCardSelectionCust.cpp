@@ -133,19 +133,19 @@ CardSelectionCust::CardSelectionCust(CardSelectionCust::Props _props) :
   emblem.setScale(2.f, 2.f);
   emblem.setPosition(194.0f, 14.0f);
 
-  custSprite = sf::Sprite(*Textures().LoadFromFile(TexturePaths::CHIP_SELECT_MENU));
+  custSprite = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::CHIP_SELECT_MENU));
   custSprite.setScale(2.f, 2.f);
   custSprite.setPosition(-custSprite.getTextureRect().width*2.f, 0);
 
-  custDarkCardOverlay = sf::Sprite(*Textures().LoadFromFile(TexturePaths::CHIP_SELECT_DARK_OVERLAY));
+  custDarkCardOverlay = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::CHIP_SELECT_DARK_OVERLAY));
   custDarkCardOverlay.setScale(2.f, 2.f);
   custDarkCardOverlay.setPosition(custSprite.getPosition());
 
   custMegaCardOverlay = custDarkCardOverlay;
-  custMegaCardOverlay.setTexture(*Textures().LoadFromFile(TexturePaths::CHIP_SELECT_MEGA_OVERLAY));
+  custMegaCardOverlay.setTexture(*Textures().LoadPinnedFromFile(TexturePaths::CHIP_SELECT_MEGA_OVERLAY));
 
   custGigaCardOverlay = custDarkCardOverlay;
-  custGigaCardOverlay.setTexture(*Textures().LoadFromFile(TexturePaths::CHIP_SELECT_GIGA_OVERLAY));
+  custGigaCardOverlay.setTexture(*Textures().LoadPinnedFromFile(TexturePaths::CHIP_SELECT_GIGA_OVERLAY));
 
   // TODO: fully use scene nodes on all card slots and the GUI sprite
   // AddSprite(custSprite);
@@ -163,16 +163,16 @@ CardSelectionCust::CardSelectionCust(CardSelectionCust::Props _props) :
   element.setScale(2.f, 2.f);
   element.setPosition(2.f*25.f, 146.f);
 
-  cursorSmall = sf::Sprite(*Textures().LoadFromFile(TexturePaths::CHIP_CURSOR_SMALL));
+  cursorSmall = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::CHIP_CURSOR_SMALL));
   cursorSmall.setScale(sf::Vector2f(2.f, 2.f));
 
-  cursorBig = sf::Sprite(*Textures().LoadFromFile(TexturePaths::CHIP_CURSOR_BIG));
+  cursorBig = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::CHIP_CURSOR_BIG));
   cursorBig.setScale(sf::Vector2f(2.f, 2.f));
 
   // never moves
   cursorBig.setPosition(sf::Vector2f(2.f*104.f, 2.f*122.f));
 
-  cardLock = sf::Sprite(*Textures().LoadFromFile(TexturePaths::CHIP_LOCK));
+  cardLock = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::CHIP_LOCK));
   cardLock.setScale(sf::Vector2f(2.f, 2.f));
 
   cardCard.setScale(2.f, 2.f);
@@ -214,7 +214,7 @@ CardSelectionCust::CardSelectionCust(CardSelectionCust::Props _props) :
 
   formSelectQuitTimer = 0.f; // used to time out the activation
 
-  formItemBG.setTexture(*Textures().LoadFromFile(TexturePaths::CUST_FORM_ITEM_BG));
+  formItemBG.setTexture(*Textures().LoadPinnedFromFile(TexturePaths::CUST_FORM_ITEM_BG));
   formItemBG.setScale(2.f, 2.f);
 
   formSelect.setTexture(Textures().LoadFromFile(TexturePaths::CUST_FORM_SELECT));
@@ -618,7 +618,7 @@ void CardSelectionCust::SetPlayerFormOptions(const std::vector<PlayerFormMeta*>
   for (auto&& f : forms) {
     this->forms.push_back(f);
     sf::Sprite ui;
-    ui.setTexture(*Textures().LoadFromFile(f->GetUIPath()));
+    ui.setTexture(*Textures().LoadPinnedFromFile(f->GetUIPath()));
     ui.setScale(2.f, 2.f);
     formUI.push_back(ui);
   }
@@ -700,19 +700,18 @@ void CardSelectionCust::draw(sf::RenderTarget & target, sf::RenderStates states)
 
     icon.setPosition(offset + 2.f*(9.0f + ((i%5)*16.0f)), 2.f*(105.f + (row*24.0f)) );
 
-    std::shared_ptr<sf::Texture> texture;
     std::string id = queue[i].data->GetUUID();
 
     if (props.roster->HasPackage(id)) {
-      texture = props.roster->FindPackageByID(id).GetIconTexture();
+      const TextureRegion& region = props.roster->FindPackageByID(id).GetIconRegion();
+      icon.setTexture(region.texture, false);
+      icon.setTextureRect(region.rect);
       smCodeLabel.SetColor(sf::Color::Yellow);
     }
     else {
-      texture = noIcon;
+      icon.setTexture(noIcon);
       smCodeLabel.SetColor(sf::Color::Red);
     }
-    
-    icon.setTexture(texture);
     icon.SetShader(nullptr);
 
     if (queue[i].state == Bucket::state::voided) {
@@ -739,18 +738,17 @@ void CardSelectionCust::draw(sf::RenderTarget & target, sf::RenderStates states)
     icon.setPosition(offset + 2 * 97.f, 2.f*(25.0f + (i*16.0f)));
 
     // Draw the selected card card
-    std::shared_ptr<sf::Texture> texture;
     std::string id = (*newSelectQueue[i]).data->GetUUID();
 
     if (props.roster->HasPackage(id)) {
-      texture = props.roster->FindPackageByID(id).GetIconTexture();
+      const TextureRegion& region = props.roster->FindPackageByID(id).GetIconRegion();
+      icon.setTexture(region.texture, false);
+      icon.setTextureRect(region.rect);
     }
     else {
-      texture = noIcon;
+      icon.setTexture(noIcon);
     }
 
-    icon.setTexture(texture);
-
     cardLock.setPosition(offset + 2 * 93.f, 2.f*(23.0f + (i*16.0f)));
     target.draw(cardLock, states);
     target.draw(icon, states);
@@ -22,8 +22,6 @@ Character::Character(Rank _rank) :
   CardActionUsePublisher(),
   Entity() {
 
-  EnableTilePush(true);
-
   using namespace std::placeholders;
   auto cardHandler = std::bind(&Character::HandleCardEvent, this, _1, _2);
   actionQueue.RegisterType<CardEvent>(ActionTypes::card, cardHandler);
@@ -31,6 +29,15 @@ Character::Character(Rank _rank) :
   auto peekHandler = std::bind(&Character::HandlePeekEvent, this, _1, _2);
   actionQueue.RegisterType<PeekCardEvent>(ActionTypes::peek_card, peekHandler);
 
+  SetCharacterDefaults();
+}
+
+Character::~Character() {
+}
+
+void Character::SetCharacterDefaults() {
+  EnableTilePush(true);
+
   RegisterStatusCallback(Hit::bubble, [this] {
     actionQueue.ClearQueue(ActionQueue::CleanupType::allow_interrupts);
     CreateComponent<BubbleTrap>(weak_from_this());
@@ -43,9 +50,6 @@ Character::Character(Rank _rank) :
   });
 }
 
-Character::~Character() {
-}
-
 void Character::Cleanup() {
   for (std::shared_ptr<CardAction>& action : asyncActions) {
     action->EndAction();
@@ -54,6 +58,19 @@ void Character::Cleanup() {
   Entity::Cleanup();
 }
 
+void Character::Recycle()
+{
+  Entity::Recycle();
+
+  // Cleanup() already ended these
+  asyncActions.clear();
+  currCardAction = nullptr;
+  cardActionStartDelay = frames(0);
+
+  // Entity::Recycle() dropped the status callbacks registered by the constructor
+  SetCharacterDefaults();
+}
+
 void Character::OnBattleStop()
 {
   asyncActions.clear();
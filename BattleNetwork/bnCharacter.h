@@ -48,6 +48,11 @@ private:
   std::vector<std::shared_ptr<CardAction>> asyncActions;
   std::shared_ptr<CardAction> currCardAction{ nullptr };
   frame_time_t cardActionStartDelay{0};
+
+  /**
+   * @brief Enables tile pushing and registers the status callbacks every character starts with
+   */
+  void SetCharacterDefaults();
 public:
 
   /**
@@ -70,6 +75,11 @@ public:
   virtual ~Character();
   virtual void Cleanup() override;
 
+  /**
+   * @brief Also drops card actions and restores the state every character starts with
+   */
+  void Recycle() override;
+
   virtual void OnBattleStop() override;
 
   virtual void MakeActionable();
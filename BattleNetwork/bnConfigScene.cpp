@@ -205,7 +205,7 @@ ConfigScene::ConfigScene(swoosh::ActivityController& controller) :
   endBtnAnimator.Load();
 
   // end button
-  endBtn = sf::Sprite(*Textures().LoadFromFile(TexturePaths::END_BTN));;
+  endBtn = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::END_BTN));;
   endBtn.setScale(2.f, 2.f);
   endBtnAnimator.SetAnimation("BLINK");
   endBtnAnimator.SetFrame(1, endBtn);
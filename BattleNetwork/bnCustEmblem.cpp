@@ -12,8 +12,8 @@ CustEmblem::CustEmblem() {
     wireShader->setUniform("numOfWires", numWires);
   }
 
-  emblem.setTexture(*handle.Textures().LoadFromFile(TexturePaths::CUST_BADGE));
-  emblemWireMask.setTexture(*handle.Textures().LoadFromFile(TexturePaths::CUST_BADGE_MASK));
+  emblem.setTexture(*handle.Textures().LoadPinnedFromFile(TexturePaths::CUST_BADGE));
+  emblemWireMask.setTexture(*handle.Textures().LoadPinnedFromFile(TexturePaths::CUST_BADGE_MASK));
 
   emblemWireMask.setPosition(-9.0f, -7.0f);
 }
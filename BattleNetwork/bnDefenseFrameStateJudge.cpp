@@ -1,11 +1,67 @@
 #include "bnDefenseFrameStateJudge.h"
 #include "bnDefenseRule.h"
+#include "bnLogger.h"
+
+void DefenseFrameStateJudge::Trigger::Execute()
+{
+  if (invoke) {
+    invoke(storage);
+  }
+
+  Release();
+}
+
+void DefenseFrameStateJudge::Trigger::Release()
+{
+  if (destroy) {
+    destroy(storage);
+  }
+
+  invoke = nullptr;
+  destroy = nullptr;
+  rule = nullptr;
+}
 
 DefenseFrameStateJudge::DefenseFrameStateJudge()
   : blockedDamage(false), blockedImpact(false), context(nullptr)
 {
 }
 
+DefenseFrameStateJudge::~DefenseFrameStateJudge()
+{
+  for (size_t i = 0; i < triggerCount; i++) {
+    triggers[i].Release();
+  }
+}
+
+bool DefenseFrameStateJudge::IsPierced(const DefenseRule* rule) const
+{
+  for (size_t i = 0; i < piercedCount; i++) {
+    if (pierced[i] == rule) return true;
+  }
+
+  return false;
+}
+
+bool DefenseFrameStateJudge::HasTrigger(const DefenseRule* rule) const
+{
+  for (size_t i = 0; i < triggerCount; i++) {
+    if (triggers[i].rule.get() == rule) return true;
+  }
+
+  return false;
+}
+
+DefenseFrameStateJudge::Trigger* DefenseFrameStateJudge::NextTriggerSlot()
+{
+  if (triggerCount == triggers.size()) {
+    Logger::Logf(LogLevel::warning, "DefenseFrameStateJudge: trigger capacity of %d reached, trigger was dropped", BN_MAX_DEFENSE_TRIGGERS);
+    return nullptr;
+  }
+
+  return &triggers[triggerCount++];
+}
+
 const bool DefenseFrameStateJudge::IsDamageBlocked() const
 {
   return blockedDamage;
@@ -30,17 +86,21 @@ void DefenseFrameStateJudge::SignalDefenseWasPierced()
 {
   if (context == nullptr) return;
 
-  piercedSet.insert(piercedSet.begin(), context);
+  if (!IsPierced(context.get()) && piercedCount < pierced.size()) {
+    pierced[piercedCount++] = context.get();
+  }
 
-  auto iter = triggers.find(context);
-  if (iter != triggers.end()) {
-    triggers.erase(iter);
+  // Released slots stay in place so the remaining triggers keep their order
+  for (size_t i = 0; i < triggerCount; i++) {
+    if (triggers[i].rule == context) {
+      triggers[i].Release();
+    }
   }
 }
 
-void DefenseFrameStateJudge::SetDefenseContext(std::shared_ptr<DefenseRule> ptr)
+void DefenseFrameStateJudge::SetDefenseContext(const std::shared_ptr<DefenseRule>& rule)
 {
-  context = ptr;
+  context = rule;
 }
 
 void DefenseFrameStateJudge::PrepareForNextAttack()
@@ -51,9 +111,9 @@ void DefenseFrameStateJudge::PrepareForNextAttack()
 
 void DefenseFrameStateJudge::ExecuteAllTriggers()
 {
-  for (auto&& [key, closure] : triggers) {
-    closure();
+  for (size_t i = 0; i < triggerCount; i++) {
+    triggers[i].Execute();
   }
 
-  triggers.clear();
+  triggerCount = 0;
 }
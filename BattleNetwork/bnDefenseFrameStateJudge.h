@@ -1,11 +1,16 @@
 #pragma once
-#include <map>
-#include <set>
+#include <array>
+#include <cstddef>
+#include <new>
+#include <tuple>
 #include <functional>
 #include <memory>
+#include <type_traits>
 
 class DefenseRule; // forward decl
 
+#define BN_MAX_DEFENSE_TRIGGERS 8
+
 /**
  * @class DefenseFrameStateJudge
  * @author mav
@@ -16,25 +21,54 @@ class DefenseRule; // forward decl
  * if a rule should block and if it triggers. If a defense rule has a trigger (callback),
  * then it is added to the list. Each attack has its `blockedDamage` and `blockedImpact` states reset.
  * However, proceeding attacks could signal the DefnseWasPierced routine which disables the trigger.
+ *
+ * A judge is created on the stack for every character in the attack step so triggers are
+ * stored in fixed-capacity slots and never allocate. Triggers execute in the order they were added,
+ * which follows the entity's defense rule priority order.
  */
 class DefenseFrameStateJudge final {
+  /**
+  * @brief Inline storage for a bound trigger callback and its arguments
+  */
+  struct Trigger {
+    static constexpr size_t STORAGE_SIZE = 64;
+
+    std::shared_ptr<DefenseRule> rule; /*!< Keeps the rule (and the callback it owns) alive until executed */
+    void (*invoke)(void*) { nullptr };
+    void (*destroy)(void*) { nullptr };
+    alignas(std::max_align_t) unsigned char storage[STORAGE_SIZE];
+
+    void Execute();
+    void Release();
+  };
+
   bool blockedDamage, blockedImpact;
-  std::map<std::shared_ptr<DefenseRule>, std::function<void()>> triggers;
-  std::set<std::shared_ptr<DefenseRule>> piercedSet;
+  std::array<Trigger, BN_MAX_DEFENSE_TRIGGERS> triggers;
+  std::array<DefenseRule*, BN_MAX_DEFENSE_TRIGGERS> pierced{};
+  size_t triggerCount{}, piercedCount{};
   std::shared_ptr<DefenseRule> context;
+
+  bool IsPierced(const DefenseRule* rule) const;
+  bool HasTrigger(const DefenseRule* rule) const;
+  Trigger* NextTriggerSlot();
 public:
   DefenseFrameStateJudge();
   DefenseFrameStateJudge(const DefenseFrameStateJudge&) = delete;
-  ~DefenseFrameStateJudge() = default;
+  ~DefenseFrameStateJudge();
 
   const bool IsDamageBlocked() const;
   const bool IsImpactBlocked() const;
   void BlockDamage();
   void BlockImpact();
   void SignalDefenseWasPierced();
-  void SetDefenseContext(std::shared_ptr<DefenseRule>);
+  void SetDefenseContext(const std::shared_ptr<DefenseRule>& rule);
   void PrepareForNextAttack();
 
+  /**
+  * @brief Queues a callback to run when the judge executes all triggers
+  * @param func the callback. Must be owned by the current defense rule context, it is not copied.
+  * @param args copied and passed into func when triggered
+  */
   template<typename Func, typename... Args>
   void AddTrigger(const Func& func, Args&&... args);
   void ExecuteAllTriggers();
@@ -45,15 +79,28 @@ void DefenseFrameStateJudge::AddTrigger(const Func& func, Args&&... args) {
   if (!context) return;
 
   // Prevent pierced defenses from re-triggering
-  for (auto pierced : piercedSet) {
-    if (pierced == context) return;
-  }
+  // and only keep the first trigger from each defense rule
+  if (IsPierced(context.get()) || HasTrigger(context.get())) return;
+
+  Trigger* slot = NextTriggerSlot();
+
+  if (!slot) return;
+
+  // Bind the callback to its inputs inside the trigger slot...
+  using Bound = std::tuple<const Func*, std::decay_t<Args>...>;
+  static_assert(sizeof(Bound) <= Trigger::STORAGE_SIZE, "Defense trigger arguments are too large for inline storage");
+  static_assert(alignof(Bound) <= alignof(std::max_align_t), "Defense trigger arguments are over-aligned");
+
+  new (slot->storage) Bound(&func, std::forward<Args>(args)...);
+
+  slot->invoke = [](void* data) {
+    std::apply([](const Func* func, auto&... args) { std::invoke(*func, args...); }, *static_cast<Bound*>(data));
+  };
 
-  // Create a closure around this function and its inputs...
-  auto closure = [func, args...]() -> void {
-      std::invoke(func, args...);
+  slot->destroy = [](void* data) {
+    static_cast<Bound*>(data)->~Bound();
   };
 
-  // Tag it with the defense rule that triggered it and store away in a unique map
-  triggers.insert(std::make_pair(context,closure));
-}
\ No newline at end of file
+  // Tag it with the defense rule that triggered it
+  slot->rule = context;
+}
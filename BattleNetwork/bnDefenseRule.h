@@ -5,6 +5,8 @@
 
 class Entity;
 
+#define BN_MAX_DEFENSE_RULES 16
+
 typedef int Priority;
 
 enum class DefenseOrder : int {
@@ -141,6 +141,12 @@ void DrawWindow::Draw(vector<Drawable*> _drawable, bool applyShaders) {
   }
 }
 
+void DrawWindow::UseVerticalSync(bool enabled) {
+  // SFML advises against using both at once
+  window->setFramerateLimit(enabled ? 0 : frame_time_t::frames_per_second);
+  window->setVerticalSyncEnabled(enabled);
+}
+
 bool DrawWindow::Running() {
   return window->isOpen();
 }
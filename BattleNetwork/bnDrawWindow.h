@@ -94,6 +94,13 @@ public:
    */
   RenderWindow* GetRenderWindow() const;
 
+  /**
+   * @brief If true, frames are paced by the display's refresh instead of capped at frame_time_t::frames_per_second
+   *
+   * Must be called from the thread that draws
+   */
+  void UseVerticalSync(bool enabled);
+
   void SupportShaders(bool support);
 
   /**
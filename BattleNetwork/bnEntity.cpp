@@ -6,11 +6,23 @@
 #include "bnShakingEffect.h"
 #include "bnShaderResourceManager.h"
 #include "bnTextureResourceManager.h"
+#include "bnLogger.h"
+#include <array>
 #include <cmath>
 #include <Swoosh/Ease.h>
 
 long Entity::numOfIDs = 0;
 
+namespace {
+  // Battle character shader uniforms, interned once
+  const SmartShader::UniformId textureUniform = SmartShader::Uniform("texture");
+  const SmartShader::UniformId additiveModeUniform = SmartShader::Uniform("additiveMode");
+  const SmartShader::UniformId swapPaletteUniform = SmartShader::Uniform("swapPalette");
+  const SmartShader::UniformId paletteUniform = SmartShader::Uniform("palette");
+  const SmartShader::UniformId paletteRowUniform = SmartShader::Uniform("paletteRow");
+  const SmartShader::UniformId statesUniform = SmartShader::Uniform("states");
+}
+
 bool EntityComparitor::operator()(std::shared_ptr<Entity> f, std::shared_ptr<Entity> s) const
 {
   return f->GetID() < s->GetID();
@@ -36,15 +48,7 @@ Entity::Entity() :
 
   SetColorMode(ColorMode::additive);
   setColor(NoopCompositeColor(ColorMode::additive));
-
-  if (sf::Shader* shader = Shaders().GetShader(ShaderType::BATTLE_CHARACTER)) {
-    SetShader(shader);
-    SmartShader& smartShader = GetShader();
-    smartShader.SetUniform("texture", sf::Shader::CurrentTexture);
-    smartShader.SetUniform("additiveMode", true);
-    smartShader.SetUniform("swapPalette", false);
-    baseColor = sf::Color(0, 0, 0, 0);
-  }
+  ResetShader();
 
   using namespace std::placeholders;
   auto handler = std::bind(&Entity::HandleMoveEvent, this, _1, _2);
@@ -72,6 +76,75 @@ void Entity::Cleanup() {
   FreeAllComponents();
 }
 
+void Entity::Recycle()
+{
+  // Recycled entities are brand new as far as the field is concerned
+  ID = ++Entity::numOfIDs;
+
+  FreeAllComponents();
+  ClearPendingComponents();
+  actionQueue.ClearQueue(ActionQueue::CleanupType::clear_and_reset);
+
+  // Only the shadow node belongs to the base entity
+  std::vector<std::shared_ptr<SceneNode>> nodes = GetChildNodes();
+  for (std::shared_ptr<SceneNode>& node : nodes) {
+    if (node != shadow) {
+      RemoveNode(node);
+    }
+  }
+
+  shadow->Hide();
+
+  field.reset();
+  tile = previous = nullptr;
+  tileOffset = moveStartPosition = drawOffset = counterSlideOffset = {};
+  currMoveEvent = {};
+  moveStartupDelay = {};
+  moveEndlagDelay.reset();
+  stunCooldown = rootCooldown = invincibilityCooldown = frames(0);
+  statusQueue = {};
+  statusCallbackHash.clear();
+  firstDeleteObserver = -1;
+  std::fill(defenses.begin(), defenses.begin() + defenseCount, nullptr);
+  defenseCount = 0;
+  name.clear();
+
+  hasSpawned = isUpdating = manualDelete = false;
+  hasInit = isTimeFrozen = fieldStart = false;
+  deleted = flagForErase = false;
+  counterable = neverFlip = hit = false;
+  ignoreCommonAggressor = passthrough = floatShoe = airShoe = false;
+  canTilePush = canShareTile = slideFromDrag = false;
+  hitboxEnabled = slidesOnTiles = true;
+  moveEventFrame = frame = 0;
+  moveCount = health = maxHealth = counterFrameFlag = 0;
+  currJumpHeight = height = elevation = counterSlideDelta = 0.f;
+  elapsedMoveTime = 0;
+  mode = Battle::TileHighlight::none;
+  hitboxProperties = Hit::DefaultProperties;
+  team = Team{};
+  element = Element::none;
+  direction = previousDirection = facing = Direction::none;
+
+  basePalette.reset();
+  SetPalette(nullptr);
+  palette.reset();
+
+  // Uniforms and shaders like the whiteout set by the last owner must not carry over
+  SetColorMode(ColorMode::additive);
+  ResetShader();
+
+  alpha = 255;
+  setPosition(0, 0);
+  setColor(NoopCompositeColor(GetColorMode()));
+  Reveal();
+}
+
+const bool Entity::IsPooled() const
+{
+  return pooled;
+}
+
 void Entity::SortComponents()
 {
   // Newest components appear first in the list for easy referencing
@@ -372,7 +445,7 @@ void Entity::Update(double _elapsed) {
   UpdateMovement(_elapsed);
 
   sf::Uint8 alpha = getSprite().getColor().a;
-  for (std::shared_ptr<SceneNode>& child : GetChildNodes()) {
+  for (const std::shared_ptr<SceneNode>& child : GetChildNodes()) {
     SpriteProxyNode* sprite = dynamic_cast<SpriteProxyNode*>(child.get());
     if (sprite) {
       sf::Color color = sprite->getColor();
@@ -432,16 +505,46 @@ void Entity::SetPalette(const std::shared_ptr<sf::Texture>& palette)
 {
   SmartShader& smartShader = GetShader();
 
+  paletteRow = -1;
+  paletteRegistered = false;
+
   if (palette.get() == nullptr) {
-    smartShader.SetUniform("swapPalette", false);
+    smartShader.SetUniform(swapPaletteUniform, false);
     swapPalette = false;
     return;
   }
 
   swapPalette = true;
   this->palette = palette;
-  smartShader.SetUniform("swapPalette", true);
-  smartShader.SetUniform("palette", this->palette);
+  ApplyPalette(smartShader);
+}
+
+void Entity::ApplyPalette(SmartShader& smartShader)
+{
+  if (!smartShader.HasShader()) return;
+
+  PaletteAtlas& atlas = Shaders().GetPaletteAtlas();
+
+  // Palettes are added to the atlas the first time a shader is there to draw them
+  if (swapPalette && !paletteRegistered) {
+    paletteRow = atlas.Register(palette);
+    paletteRegistered = true;
+  }
+
+  smartShader.SetUniform(swapPaletteUniform, swapPalette);
+
+  if (!swapPalette) return;
+
+  if (paletteRow >= 0) {
+    // every character samples the same texture, only the row differs
+    smartShader.SetUniform(paletteUniform, atlas.GetTexture());
+    smartShader.SetUniform(paletteRowUniform, PaletteAtlas::RowCoordinate(paletteRow));
+  }
+  else {
+    // not in the atlas, e.g. it is full. The palette texture is bound itself and its first row is read.
+    smartShader.SetUniform(paletteUniform, palette);
+    smartShader.SetUniform(paletteRowUniform, 0.f);
+  }
 }
 
 std::shared_ptr<sf::Texture> Entity::GetPalette()
@@ -459,6 +562,20 @@ std::shared_ptr<sf::Texture> Entity::GetBasePalette()
   return basePalette;
 }
 
+void Entity::ResetShader()
+{
+  RevokeShader();
+
+  if (sf::Shader* shader = Shaders().GetShader(ShaderType::BATTLE_CHARACTER)) {
+    SetShader(shader);
+    SmartShader& smartShader = GetShader();
+    smartShader.SetUniform(textureUniform, sf::Shader::CurrentTexture);
+    smartShader.SetUniform(additiveModeUniform, true);
+    smartShader.SetUniform(swapPaletteUniform, false);
+    baseColor = sf::Color(0, 0, 0, 0);
+  }
+}
+
 void Entity::RefreshShader()
 {
   std::shared_ptr<Field> field = this->field.lock();
@@ -469,7 +586,7 @@ void Entity::RefreshShader()
 
   sf::Shader* shader = Shaders().GetShader(ShaderType::BATTLE_CHARACTER);
 
-  if (shader != GetShader().Get()) {
+  if (shader != GetShader().Peek()) {
     SetShader(shader);
   }
 
@@ -477,8 +594,7 @@ void Entity::RefreshShader()
 
   if (!smartShader.HasShader()) return;
 
-  smartShader.SetUniform("swapPalette", swapPalette);
-  smartShader.SetUniform("palette", palette);
+  ApplyPalette(smartShader);
 
   // state checks
   unsigned stunFrame = stunCooldown.count() % 4;
@@ -488,14 +604,14 @@ void Entity::RefreshShader()
 
   bool iframes = invincibilityCooldown > frames(0);
 
-  vector<float> states = {
+  std::array<float, 3> states = {
     static_cast<float>(hit),                                                // WHITEOUT
     static_cast<float>(rootCooldown > frames(0) && (iframes || rootFrame)), // BLACKOUT
     static_cast<float>(stunCooldown > frames(0) && (iframes || stunFrame))  // HIGHLIGHT
   };
 
-  smartShader.SetUniform("states", states);
-  smartShader.SetUniform("additiveMode", GetColorMode() == ColorMode::additive);
+  smartShader.SetUniform(statesUniform, states.data(), states.size());
+  smartShader.SetUniform(additiveModeUniform, GetColorMode() == ColorMode::additive);
 
   bool enabled = states[0] || states[1];
 
@@ -522,16 +638,7 @@ void Entity::draw(sf::RenderTarget& target, sf::RenderStates states) const
 
   states.transform *= combinedTransform;
 
-  std::vector<SceneNode*> copies;
-  copies.reserve(childNodes.size() + 1);
-
-  for (std::shared_ptr<SceneNode>& child : childNodes) {
-    copies.push_back(child.get());
-  }
-
-  copies.push_back((SceneNode*)this);
-
-  std::sort(copies.begin(), copies.end(), [](SceneNode* a, SceneNode* b) { return (a->GetLayer() > b->GetLayer()); });
+  const std::vector<SceneNode*>& copies = GetDrawOrder();
 
   // draw its children
   for (std::size_t i = 0; i < copies.size(); i++) {
@@ -551,7 +658,7 @@ void Entity::draw(sf::RenderTarget& target, sf::RenderStates states) const
     }
     else {
       SpriteProxyNode* asSpriteProxyNode{ nullptr };
-      SmartShader temp(smartShader);
+      const SmartShader::Uniforms saved = smartShader.GetUniforms();
 
       /**
       hack for now.
@@ -564,7 +671,7 @@ void Entity::draw(sf::RenderTarget& target, sf::RenderStates states) const
         asSpriteProxyNode = dynamic_cast<SpriteProxyNode*>(currNode);
 
         if (asSpriteProxyNode) {
-          smartShader.SetUniform("swapPalette", false);
+          smartShader.SetUniform(swapPaletteUniform, false);
           tempColor = asSpriteProxyNode->getColor();
           asSpriteProxyNode->setColor(sf::Color(0, 0, 0, getColor().a));
           needsRevert = true;
@@ -590,7 +697,7 @@ void Entity::draw(sf::RenderTarget& target, sf::RenderStates states) const
       }
 
       // revert uniforms from this pass
-      smartShader = temp;
+      smartShader.SetUniforms(saved);
     }
   }
 }
@@ -1137,8 +1244,8 @@ const bool Entity::Hit(Hit::Properties props) {
     CreateComponent<ShakingEffect>(weak_from_this());
   }
   
-  for (std::shared_ptr<DefenseRule>& defense : defenses) {
-    props = defense->FilterStatuses(props);
+  for (size_t i = 0; i < defenseCount; i++) {
+    props = defenses[i]->FilterStatuses(props);
   }
 
   // If the character itself is also super-effective,
@@ -1472,20 +1579,31 @@ void Entity::AddDefenseRule(std::shared_ptr<DefenseRule> rule)
 {
   if (!rule) return;
 
-  auto iter = std::find_if(defenses.begin(), defenses.end(), [rule](auto other) { return rule->GetPriorityLevel() == other->GetPriorityLevel(); });
+  auto first = defenses.begin();
+  auto last = first + defenseCount;
+  auto iter = std::find_if(first, last, [&rule](const std::shared_ptr<DefenseRule>& other) { return rule->GetPriorityLevel() == other->GetPriorityLevel(); });
 
-  if (rule && iter == defenses.end()) {
-    defenses.push_back(rule);
-    std::sort(defenses.begin(), defenses.end(), [](std::shared_ptr<DefenseRule> first,std::shared_ptr<DefenseRule> second) { return first->GetPriorityLevel() < second->GetPriorityLevel(); });
-  }
-  else {
-    (*iter)->replaced = true; // Flag that this defense rule may be valid ptr, but is no longer in use
-    (*iter)->OnReplace();
-    RemoveDefenseRule(*iter); // will invalidate the iterator
+  if (iter != last) {
+    std::shared_ptr<DefenseRule> old = *iter;
+    old->replaced = true; // Flag that this defense rule may be valid ptr, but is no longer in use
+    old->OnReplace();
+    RemoveDefenseRule(old); // will invalidate the iterator
 
     // call again, adding new rule this time
     AddDefenseRule(rule);
+    return;
+  }
+
+  if (defenseCount == defenses.size()) {
+    Logger::Logf(LogLevel::warning, "Entity %ld cannot have more than %d defense rules", ID, BN_MAX_DEFENSE_RULES);
+    return;
   }
+
+  // Insert after any rule with a lower priority level to keep the list sorted
+  iter = std::upper_bound(first, last, rule, [](const std::shared_ptr<DefenseRule>& a, const std::shared_ptr<DefenseRule>& b) { return a->GetPriorityLevel() < b->GetPriorityLevel(); });
+  std::move_backward(iter, last, last + 1);
+  *iter = std::move(rule);
+  defenseCount++;
 }
 
 void Entity::RemoveDefenseRule(std::shared_ptr<DefenseRule> rule)
@@ -1495,24 +1613,35 @@ void Entity::RemoveDefenseRule(std::shared_ptr<DefenseRule> rule)
 
 void Entity::RemoveDefenseRule(DefenseRule* rule)
 {
-  auto iter = std::find_if(defenses.begin(), defenses.end(), [rule](auto in) { return in.get() == rule; });
+  auto first = defenses.begin();
+  auto last = first + defenseCount;
+  auto iter = std::find_if(first, last, [rule](const std::shared_ptr<DefenseRule>& in) { return in.get() == rule; });
 
-  if(iter != defenses.end())
-    defenses.erase(iter);
+  if (iter == last) return;
+
+  std::move(iter + 1, last, iter);
+  defenses[--defenseCount] = nullptr;
 }
 
 void Entity::DefenseCheck(DefenseFrameStateJudge& judge, std::shared_ptr<Entity> in, const DefenseOrder& filter)
 {
-  std::vector<std::shared_ptr<DefenseRule>> copy = defenses;
+  // Rules can add or remove other rules while blocking so check against a copy on the stack
+  std::array<std::shared_ptr<DefenseRule>, BN_MAX_DEFENSE_RULES> copy;
+  size_t count = 0;
+
+  for (size_t i = 0; i < defenseCount; i++) {
+    if (defenses[i]->GetDefenseOrder() == filter) {
+      copy[count++] = defenses[i];
+    }
+  }
+
+  if (count == 0) return;
 
   auto characterPtr = shared_from_base<Character>();
 
-  for (int i = 0; i < copy.size(); i++) {
-    if (copy[i]->GetDefenseOrder() == filter) {
-      std::shared_ptr<DefenseRule> defenseRule = copy[i];
-      judge.SetDefenseContext(defenseRule);
-      defenseRule->CanBlock(judge, in, characterPtr);
-    }
+  for (size_t i = 0; i < count; i++) {
+    judge.SetDefenseContext(copy[i]);
+    copy[i]->CanBlock(judge, in, characterPtr);
   }
 }
 
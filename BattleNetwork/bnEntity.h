@@ -17,6 +17,7 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <array>
 #include <functional>
 using std::string;
 
@@ -109,6 +110,7 @@ public:
   friend class Field;
   friend class Component;
   friend class BattleSceneBase;
+  template<typename T> friend class EntityPool;
 
   enum class Shadow : char {
     none = 0,
@@ -176,12 +178,31 @@ public:
    */
   virtual void Cleanup();
 
+  /**
+   * @brief Restores the base entity state and assigns a new ID so a pooled entity can be reused
+   * @warning The entity must already be removed from the field and cleaned up
+   *
+   * Subclasses that set state or register callbacks in their constructor must restore them here
+   */
+  virtual void Recycle();
+
+  /**
+   * @brief Query if this entity was allocated by a field's entity pool
+   * @return true if the entity will be recycled when erased
+   */
+  const bool IsPooled() const;
+
   /**
    * @brief Entity::Update(dt) contains particular steps that gaurantee frame accuracy for child types
    */
   virtual void Update(double _elapsed);
   
   void RefreshShader();
+
+  /**
+   * @brief Points the battle character shader at this entity's row in the palette atlas
+   */
+  void ApplyPalette(SmartShader& smartShader);
   void draw(sf::RenderTarget& target, sf::RenderStates states) const final;
 
   /**
@@ -842,7 +863,11 @@ private:
   bool canShareTile{}; /*!< Some characters can share tiles with others */
   bool slideFromDrag{}; /*!< In combat, slides from tiles are cancellable. Slide via drag is not. This flag denotes which one we're in. */
   bool swapPalette{ false };
+  int paletteRow{ -1 }; /*!< Row of the palette in the shared palette atlas, -1 if it is not in the atlas */
+  bool paletteRegistered{ false }; /*!< The atlas was asked for a row for the current palette */
   bool fieldStart{ false }; /*!< Used to signify if battle has started */
+  bool pooled{ false }; /*!< If true, the field returns this entity to its pool when erased */
+  int firstDeleteObserver{ -1 }; /*!< Head of the intrusive delete observer list owned by the Field */
   int moveCount{}; /*!< Used by battle results */
   int health{};
   int maxHealth{};
@@ -855,7 +880,8 @@ private:
   Direction previousDirection{};
   Direction facing{};
   sf::Vector2f counterSlideOffset{ 0.f, 0.f }; /*!< Used when enemies delete on counter - they slide back */
-  std::vector<std::shared_ptr<DefenseRule>> defenses; /*<! All defense rules sorted by the lowest priority level */
+  std::array<std::shared_ptr<DefenseRule>, BN_MAX_DEFENSE_RULES> defenses; /*<! All defense rules sorted by the lowest priority level */
+  size_t defenseCount{}; /*!< Number of defense rules in use */
   std::string name; /*!< Name of the entity */
 
   // Statuses are resolved one property at a time
@@ -875,6 +901,11 @@ private:
    * @brief Used internally before moving and updates the start position
    */
   void UpdateMoveStartPosition();
+
+  /**
+   * @brief Drops the current shader and its uniforms and binds the battle character shader as constructed
+   */
+  void ResetShader();
 };
 
 template<typename ComponentType>
@@ -0,0 +1,88 @@
+/*! \brief Recycles short-lived battle entities instead of freeing them
+ *
+ * Effects like buster hits, poofs, explosions, and invisible hitboxes live for
+ * a few frames at most but construct a full Entity each time. Pools are owned
+ * by the Field and live as long as the battle does. When a pooled entity is
+ * erased from the field, the Field hands it back to its pool where it waits
+ * to be reinitialized by the next Acquire() call.
+ *
+ * Types placed in a pool must provide a Reset() hook that accepts the same
+ * arguments as their constructor and restores their constructed state.
+ *
+ * @warning Only pool entities that are not handed out to scripts. A recycled
+ * entity reuses its memory so any weak reference to it would observe the new
+ * entity instead of expiring.
+ */
+
+#pragma once
+#include <memory>
+#include <vector>
+
+class Entity;
+
+class EntityPoolBase {
+public:
+  virtual ~EntityPoolBase() = default;
+
+  /**
+  * @brief Takes back an entity that was erased from the field
+  * @param entity the entity to recycle
+  * @return true if the entity was placed back in the pool, false if it should be freed
+  */
+  virtual bool Reclaim(std::shared_ptr<Entity> entity) = 0;
+
+  /**
+  * @brief Frees all entities waiting in the pool
+  */
+  virtual void Clear() = 0;
+};
+
+template<typename T>
+class EntityPool : public EntityPoolBase {
+  size_t capacity{}; /*!< Max number of idle entities kept around */
+  std::vector<std::shared_ptr<T>> freeList; /*!< Idle entities ready to be reused */
+
+public:
+  EntityPool(size_t capacity = 32) : capacity(capacity) {
+    freeList.reserve(capacity);
+  }
+
+  ~EntityPool() = default;
+
+  /**
+  * @brief Reuses an idle entity if one exists, otherwise creates a new one
+  * @param args forwarded to the constructor or T::Reset()
+  */
+  template<typename... Args>
+  std::shared_ptr<T> Acquire(Args&&... args) {
+    if (freeList.empty()) {
+      std::shared_ptr<T> entity = std::make_shared<T>(std::forward<Args>(args)...);
+      entity->pooled = true;
+      return entity;
+    }
+
+    std::shared_ptr<T> entity = std::move(freeList.back());
+    freeList.pop_back();
+    entity->Reset(std::forward<Args>(args)...);
+    return entity;
+  }
+
+  bool Reclaim(std::shared_ptr<Entity> entity) override {
+    // Someone else is still holding onto this entity, it cannot be reused
+    if (entity.use_count() > 1 || freeList.size() >= capacity) {
+      return false;
+    }
+
+    entity->Recycle();
+    freeList.push_back(std::static_pointer_cast<T>(std::move(entity)));
+    return true;
+  }
+
+  void Clear() override {
+    freeList.clear();
+  }
+
+  const size_t IdleCount() const {
+    return freeList.size();
+  }
+};
@@ -10,12 +10,21 @@ using sf::IntRect;
 Explosion::Explosion(int _numOfExplosions, double _playbackSpeed) : 
   Artifact()
 {
+  setTexture(Textures().LoadFromFile(TexturePaths::MOB_EXPLOSION));
+  Reset(_numOfExplosions, _playbackSpeed);
+}
+
+void Explosion::Reset(int _numOfExplosions, double _playbackSpeed)
+{
+  Artifact::Reset();
+
   root = this;
   SetLayer(-1000);
   numOfExplosions = _numOfExplosions;
   playbackSpeed = _playbackSpeed;
   count = 0;
-  setTexture(Textures().LoadFromFile(TexturePaths::MOB_EXPLOSION));
+  offset = offsetArea = {};
+  animationComponent = nullptr;
   setScale(2.f, 2.f);
 }
 
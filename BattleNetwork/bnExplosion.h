@@ -38,6 +38,11 @@ public:
   
   ~Explosion();
 
+  /**
+   * @brief Restores the root explosion state when recycled from an EntityPool
+   */
+  void Reset(int _numOfExplosions = 1, double _playbackSpeed = 0.55);
+
   void Init() override;
 
   /**
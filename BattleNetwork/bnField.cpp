@@ -5,6 +5,7 @@
 #include "bnArtifact.h"
 #include "bnTile.h"
 #include "bnTextureResourceManager.h"
+#include "bnProfiler.h"
 #include "battlescene/bnBattleSceneBase.h"
 
 constexpr auto TILE_ANIMATION_PATH = "resources/tiles/tiles.animation";
@@ -91,96 +92,208 @@ int Field::GetHeight() const {
 
 Field::NotifyID_t Field::CallbackOnDelete(Entity::ID_t target, const std::function<void(std::shared_ptr<Entity>)>& callback)
 {
-  auto iter = entityDeleteObservers.find(target);
-  Field::NotifyID_t ID = nextID;
-  nextID++;
+  NotifyID_t ID = AllocDeleteObserver(target);
+  GetDeleteObserver(ID)->callback1 = callback;
+  return ID;
+}
+
+Field::NotifyID_t Field::NotifyOnDelete(
+  Entity::ID_t target,
+  Entity::ID_t observer,
+  const std::function<void(std::shared_ptr<Entity>, std::shared_ptr<Entity>)>& callback
+) {
+  NotifyID_t ID = AllocDeleteObserver(target);
+  DeleteObserver* dobs = GetDeleteObserver(ID);
+  dobs->observer = observer;
+  dobs->callback2 = callback;
+  return ID;
+}
 
-  if (iter != entityDeleteObservers.end()) {
-    DeleteObserver dobs;
-    dobs.ID = ID;
-    dobs.callback1 = callback;
-    iter->second.emplace_back(std::move(dobs));
+void Field::DropNotifier(NotifyID_t notifier)
+{
+  if (GetDeleteObserver(notifier)) {
+    int index = static_cast<int>(notifier & 0xFFFFFFFF);
+    UnlinkDeleteObserver(index);
+    FreeDeleteObserver(index);
+  }
+}
+
+Field::NotifyID_t Field::AllocDeleteObserver(Entity::ID_t target)
+{
+  int index = 0;
+
+  if (freeDeleteObservers.size()) {
+    index = freeDeleteObservers.back();
+    freeDeleteObservers.pop_back();
   }
   else {
-    // We do not have a bucket for this target entity
-    entityDeleteObservers.insert(std::make_pair(target, std::vector<DeleteObserver>()));
+    index = static_cast<int>(deleteObservers.size());
+    deleteObservers.emplace_back();
+  }
+
+  DeleteObserver& dobs = deleteObservers[index];
+  dobs.generation++;
+  dobs.inUse = true;
+  dobs.target = target;
 
-    DeleteObserver dobs;
-    dobs.ID = ID;
-    dobs.callback1 = callback;
-    entityDeleteObservers[target].emplace_back(std::move(dobs));
+  NotifyID_t ID = (static_cast<NotifyID_t>(dobs.generation) << 32) | static_cast<NotifyID_t>(index);
+
+  auto entityIter = allEntityHash.find(target);
+
+  if (entityIter != allEntityHash.end() && entityIter->second) {
+    LinkDeleteObserver(index, *entityIter->second);
+  }
+  else {
+    // Entities can be observed before they are added to the field
+    unlinkedDeleteObservers.emplace(target, index);
   }
 
-  notify2TargetHash.insert(std::make_pair(ID, target));
   return ID;
 }
 
-Field::NotifyID_t Field::NotifyOnDelete(
-  Entity::ID_t target,
-  Entity::ID_t observer,
-  const std::function<void(std::shared_ptr<Entity>, std::shared_ptr<Entity>)>& callback
-) {
-  auto iter = entityDeleteObservers.find(target);
-  NotifyID_t ID = {};
+Field::DeleteObserver* Field::GetDeleteObserver(NotifyID_t ID)
+{
+  if (ID < 0) return nullptr;
+
+  size_t index = static_cast<size_t>(ID & 0xFFFFFFFF);
+  uint32_t generation = static_cast<uint32_t>(ID >> 32);
+
+  if (index >= deleteObservers.size()) return nullptr;
+
+  DeleteObserver& dobs = deleteObservers[index];
+
+  if (!dobs.inUse || dobs.generation != generation) return nullptr;
+
+  return &dobs;
+}
+
+void Field::LinkDeleteObserver(int index, Entity& target)
+{
+  DeleteObserver& dobs = deleteObservers[index];
+  dobs.owner = &target;
+  dobs.prev = -1;
+  dobs.next = target.firstDeleteObserver;
+
+  if (dobs.next > -1) {
+    deleteObservers[dobs.next].prev = index;
+  }
+
+  target.firstDeleteObserver = index;
+}
+
+void Field::UnlinkDeleteObserver(int index)
+{
+  DeleteObserver& dobs = deleteObservers[index];
 
-  if (iter != entityDeleteObservers.end()) {
-    for (auto& elem : iter->second) {
-      if (elem.observer == observer) {
-        ID = elem.ID;
+  if (!dobs.owner) {
+    // may still be waiting for its target to spawn
+    auto [first, last] = unlinkedDeleteObservers.equal_range(dobs.target);
+
+    for (auto iter = first; iter != last; iter++) {
+      if (iter->second == index) {
+        unlinkedDeleteObservers.erase(iter);
         break;
       }
     }
 
-    // If we reached this line, we did not find a matching observer
-    // Add one
-    ID = nextID;
-    nextID++;
-    DeleteObserver dobs;
-    dobs.ID = ID;
-    dobs.observer = observer;
-    dobs.callback2 = callback;
-    iter->second.emplace_back(std::move(dobs));
+    return;
+  }
+
+  if (dobs.prev > -1) {
+    deleteObservers[dobs.prev].next = dobs.next;
   }
   else {
-    // We do not have a bucket for this target entity
-    entityDeleteObservers.insert(std::make_pair(target, std::vector<DeleteObserver>()));
+    dobs.owner->firstDeleteObserver = dobs.next;
+  }
 
-    DeleteObserver dobs;
-    dobs.ID = nextID;
-    dobs.observer = observer;
-    dobs.callback2 = callback;
-    entityDeleteObservers[target].emplace_back(std::move(dobs));
-    ID = nextID;
-    nextID++;
+  if (dobs.next > -1) {
+    deleteObservers[dobs.next].prev = dobs.prev;
+  }
 
-    // add notify ID lookup for this target
-    notify2TargetHash.insert(std::make_pair(ID, target));
+  dobs.owner = nullptr;
+  dobs.prev = dobs.next = -1;
+}
+
+void Field::FreeDeleteObserver(int index)
+{
+  DeleteObserver& dobs = deleteObservers[index];
+  dobs.inUse = false;
+  dobs.owner = nullptr;
+  dobs.prev = dobs.next = -1;
+  dobs.observer.reset();
+  dobs.callback1 = nullptr;
+  dobs.callback2 = nullptr;
+  freeDeleteObservers.push_back(index);
+}
+
+void Field::QueueDeleteNotifications(const std::shared_ptr<Entity>& target)
+{
+  // Observers were linked newest first, queue them in the order they were added
+  int index = target->firstDeleteObserver;
+  int last = -1;
+
+  while (index > -1) {
+    last = index;
+    index = deleteObservers[index].next;
   }
 
-  return ID;
+  for (index = last; index > -1; index = deleteObservers[index].prev) {
+    DeleteObserver& dobs = deleteObservers[index];
+    NotifyID_t ID = (static_cast<NotifyID_t>(dobs.generation) << 32) | static_cast<NotifyID_t>(index);
+    deleteNotifications.push_back(DeleteNotification{ target, ID });
+    dobs.owner = nullptr;
+  }
+
+  target->firstDeleteObserver = -1;
 }
 
-void Field::DropNotifier(NotifyID_t notifier)
+void Field::DispatchDeleteNotifications()
 {
-  auto iter = notify2TargetHash.find(notifier);
-  if (iter != notify2TargetHash.end()) {
-    Entity::ID_t targetID = iter->second;
-    auto listIter = entityDeleteObservers.find(targetID);
+  if (isDispatchingDeletes) return;
 
-    if (listIter != entityDeleteObservers.end()) {
-      for (auto deleteIter = listIter->second.begin(); deleteIter != listIter->second.end(); deleteIter++) {
-        if (deleteIter->ID == notifier) {
-          listIter->second.erase(deleteIter);
+  isDispatchingDeletes = true;
 
-          if (listIter->second.empty()) {
-            entityDeleteObservers.erase(listIter);
-            notify2TargetHash.erase(notifier);
-          }
-          return;
-        }
+  // Callbacks may forget more entities and grow this list while we step through it
+  for (size_t i = 0; i < deleteNotifications.size(); i++) {
+    DeleteNotification notification = deleteNotifications[i];
+    DeleteObserver* dobs = GetDeleteObserver(notification.ID);
+    std::shared_ptr<Entity> target = notification.target.lock();
+
+    // Dropped before we reached it
+    if (!dobs || !target) continue;
+
+    std::optional<Entity::ID_t> observerID = dobs->observer;
+    auto callback1 = std::move(dobs->callback1);
+    auto callback2 = std::move(dobs->callback2);
+
+    // Free first, the callbacks may add observers and resize the slab
+    FreeDeleteObserver(static_cast<int>(notification.ID & 0xFFFFFFFF));
+
+    if (observerID.has_value()) {
+      auto observerIter = allEntityHash.find(observerID.value());
+
+      if (observerIter != allEntityHash.end() && observerIter->second && callback2) {
+        callback2(target, observerIter->second);
       }
     }
+    else if (callback1) {
+      callback1(target);
+    }
   }
+
+  deleteNotifications.clear();
+
+  // Nothing refers to these entities anymore so pooled ones can be reused
+  vector<std::shared_ptr<Entity>> released;
+  released.swap(forgottenEntities);
+
+  for (std::shared_ptr<Entity>& entity : released) {
+    if (entity->IsPooled()) {
+      ReclaimEntity(std::move(entity));
+    }
+  }
+
+  isDispatchingDeletes = false;
 }
 
 std::vector<Battle::Tile*> Field::FindTiles(std::function<bool(Battle::Tile* t)> query)
@@ -221,6 +334,15 @@ Field::AddEntityStatus Field::AddEntity(std::shared_ptr<Entity> entity, int x, i
     tile->AddEntity(entity);
     allEntityHash.insert(std::make_pair(entity->GetID(), entity));
 
+    // Attach any observers that were waiting for this entity, in the order they were added
+    auto [first, last] = unlinkedDeleteObservers.equal_range(entity->GetID());
+
+    for (auto iter = first; iter != last; iter++) {
+      LinkDeleteObserver(iter->second, *entity);
+    }
+
+    unlinkedDeleteObservers.erase(first, last);
+
     // TODO: HACK. Stop dynamic casting and use a hash of some kind
     std::shared_ptr<Character> character = std::dynamic_pointer_cast<Character>(entity);
     std::shared_ptr<Obstacle> obstacle = std::dynamic_pointer_cast<Obstacle>(entity);
@@ -329,40 +451,84 @@ Battle::Tile* Field::GetAt(int _x, int _y) const {
 }
 
 void Field::Update(double _elapsed) {
+  BN_PROFILE_ZONE("Field::Update");
+
   // This is a state flag that decides if entities added this update tick will be
   // put into a pending queue bucket or added directly onto the field
   isUpdating = true;
 
   int entityCount = 0;
 
-  for (int i = 0; i < tiles.size(); i++) {
-    for (int j = 0; j < tiles[i].size(); j++) {
-      tiles[i][j]->PrepareNextFrame(*this);
-      tiles[i][j]->UpdateSpells(*this, _elapsed);
+  {
+    // Each tile is prepared right before its spells update, so the two steps
+    // stay interleaved and get a zone each per tile
+    BN_PROFILE_ZONE("Tile::PrepareAndUpdateSpells");
+    for (int i = 0; i < tiles.size(); i++) {
+      for (int j = 0; j < tiles[i].size(); j++) {
+        {
+          BN_PROFILE_ZONE("Tile::PrepareNextFrame");
+          tiles[i][j]->PrepareNextFrame(*this);
+        }
+
+        {
+          BN_PROFILE_ZONE("Tile::UpdateSpells");
+          tiles[i][j]->UpdateSpells(*this, _elapsed);
+        }
+      }
     }
   }
 
-  for (int i = 0; i < tiles.size(); i++) {
-    for (int j = 0; j < tiles[i].size(); j++) {
-      tiles[i][j]->ExecuteAllAttacks(*this);
+  {
+    BN_PROFILE_ZONE("Tile::ExecuteAllAttacks");
+    for (int i = 0; i < tiles.size(); i++) {
+      for (int j = 0; j < tiles[i].size(); j++) {
+        tiles[i][j]->ExecuteAllAttacks(*this);
+      }
     }
   }
 
-  for (int i = 0; i < tiles.size(); i++) {
-    for (int j = 0; j < tiles[i].size(); j++) {
-      tiles[i][j]->UpdateArtifacts(*this, _elapsed);
+  {
+    BN_PROFILE_ZONE("Tile::UpdateArtifacts");
+    for (int i = 0; i < tiles.size(); i++) {
+      for (int j = 0; j < tiles[i].size(); j++) {
+        tiles[i][j]->UpdateArtifacts(*this, _elapsed);
+      }
     }
   }
 
-  for (int i = 0; i < tiles.size(); i++) {
-    for (int j = 0; j < tiles[i].size(); j++) {
-      tiles[i][j]->Update(*this, _elapsed);
+  {
+    BN_PROFILE_ZONE("Tile::UpdateLocal");
+
+    // Only tile-local state changes here. Anything that affects the field is
+    // queued on the tile and applied by Tile::Update() below in tile order
+    // so the result is the same no matter how the jobs were scheduled.
+    tileOrder.clear();
+    for (int i = 0; i < tiles.size(); i++) {
+      for (int j = 0; j < tiles[i].size(); j++) {
+        tileOrder.push_back(tiles[i][j]);
+      }
     }
+
+    JobSystem::Shared().ParallelFor(tileOrder.size(), BN_FIELD_TILE_JOB_GRAIN, [this, _elapsed](size_t index) {
+      tileOrder[index]->UpdateLocal(_elapsed);
+    });
   }
 
-  for (int i = 0; i < tiles.size(); i++) {
-    for (int j = 0; j < tiles[i].size(); j++) {
-      tiles[i][j]->UpdateCharacters(*this, _elapsed);
+  {
+    BN_PROFILE_ZONE("Tile::Update");
+    for (int i = 0; i < tiles.size(); i++) {
+      for (int j = 0; j < tiles[i].size(); j++) {
+        tiles[i][j]->Update(*this, _elapsed);
+      }
+    }
+  }
+
+  {
+    BN_PROFILE_ZONE("Tile::UpdateCharacters");
+    for (int i = 0; i < tiles.size(); i++) {
+      for (int j = 0; j < tiles[i].size(); j++) {
+        tiles[i][j]->UpdateCharacters(*this, _elapsed);
+      }
     }
   }
 
@@ -505,6 +671,8 @@ void Field::Update(double _elapsed) {
     combatEvaluationIteration--;
   }
 
+  DispatchDeleteNotifications();
+
   updatedEntities.clear();
 }
 
@@ -542,6 +710,28 @@ void Field::RequestBattleStop()
       tiles[i][j]->BattleStop();
     }
   }
+
+  DropUnspawnedDeleteObservers();
+}
+
+void Field::DropUnspawnedDeleteObservers()
+{
+  std::set<Entity::ID_t> queued;
+
+  for (const queueBucket& bucket : pending) {
+    queued.insert(bucket.ID);
+  }
+
+  for (auto iter = unlinkedDeleteObservers.begin(); iter != unlinkedDeleteObservers.end();) {
+    if (queued.count(iter->first)) {
+      iter++;
+      continue;
+    }
+
+    // the notifier ID handed out for this slot stops resolving once it is freed
+    FreeDeleteObserver(iter->second);
+    iter = unlinkedDeleteObservers.erase(iter);
+  }
 }
 
 void Field::TileRequestsRemovalOfQueued(Battle::Tile* tile, Entity::ID_t ID)
@@ -589,33 +779,26 @@ void Field::UpdateEntityOnce(Entity& entity, const double elapsed)
 
 void Field::ForgetEntity(Entity::ID_t ID)
 {
+  std::shared_ptr<Entity> target;
+
   auto entityIter = allEntityHash.find(ID);
   if (entityIter != allEntityHash.end()) {
-    std::shared_ptr<Entity> target = entityIter->second;
-
-    auto deleteIter = entityDeleteObservers.find(ID);
-
-    if (deleteIter != entityDeleteObservers.end()) {
-      auto& deleteObservers = deleteIter->second;
-
-      for (auto& d : deleteObservers) {
-        if (d.observer.has_value()) {
-          if (std::shared_ptr<Entity> observer = this->GetEntity(d.observer.value())) {
-            d.callback2(target, observer);
-          }
-        }
-        else {
-          d.callback1(target);
-        }
-      }
-    }
+    target = entityIter->second;
+  }
 
+  if (target) {
+    // Delete observers are notified in one batch at the end of the frame
+    QueueDeleteNotifications(target);
     target->Cleanup();
+    forgottenEntities.push_back(std::move(target));
   }
 
   allEntityHash.erase(ID);
-  entityDeleteObservers.erase(ID);
   ClearAllReservations(ID);
+
+  if (!isUpdating) {
+    DispatchDeleteNotifications();
+  }
 }
 
 void Field::DeallocEntity(Entity::ID_t ID)
@@ -623,12 +806,25 @@ void Field::DeallocEntity(Entity::ID_t ID)
   auto iter = allEntityHash.find(ID);
 
   if (iter != allEntityHash.end()) {
-    std::shared_ptr<Entity>& entity = iter->second;
-    entity->GetTile()->RemoveEntityByID(ID);
+    // ForgetEntity() erases this entry and may recycle a pooled entity
+    if (Battle::Tile* tile = iter->second->GetTile()) {
+      tile->RemoveEntityByID(ID);
+    }
+
     ForgetEntity(ID);
   }
 }
 
+void Field::ReclaimEntity(std::shared_ptr<Entity> entity)
+{
+  auto iter = pools.find(std::type_index(typeid(*entity)));
+
+  if (iter == pools.end()) return;
+
+  // If the pool declines, the last reference is dropped here and the entity is freed
+  iter->second->Reclaim(std::move(entity));
+}
+
 std::shared_ptr<Entity> Field::GetEntity(Entity::ID_t ID)
 {
   return allEntityHash[ID];
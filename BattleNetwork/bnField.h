@@ -1,6 +1,10 @@
 #pragma once
 #include <vector>
 #include <map>
+#include <memory>
+#include <typeindex>
+#include <optional>
+#include <cstdint>
 using std::map;
 using std::vector;
 
@@ -8,6 +12,8 @@ using std::vector;
 #include "bindings/bnScriptedSpell.h"
 #include "bindings/bnScriptedObstacle.h"
 #include "bnEntity.h"
+#include "bnEntityPool.h"
+#include "bnJobSystem.h"
 #include "bnCharacterDeletePublisher.h"
 #include "bnCharacterSpawnPublisher.h"
 
@@ -22,6 +28,7 @@ namespace Battle {
 }
 
 #define BN_MAX_COMBAT_EVALUATION_STEPS 20
+#define BN_FIELD_TILE_JOB_GRAIN 8 /*!< Tiles per job in Field::Update(). Raise past the tile count to update tiles serially */
 
 class Field : public std::enable_shared_from_this<Field>, public CharacterDeletePublisher, public CharacterSpawnPublisher{
 public:
@@ -62,19 +69,42 @@ public:
    */
   int GetHeight() const;
 
+  /**
+   * @brief Invokes the callback at the end of the frame the target is removed from the field
+   * @param target ID of the entity to watch. It does not need to be on the field yet.
+   * @return handle that can be passed to DropNotifier()
+   */
   NotifyID_t CallbackOnDelete(
     Entity::ID_t target,
     const std::function<void(std::shared_ptr<Entity>)>& callback
   );
 
+  /**
+   * @brief Same as CallbackOnDelete() but only invoked if the observer is still on the field
+   * @return handle that can be passed to DropNotifier()
+   */
   NotifyID_t NotifyOnDelete(
     Entity::ID_t target,
     Entity::ID_t observer,
     const std::function<void(std::shared_ptr<Entity>, std::shared_ptr<Entity>)>& callback
   );
 
+  /**
+   * @brief Unlinks a delete observer in constant time. Stale or invalid handles are ignored.
+   */
   void DropNotifier(NotifyID_t notifier);
 
+  /**
+   * @brief Creates a short-lived entity from this field's pool for type T
+   * @param args forwarded to T's constructor or T::Reset() if recycled
+   * @return entity ready to be added to the field
+   *
+   * The entity is returned to the pool when it is erased from the field.
+   * @warning Do not use for entities that are exposed to scripts. @see EntityPool
+   */
+  template<typename T, typename... Args>
+  std::shared_ptr<T> AllocEntity(Args&&... args);
+
   /**
    * @brief Query for tiles that pass the input function
    * @param query input function, returns true or false based on conditions
@@ -240,19 +270,74 @@ private:
     queueBucket(const queueBucket& rhs) = default;
   };
 
+  // Delete observers live in a slab owned by the field and are linked into
+  // an intrusive list whose head is stored on the target entity.
+  // Notify IDs encode the slab slot and its generation so stale handles are harmless.
   struct DeleteObserver {
-    NotifyID_t ID{};
+    uint32_t generation{};
+    bool inUse{};
+    int prev{ -1 }, next{ -1 }; /*!< Siblings watching the same target */
+    Entity::ID_t target{};
+    Entity* owner{ nullptr }; /*!< Target entity this node is linked to, if any */
     std::optional<Entity::ID_t> observer;
     std::function<void(std::shared_ptr<Entity>)> callback1; // target only variant
     std::function<void(std::shared_ptr<Entity>, std::shared_ptr<Entity>)> callback2; // target-observer variant
   };
 
-  NotifyID_t nextID{};
+  struct DeleteNotification {
+    std::weak_ptr<Entity> target; /*!< Kept alive by forgottenEntities until dispatched */
+    NotifyID_t ID{};
+  };
+
+  bool isDispatchingDeletes{}; /*!< Callbacks can forget more entities while dispatching */
 
   map<Entity::ID_t, std::shared_ptr<Entity>> allEntityHash; /*!< Quick lookup of entities on the field */
   map<Entity::ID_t, void*> updatedEntities; /*!< Since entities can be shared across tiles, prevent multiple updates*/
-  map<Entity::ID_t, std::vector<DeleteObserver>> entityDeleteObservers; /*!< List of callback functions for when an entity is deleted*/
-  map<NotifyID_t, Entity::ID_t> notify2TargetHash; /*!< Convert from target entity to its delete observer key*/
+  vector<DeleteObserver> deleteObservers; /*!< Slab of all delete observer nodes */
+  vector<int> freeDeleteObservers; /*!< Recycled slots in deleteObservers */
+  std::multimap<Entity::ID_t, int> unlinkedDeleteObservers; /*!< Observers waiting for their target to be added to the field, by target */
+  vector<DeleteNotification> deleteNotifications; /*!< Batched callbacks dispatched at the end of the frame */
+  vector<std::shared_ptr<Entity>> forgottenEntities; /*!< Erased entities held until their delete callbacks run, then pooled ones are reclaimed */
+  map<std::type_index, std::unique_ptr<EntityPoolBase>> pools; /*!< Recycled entities for the lifetime of the battle */
   vector<queueBucket> pending;
+  vector<Battle::Tile*> tileOrder; /*!< Every tile in update order for jobs to index into */
   vector<vector<Battle::Tile*>> tiles; /*!< Nested vector to make calls via tiles[x][y] */
-};
\ No newline at end of file
+
+  /**
+  * @brief returns an erased pooled entity back to the pool it was allocated from
+  */
+  void ReclaimEntity(std::shared_ptr<Entity> entity);
+
+  NotifyID_t AllocDeleteObserver(Entity::ID_t target);
+  DeleteObserver* GetDeleteObserver(NotifyID_t ID);
+  void LinkDeleteObserver(int index, Entity& target);
+  void UnlinkDeleteObserver(int index);
+  void FreeDeleteObserver(int index);
+
+  /**
+  * @brief Moves all observers linked to the entity into the end-of-frame batch
+  */
+  void QueueDeleteNotifications(const std::shared_ptr<Entity>& target);
+
+  /**
+  * @brief Invokes the batched delete callbacks in the order they were queued then releases forgotten entities
+  */
+  void DispatchDeleteNotifications();
+
+  /**
+  * @brief Frees observers whose target was never added to the field and is not queued to be
+  */
+  void DropUnspawnedDeleteObservers();
+};
+
+template<typename T, typename... Args>
+std::shared_ptr<T> Field::AllocEntity(Args&&... args)
+{
+  std::unique_ptr<EntityPoolBase>& pool = pools[std::type_index(typeid(T))];
+
+  if (!pool) {
+    pool = std::make_unique<EntityPool<T>>();
+  }
+
+  return static_cast<EntityPool<T>*>(pool.get())->Acquire(std::forward<Args>(args)...);
+}
\ No newline at end of file
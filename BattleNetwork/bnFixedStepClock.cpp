@@ -0,0 +1,46 @@
+#include "bnFixedStepClock.h"
+#include <algorithm>
+
+FixedStepClock::FixedStepClock(double step, unsigned maxTicksPerFrame) :
+  step(step),
+  accumulator(step), // the first render is always preceded by a tick
+  maxTicksPerFrame(std::max(maxTicksPerFrame, 1u))
+{
+}
+
+unsigned FixedStepClock::Advance(double seconds)
+{
+  accumulator += std::max(seconds, 0.0);
+
+  // Frame times jitter around the display rate. Count a nearly full step as a
+  // tick and carry the small debt so 60Hz renders do not alternate 0 and 2 ticks.
+  const double slack = step * 0.02;
+  unsigned count = static_cast<unsigned>((accumulator + slack) / step);
+
+  if (count > maxTicksPerFrame) {
+    // Too far behind to catch up, drop the backlog
+    count = maxTicksPerFrame;
+    accumulator = 0.0;
+  }
+  else {
+    accumulator -= count * step;
+  }
+
+  ticks += count;
+  return count;
+}
+
+float FixedStepClock::Alpha() const
+{
+  return static_cast<float>(std::clamp(accumulator / step, 0.0, 1.0));
+}
+
+uint64_t FixedStepClock::Ticks() const
+{
+  return ticks;
+}
+
+double FixedStepClock::Step() const
+{
+  return step;
+}
@@ -0,0 +1,46 @@
+/*! \brief Decides how many fixed simulation ticks to run for each rendered frame
+ *
+ * Real time between rendered frames is added to an accumulator and spent in
+ * whole ticks of `step` seconds. A fast display renders some frames without
+ * ticking and a slow machine runs several ticks before the next render, so
+ * the game runs at the same speed everywhere. Each tick is exactly one logical
+ * frame which keeps PVP lockstep intact.
+ *
+ * When the machine cannot keep up, at most `maxTicksPerFrame` ticks run per
+ * render and the rest of the backlog is dropped so the game slows down
+ * instead of spiraling.
+ *
+ * Alpha() is how far the renderer is between the last tick and the next one
+ * and can be used to interpolate positions for smoother motion.
+ */
+
+#pragma once
+#include <cstdint>
+
+class FixedStepClock {
+  double step{};
+  double accumulator{};
+  unsigned maxTicksPerFrame{};
+  uint64_t ticks{};
+
+public:
+  FixedStepClock(double step, unsigned maxTicksPerFrame = 5);
+
+  /**
+   * @brief Adds real time and returns the number of ticks to run before the next render
+   * @param seconds real time since the last call
+   */
+  unsigned Advance(double seconds);
+
+  /**
+   * @brief Fraction of a tick that has passed since the last tick in [0, 1)
+   */
+  float Alpha() const;
+
+  /**
+   * @brief Total ticks handed out since construction
+   */
+  uint64_t Ticks() const;
+
+  double Step() const;
+};
@@ -19,10 +19,10 @@ FolderChangeNameScene::FolderChangeNameScene(ActivityController& controller, std
 
   leave = true;
   // folder menu graphic
-  bg = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_CHANGE_NAME_BG));
+  bg = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_CHANGE_NAME_BG));
   bg.setScale(2.f, 2.f);
 
-  cursorPieceLeft = sf::Sprite(*Textures().LoadFromFile(TexturePaths::LETTER_CURSOR));
+  cursorPieceLeft = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::LETTER_CURSOR));
   cursorPieceLeft.setScale(2.f, 2.f);
   cursorPieceLeft.setPosition(12 * 2.f, 58 * 2.f);
 
@@ -69,21 +69,21 @@ FolderEditScene::FolderEditScene(swoosh::ActivityController& controller, CardFol
   cardDesc.setScale(2.f, 2.f);
 
   // folder menu graphic
-  bg = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_VIEW_BG));
+  bg = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_VIEW_BG));
   bg.setScale(2.f, 2.f);
 
-  folderDock = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_DOCK));
+  folderDock = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_DOCK));
   folderDock.setScale(2.f, 2.f);
   folderDock.setPosition(2.f, 30.f);
 
-  packDock = sf::Sprite(*Textures().LoadFromFile(TexturePaths::PACK_DOCK));
+  packDock = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::PACK_DOCK));
   packDock.setScale(2.f, 2.f);
   packDock.setPosition(480.f, 30.f);
 
-  scrollbar = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_SCROLLBAR));
+  scrollbar = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_SCROLLBAR));
   scrollbar.setScale(2.f, 2.f);
 
-  folderCursor = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_CURSOR));
+  folderCursor = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_CURSOR));
   folderCursor.setScale(2.f, 2.f);
   folderCursor.setPosition((2.f * 90.f), 64.0f);
   folderSwapCursor = folderCursor;
@@ -92,24 +92,24 @@ FolderEditScene::FolderEditScene(swoosh::ActivityController& controller, CardFol
   packCursor.setPosition((2.f * 90.f) + 480.0f, 64.0f);
   packSwapCursor = packCursor;
 
-  folderNextArrow = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_NEXT_ARROW));
+  folderNextArrow = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_NEXT_ARROW));
   folderNextArrow.setScale(2.f, 2.f);
 
   packNextArrow = folderNextArrow;
   packNextArrow.setScale(-2.f, 2.f);
 
-  folderCardCountBox = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_SIZE));
+  folderCardCountBox = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_SIZE));
   folderCardCountBox.setPosition(sf::Vector2f(425.f, 10.f + folderCardCountBox.getLocalBounds().height));
   folderCardCountBox.setScale(2.f, 2.f);
   folderCardCountBox.setOrigin(folderCardCountBox.getLocalBounds().width / 2.0f, folderCardCountBox.getLocalBounds().height / 2.0f);
 
-  cardHolder = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER));
+  cardHolder = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_CHIP_HOLDER));
   cardHolder.setScale(2.f, 2.f);
 
-  packCardHolder = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER));
+  packCardHolder = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_CHIP_HOLDER));
   packCardHolder.setScale(2.f, 2.f);
 
-  element = sf::Sprite(*Textures().LoadFromFile(TexturePaths::ELEMENT_ICON));
+  element = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::ELEMENT_ICON));
   element.setScale(2.f, 2.f);
 
   // Current card graphic
@@ -732,7 +732,9 @@ void FolderEditScene::DrawFolder(sf::RenderTarget& surface) {
       }
 
       float cardIconY = 66.0f + (32.f * i);
-      cardIcon.setTexture(*GetIconForCard(copy.GetUUID()));
+      const TextureRegion icon = GetIconForCard(copy.GetUUID());
+      cardIcon.setTexture(*icon.texture);
+      cardIcon.setTextureRect(icon.rect);
       cardIcon.setPosition(2.f * 104.f, cardIconY);
       surface.draw(cardIcon);
 
@@ -862,7 +864,9 @@ void FolderEditScene::DrawPool(sf::RenderTarget& surface) {
     int count = iter->GetCount();
     const Battle::Card& copy = iter->ViewCard();
 
-    cardIcon.setTexture(*GetIconForCard(copy.GetUUID()));
+    const TextureRegion icon = GetIconForCard(copy.GetUUID());
+    cardIcon.setTexture(*icon.texture);
+    cardIcon.setTextureRect(icon.rect);
     cardIcon.setPosition(16.f + 480.f, 65.0f + (32.f * i));
     cardIcon.setScale(2.f, 2.f);
     surface.draw(cardIcon);
@@ -1031,15 +1035,15 @@ void FolderEditScene::WriteNewFolderData()
   }
 }
 
-std::shared_ptr<sf::Texture> FolderEditScene::GetIconForCard(const std::string& uuid)
+TextureRegion FolderEditScene::GetIconForCard(const std::string& uuid)
 {
   auto& packageManager = getController().CardPackagePartitioner().GetPartition(Game::LocalPartition);
 
   if (!packageManager.HasPackage(uuid))
-    return noIcon;
+    return TextureRegion::Whole(noIcon);
 
   auto& meta = packageManager.FindPackageByID(uuid);
-  return meta.GetIconTexture();
+  return meta.GetIconRegion() ? meta.GetIconRegion() : TextureRegion::Whole(noIcon);
 }
 std::shared_ptr<sf::Texture> FolderEditScene::GetPreviewForCard(const std::string& uuid)
 {
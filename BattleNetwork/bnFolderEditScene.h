@@ -7,6 +7,7 @@
 #include "bnAudioResourceManager.h"
 #include "bnShaderResourceManager.h"
 #include "bnTextureResourceManager.h"
+#include "bnTextureAtlas.h"
 #include "bnGame.h"
 #include "bnAnimation.h"
 #include "bnLanBackground.h"
@@ -172,7 +173,7 @@ private:
   void ShutdownTouchControls();
 #endif
 
-  std::shared_ptr<sf::Texture> GetIconForCard(const std::string& uuid);
+  TextureRegion GetIconForCard(const std::string& uuid);
   std::shared_ptr<sf::Texture> GetPreviewForCard(const std::string& uuid);
 
   void DrawFolder(sf::RenderTarget& surface);
@@ -213,16 +214,16 @@ void FolderEditScene::RefreshCurrentCardDock(FolderEditScene::CardView& view, co
 
       switch (card.GetClass()) {
       case Battle::CardClass::mega:
-        sprite.setTexture(*Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER_MEGA));
+        sprite.setTexture(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_CHIP_HOLDER_MEGA));
         break;
       case Battle::CardClass::giga:
-        sprite.setTexture(*Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER_GIGA));
+        sprite.setTexture(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_CHIP_HOLDER_GIGA));
         break;
       case Battle::CardClass::dark:
-        sprite.setTexture(*Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER_DARK));
+        sprite.setTexture(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_CHIP_HOLDER_DARK));
         break;
       default:
-        sprite.setTexture(*Textures().LoadFromFile(TexturePaths::FOLDER_CHIP_HOLDER));
+        sprite.setTexture(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_CHIP_HOLDER));
       }
     }
   }
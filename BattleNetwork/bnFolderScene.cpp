@@ -63,32 +63,32 @@ FolderScene::FolderScene(swoosh::ActivityController &controller, CardFolderColle
   numberLabel.setPosition(sf::Vector2f(170.f, 28.0f));
 
   // folder menu graphic
-  bg = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_INFO_BG));
+  bg = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_INFO_BG));
   bg.setScale(2.f, 2.f);
 
-  scrollbar = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_SCROLLBAR));
+  scrollbar = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_SCROLLBAR));
   scrollbar.setScale(2.f, 2.f);
   scrollbar.setPosition(410.f, 60.f);
 
-  folderBox = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_BOX));
+  folderBox = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_BOX));
   folderBox.setScale(2.f, 2.f);
 
-  folderDisabled = sf::Sprite(*Textures().LoadFromFile("resources/ui/folder_disabled.png"));
+  folderDisabled = sf::Sprite(*Textures().LoadPinnedFromFile("resources/ui/folder_disabled.png"));
   folderDisabled.setScale(2.f, 2.f);
 
   RefreshOptions();
 
-  folderCursor = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_BOX_CURSOR));
+  folderCursor = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_BOX_CURSOR));
   folderCursor.setScale(2.f, 2.f);
 
-  folderEquip = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_EQUIP));
+  folderEquip = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_EQUIP));
   folderEquip.setScale(2.f, 2.f);
 
-  cursor = sf::Sprite(*Textures().LoadFromFile(TexturePaths::TEXT_BOX_CURSOR));
+  cursor = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::TEXT_BOX_CURSOR));
   cursor.setScale(2.f, 2.f);
   cursor.setPosition(2.0, 155.0f);
 
-  element = sf::Sprite(*Textures().LoadFromFile(TexturePaths::ELEMENT_ICON));
+  element = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::ELEMENT_ICON));
   element.setScale(2.f, 2.f);
   element.setPosition(2.f*25.f, 146.f);
 
@@ -96,7 +96,7 @@ FolderScene::FolderScene(swoosh::ActivityController &controller, CardFolderColle
   cardIcon.setScale(2.f, 2.f);
   cardIcon.setTextureRect(sf::IntRect(0, 0, 14, 14));
 
-  mbPlaceholder = sf::Sprite(*Textures().LoadFromFile(TexturePaths::FOLDER_MB));
+  mbPlaceholder = sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_MB));
   mbPlaceholder.setScale(2.f, 2.f);
 
   equipAnimation = Animation("resources/ui/folder_equip.animation");
@@ -640,12 +640,14 @@ void FolderScene::onDraw(sf::RenderTexture& surface) {
       float cardIconY = 132.0f + (32.f * i);
 
       if (hasID) {
-        cardIcon.setTexture(*packageManager.FindPackageByID(id).GetIconTexture());        
+        const TextureRegion& region = packageManager.FindPackageByID(id).GetIconRegion();
+        cardIcon.setTexture(*region.texture);
+        cardIcon.setTextureRect(region.rect);
         // make the cardLabel white
         cardLabel.SetColor(sf::Color::White);
       }
       else {
-        cardIcon.setTexture(*noIcon);
+        cardIcon.setTexture(*noIcon, true);
 
         // make the cardLabel red
         cardLabel.SetColor(sf::Color::Red);
@@ -731,7 +733,7 @@ void FolderScene::DeleteFolder(std::function<void()> onSuccess)
   questionInterface = new Question("Delete this folder?", onYes, onNo);
 
   textbox.EnqueMessage(
-    sf::Sprite(*Textures().LoadFromFile(TexturePaths::MUG_NAVIGATOR)),
+    sf::Sprite(*Textures().LoadPinnedFromFile(TexturePaths::MUG_NAVIGATOR)),
     "resources/ui/navigator.animation", 
     questionInterface);
 
@@ -741,7 +743,7 @@ void FolderScene::DeleteFolder(std::function<void()> onSuccess)
 void FolderScene::RefreshOptions()
 {
   const bool emptyCollection = collection.GetFolderNames().empty();
-  const std::shared_ptr<sf::Texture> folderOptionsTex = emptyCollection ? Textures().LoadFromFile(TexturePaths::FOLDER_OPTIONS_NEW) : Textures().LoadFromFile(TexturePaths::FOLDER_OPTIONS);
+  const std::shared_ptr<sf::Texture> folderOptionsTex = emptyCollection ? Textures().LoadPinnedFromFile(TexturePaths::FOLDER_OPTIONS_NEW) : Textures().LoadPinnedFromFile(TexturePaths::FOLDER_OPTIONS);
   folderOptions = sf::Sprite(*folderOptionsTex);
   folderOptions.setOrigin(folderOptions.getGlobalBounds().width / 2.0f, folderOptions.getGlobalBounds().height / 2.0f);
 
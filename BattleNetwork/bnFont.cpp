@@ -1,34 +1,82 @@
 #include "bnFont.h"
 
+#include <cctype>
+
 std::map<char, std::string> Font::specialCharLookup;
-std::array<Animation, Font::style_sz> Font::animationArray{};
-bool Font::animationsLoaded = false;
+std::array<Font::GlyphTable, Font::style_sz> Font::glyphTables{};
+std::mutex Font::glyphMutex;
+bool Font::glyphsBaked = false;
 
 Font::Font(const Style& style) :
   style(style),
   letter('A')
 {
-  if (!Font::animationsLoaded) {
-    Font::animationArray.fill(Animation("resources/fonts/fonts_compressed.animation"));
+  BakeGlyphs();
 
-    for (auto& a : animationArray) {
-      a.Load();
-    }
+  glyphs = &glyphTables[static_cast<size_t>(style)];
 
-    Font::animationsLoaded = true;
+  const Glyph& glyph = GetGlyph(letter);
+  texcoords = letterATexcoords = glyph.texcoords;
+  origin = glyph.origin;
+}
+
+Font::~Font()
+{
+}
+
+void Font::BakeGlyphs()
+{
+  std::scoped_lock lock(glyphMutex);
+
+  if (glyphsBaked) return;
+
+  Animation animation("resources/fonts/fonts_compressed.animation");
+
+  for (size_t i = 0; i < style_sz; i++) {
+    for (int c = 0; c < 256; c++) {
+      glyphTables[i][c] = BakeGlyph(animation, static_cast<Style>(i), static_cast<char>(c));
+    }
   }
 
-  ApplyStyle();
-  letterATexcoords = texcoords;
+  glyphsBaked = true;
 }
 
-Font::~Font()
+void Font::AddSpecialChar(char letter, const std::string& animationName)
+{
+  BakeGlyphs();
+
+  std::scoped_lock lock(glyphMutex);
+  specialCharLookup[letter] = animationName;
+
+  Animation animation("resources/fonts/fonts_compressed.animation");
+
+  for (size_t i = 0; i < style_sz; i++) {
+    glyphTables[i][static_cast<unsigned char>(letter)] = BakeGlyph(animation, static_cast<Style>(i), letter);
+  }
+}
+
+Font::Glyph Font::BakeGlyph(const Animation& animation, const Style& style, char letter)
 {
+  const FrameList* list = &animation.GetFrameList(GlyphName(style, letter));
+
+  if (list->IsEmpty()) {
+    // If the list is empty (font support not existing), use small letter 'A'
+    list = &animation.GetFrameList("SMALL_A");
+  }
+
+  Glyph glyph;
+
+  if (list->IsEmpty()) return glyph;
+
+  const Frame& frame = list->GetFrame(0);
+  glyph.texcoords = frame.subregion;
+  glyph.origin = frame.origin;
+  glyph.advance = static_cast<float>(frame.subregion.width);
+  return glyph;
 }
 
-void Font::ApplyStyle()
+std::string Font::GlyphName(const Style& style, char letter)
 {
-  auto& animation = animationArray[static_cast<size_t>(style)];
   std::string animName;
 
   switch (style) {
@@ -72,37 +120,24 @@ void Font::ApplyStyle()
 
   // prioritize special char lookup for special font letters (e.g. buttons, symbols, multichar letters)
   if (auto iter = Font::specialCharLookup.find(letter); iter != Font::specialCharLookup.end()) {
-    animName = iter->second;
+    return iter->second;
   }
-  else {
-    // otherwise, compose the font lookup name
-    std::string letterStr(1, letter);
-    std::transform(letterStr.begin(), letterStr.end(), letterStr.begin(), ::toupper);
-
-    if (letter != '"') {
-      // some font cannot be lower-cased
-      if (::islower(letter) && HasLowerCase(style)) {
-        letterStr = "LOWER_" + letterStr;
-      }
-
-      animName = animName + letterStr;
-    }
-    else {
-      animName = animName + "QUOTE";
-    }
+
+  // otherwise, compose the font lookup name
+  const unsigned char code = static_cast<unsigned char>(letter);
+
+  if (letter == '"') {
+    return animName + "QUOTE";
   }
 
-  // Get the frame (list of size 1) of the font
-  FrameList list = animation.GetFrameList(animName);
-  
-  if (list.IsEmpty()) {
-    // If the list is empty (font support not existing), use small letter 'A'
-    list = animation.GetFrameList("SMALL_A");
+  std::string letterStr(1, static_cast<char>(::toupper(code)));
+
+  // some font cannot be lower-cased
+  if (::islower(code) && HasLowerCase(style)) {
+    letterStr = "LOWER_" + letterStr;
   }
-  
-  auto& frame = list.GetFrame(0);
-  texcoords = frame.subregion;
-  origin = frame.origin;
+
+  return animName + letterStr;
 }
 
 const bool Font::HasLowerCase(const Style& style)
@@ -134,11 +169,11 @@ const Font::Style & Font::GetStyle() const
 
 void Font::SetLetter(char letter)
 {
-  auto prev = Font::letter;
   Font::letter = letter;
 
-  if(letter != prev)
-    ApplyStyle();
+  const Glyph& glyph = GetGlyph(letter);
+  texcoords = glyph.texcoords;
+  origin = glyph.origin;
 }
 
 const sf::Texture & Font::GetTexture() const
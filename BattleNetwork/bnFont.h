@@ -6,7 +6,16 @@
 
 #include <memory>
 #include <array>
+#include <mutex>
 
+/**
+ * @class Font
+ * @brief Looks up the texture coordinates of letters in the font atlas
+ *
+ * Every style is baked into a table of 256 glyphs the first time a font is
+ * made so laying out text is an array index per letter. Special characters
+ * must be added with AddSpecialChar() before text that uses them is drawn.
+ */
 class Font : ResourceHandle
 {
 public:
@@ -25,24 +34,48 @@ public:
     size // don't use!
   } style;
 
-  static std::map<char, std::string> specialCharLookup;
+  struct Glyph {
+    sf::IntRect texcoords{};
+    sf::Vector2f origin{};
+    float advance{}; /*!< Width of the letter before letter spacing */
+  };
+
+  using GlyphTable = std::array<Glyph, 256>;
 
 private:
   static constexpr size_t style_sz = static_cast<size_t>(Style::size);
-  static bool animationsLoaded;
-  static std::array<Animation, style_sz> animationArray;
+  static std::mutex glyphMutex;
+  static bool glyphsBaked;
+  static std::array<GlyphTable, style_sz> glyphTables;
+  static std::map<char, std::string> specialCharLookup;
 
+  const GlyphTable* glyphs{ nullptr };
   char letter{ 'A' };
   sf::IntRect texcoords{};
   sf::IntRect letterATexcoords{};
   sf::Vector2f origin{};
-  void ApplyStyle();
-  const bool HasLowerCase(const Style& style);
+  static const bool HasLowerCase(const Style& style);
+  static std::string GlyphName(const Style& style, char letter);
+  static Glyph BakeGlyph(const Animation& animation, const Style& style, char letter);
+  static void BakeGlyphs();
 public:
   Font(const Style& style);
   ~Font();
 
+  /**
+   * @brief Maps a character to an animation state in the font file for every style
+   */
+  static void AddSpecialChar(char letter, const std::string& animationName);
+
   const Style& GetStyle() const;
+
+  /**
+   * @brief Glyph for a letter in this font's style
+   */
+  const Glyph& GetGlyph(char letter) const {
+    return (*glyphs)[static_cast<unsigned char>(letter)];
+  }
+
   void SetLetter(char letter);
   const sf::Texture& GetTexture() const;
   const sf::IntRect GetTextureCoords() const;
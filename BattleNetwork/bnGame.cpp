@@ -1,6 +1,7 @@
 #include <time.h>
 #include <queue>
 #include <atomic>
+#include <algorithm>
 #include <cmath>
 #include <Swoosh/ActivityController.h>
 #include <Swoosh/Ease.h>
@@ -16,6 +17,7 @@
 #include "bnInputHandle.h"
 #include "bnRandom.h"
 #include "overworld/bnOverworldHomepage.h"
+#include "overworld/bnOverworldSprite.h"
 #include "SFML/System.hpp"
 
 #ifdef BN_MOD_SUPPORT
@@ -29,6 +31,7 @@
 #endif
 
 #include "bnPackageManager.h"
+#include "bnPackageFingerprintCache.h"
 #include "bnPlayerPackageManager.h"
 #include "bnCardPackageManager.h"
 #include "bnMobPackageManager.h"
@@ -117,6 +120,12 @@ Game::~Game() {
     recordOutThread.join();
   }
 
+  StopReplay();
+
+  if (profilePath.size()) {
+    Profiler::ExportChromeTrace(profilePath);
+  }
+
   delete session;
 
 #ifdef BN_MOD_SUPPORT
@@ -161,12 +170,24 @@ void Game::SetCommandLineValues(const cxxopts::ParseResult& values) {
   if (maxPayloadSize != 0) {
     netManager.SetMaxPayloadSize(maxPayloadSize);
   }
+
+  const size_t megabyte = 1024u * 1024u;
+  textureManager.SetCacheBudget(static_cast<size_t>(std::max(CommandLineValue<int>("texture-budget"), 0)) * megabyte);
+  audioManager.SetCacheBudget(static_cast<size_t>(std::max(CommandLineValue<int>("audio-budget"), 0)) * megabyte);
+
+  PackageFingerprintCache::Instance().SetRebuild(CommandLineValue<bool>("rebuild-package-cache"));
 }
 
 TaskGroup Game::Boot(const cxxopts::ParseResult& values)
 {
   isDebug = CommandLineValue<bool>("debug");
   singlethreaded = CommandLineValue<bool>("singlethreaded");
+  profilePath = CommandLineValue<std::string>("profile");
+  interpolate = CommandLineValue<bool>("interpolate");
+
+  if (profilePath.size()) {
+    Profiler::SetEnabled(true);
+  }
 
   if (reader.IsOK()) {
     Logger::Log(LogLevel::warning, "config settings was not OK. Will use internal default key layout.");
@@ -206,6 +227,11 @@ TaskGroup Game::Boot(const cxxopts::ParseResult& values)
   Callback<void()> blocks;
   blocks.Slot(std::bind(&Game::RunBlocksInit, this, &progress));
 
+  Callback<void()> packageCache;
+  packageCache.Slot([] {
+    PackageFingerprintCache::Instance().Save();
+  });
+
   Callback<void()> init;
   init.Slot([this] {
     // Tell the input event loop how to behave when the app loses and regains focus
@@ -213,9 +239,9 @@ TaskGroup Game::Boot(const cxxopts::ParseResult& values)
     inputManager.BindRegainFocusEvent(std::bind(&Game::GainFocus, this));
     inputManager.BindResizedEvent(std::bind(&Game::Resize, this, std::placeholders::_1, std::placeholders::_2));
 
-    Font::specialCharLookup.insert(std::make_pair(char(-1), "THICK_SP"));
-    Font::specialCharLookup.insert(std::make_pair(char(-2), "THICK_EX"));
-    Font::specialCharLookup.insert(std::make_pair(char(-3), "THICK_NM"));
+    Font::AddSpecialChar(char(-1), "THICK_SP");
+    Font::AddSpecialChar(char(-2), "THICK_EX");
+    Font::AddSpecialChar(char(-3), "THICK_NM");
   });
 
   this->UpdateConfigSettings(reader.GetConfigSettings());
@@ -229,6 +255,7 @@ TaskGroup Game::Boot(const cxxopts::ParseResult& values)
   tasks.AddTask("Load mobs", std::move(mobs));
   tasks.AddTask("Load cards", std::move(cards));
   tasks.AddTask("Load prog blocks", std::move(blocks));
+  tasks.AddTask("Save package cache", std::move(packageCache));
 
   // Load font symbols immediately...
   textureManager.LoadFromFile(TexturePaths::FONT);
@@ -314,6 +341,54 @@ void Game::HandleRecordingEvents()
   recordOutThread.detach();
 }
 
+void Game::HandleProfilerEvents()
+{
+  if (!inputManager.Has(InputEvents::pressed_profiler)) return;
+
+  showProfiler = !showProfiler;
+
+  // Keep collecting zones for the trace written on exit
+  Profiler::SetEnabled(showProfiler || profilePath.size());
+}
+
+void Game::DrawProfilerOverlay()
+{
+  if (!showProfiler) return;
+
+  if (!profilerOverlay) {
+    profilerOverlay = std::make_unique<ProfilerOverlay>(window.GetView().getSize());
+  }
+
+  profilerOverlay->Update();
+  window.GetRenderWindow()->draw(*profilerOverlay);
+}
+
+void Game::HandleReplayEvents()
+{
+  if (!replayRecording && !replayPlayback) return;
+
+  if (replayRecording) {
+    replayRecording->RecordFrame(0, replayFrame, inputManager.EventsThisFrame());
+  }
+
+  replayFrame++;
+
+  if (replayPlayback) {
+    if (replayFrame >= replayPlayback->FrameCount()) {
+      Logger::Logf(LogLevel::info, "Replay finished after %d frames", static_cast<int>(replayFrame.count()));
+      replayPlayback.reset();
+      inputManager.UseKeyboardControls(true);
+      inputManager.UseGamepadControls(true);
+      return;
+    }
+
+    // Queue the next frame's input so it is processed by the next input update
+    replayPlayback->PlayFrame(0, replayFrame, [this](const InputEvent& event) {
+      inputManager.VirtualKeyEvent(event);
+    });
+  }
+}
+
 void Game::UpdateMouse(double dt)
 {
   auto& renderWindow = *window.GetRenderWindow();
@@ -324,81 +399,109 @@ void Game::UpdateMouse(double dt)
   mouseAnimation.Update(dt, mouse.getSprite());
 }
 
-void Game::ProcessFrame()
+void Game::Tick(double delta)
 {
-  sf::Clock clock;
-  float scope_elapsed = 0.0f;
-  window.GetRenderWindow()->setActive(true);
+  this->elapsed += from_seconds(delta);
 
-  while (!quitting) {
-    clock.restart();
+  // Poll net code
+  netManager.Update(delta);
 
-    double delta = 1.0 / static_cast<double>(frame_time_t::frames_per_second);
-    this->elapsed += from_seconds(delta);
+  inputManager.Update(); // process inputs
+  UpdateMouse(delta);
 
-    // Poll net code
-    netManager.Update(delta);
+  HandleProfilerEvents();
 
-    inputManager.Update(); // process inputs
-    UpdateMouse(delta);
+  if (NextFrame()) {
+    BN_PROFILE_ZONE("Game::update");
+    HandleRecordingEvents();
+    HandleReplayEvents();
+    this->update(delta);  // update game logic
+
+    if (isRecording) {
+      sf::Image image = window.GetRenderWindow()->capture();
+      recordedFrames.push_back(std::pair(FrameNumber(), image));
+    }
+  }
+}
 
-    window.Clear(); // clear screen
+void Game::Render(unsigned ticks)
+{
+  // finish textures decoded in the background while this thread owns the GL context
+  textureManager.UploadDecodedTextures();
 
-    if (NextFrame()) {
-      HandleRecordingEvents();
-      this->update(delta);  // update game logic
+  window.Clear(); // clear screen
 
-      if (isRecording) {
-        sf::Image image = window.GetRenderWindow()->capture();
-        recordedFrames.push_back(std::pair(FrameNumber(), image));
-      }
-    }
+  // Actors are drawn between their last two simulated positions. When every frame runs a tick the
+  // display is no faster than the simulation and alpha is only timing jitter, so actors are drawn where they are.
+  float alpha = 1.0f;
 
+  if (interpolate && !(ticks > 0 && tickedLastFrame)) {
+    alpha = simulationClock.Alpha();
+  }
+
+  tickedLastFrame = ticks > 0;
+  Overworld::WorldSprite::SetInterpolation(simulationClock.Ticks(), alpha);
+
+  {
+    BN_PROFILE_ZONE("Game::draw");
     this->draw();        // draw game
-    mouse.draw(*window.GetRenderWindow());
-    window.Display(); // display to screen
+  }
+
+  mouse.draw(*window.GetRenderWindow());
+  DrawProfilerOverlay();
+  window.Display(); // display to screen
+}
+
+void Game::ProcessFrame()
+{
+  sf::Clock clock;
+  window.GetRenderWindow()->setActive(true);
+
+  // interpolated frames are only worth drawing if the display can show more than 60 of them
+  window.UseVerticalSync(interpolate);
+
+  while (!quitting) {
+    Profiler::BeginFrame();
+    BN_PROFILE_ZONE("Game::ProcessFrame");
+
+    // Run as many fixed steps as real time allows, possibly none
+    unsigned ticks = simulationClock.Advance(clock.restart().asSeconds());
 
-    scope_elapsed = clock.getElapsedTime().asSeconds();
+    for (unsigned i = 0; i < ticks; i++) {
+      Tick(simulationClock.Step());
+    }
+
+    Render(ticks);
   }
 }
 
 void Game::RunSingleThreaded()
 {
   sf::Clock clock;
-  float scope_elapsed = 0.0f;
   window.GetRenderWindow()->setActive(true);
+  window.UseVerticalSync(interpolate);
 
   while (window.Running() && !quitting) {
-    clock.restart();
+    Profiler::BeginFrame();
+    BN_PROFILE_ZONE("Game::RunSingleThreaded");
 
     // Poll window events
     inputManager.EventPoll();
 
-    // unused images need to be free'd 
+    // unused images and sounds need to be free'd 
     textureManager.HandleExpiredTextureCache();
+    audioManager.HandleExpiredAudioCache();
 
-    double delta = 1.0 / static_cast<double>(frame_time_t::frames_per_second);
-    this->elapsed += from_seconds(delta);
-
-    // Poll net code
-    netManager.Update(delta);
-    inputManager.Update(); // process inputs
-    UpdateMouse(delta);
+    // Run as many fixed steps as real time allows, possibly none
+    unsigned ticks = simulationClock.Advance(clock.restart().asSeconds());
 
-    window.Clear(); // clear screen
-
-    if (NextFrame()) {
-      HandleRecordingEvents();
-      this->update(delta);  // update game logic
+    for (unsigned i = 0; i < ticks; i++) {
+      Tick(simulationClock.Step());
     }
-    
-    this->draw();        // draw game
-    mouse.draw(*window.GetRenderWindow());
-    window.Display(); // display to screen
 
-    quitting = getStackSize() == 0;
+    Render(ticks);
 
-    scope_elapsed = clock.getElapsedTime().asSeconds();
+    quitting = getStackSize() == 0;
   }
 }
 
@@ -418,8 +521,9 @@ void Game::Run()
     // Poll window events
     inputManager.EventPoll();
 
-    // unused images need to be free'd 
+    // unused images and sounds need to be free'd 
     textureManager.HandleExpiredTextureCache();
+    audioManager.HandleExpiredAudioCache();
 
     quitting = getStackSize() == 0;
   }
@@ -523,6 +627,46 @@ void Game::Record(bool enabled)
   isRecording = enabled;
 }
 
+void Game::RecordReplay(const BattleReplay& header, const std::string& path)
+{
+  replayRecording = std::make_unique<BattleReplay>(header);
+  replayRecordingPath = path;
+  replayFrame = frames(0);
+}
+
+void Game::PlayReplay(const BattleReplay& replay)
+{
+  replayPlayback = std::make_unique<BattleReplay>(replay);
+  replayFrame = frames(0);
+
+  inputManager.UseKeyboardControls(false);
+  inputManager.UseGamepadControls(false);
+
+  // Queue the first frame so it is processed by the next input update
+  replayPlayback->PlayFrame(0, replayFrame, [this](const InputEvent& event) {
+    inputManager.VirtualKeyEvent(event);
+  });
+}
+
+void Game::StopReplay()
+{
+  if (replayPlayback) {
+    replayPlayback.reset();
+    inputManager.UseKeyboardControls(true);
+    inputManager.UseGamepadControls(true);
+  }
+
+  if (replayRecording) {
+    replayRecording->Save(replayRecordingPath);
+    replayRecording.reset();
+  }
+}
+
+bool Game::IsPlayingReplay() const
+{
+  return replayPlayback != nullptr;
+}
+
 void Game::SetSubtitle(const std::string& subtitle)
 {
   window.SetSubtitle(subtitle);
@@ -640,6 +784,7 @@ void Game::RunCardInit(std::atomic<int>* progress) {
   auto LoadCardMods = QueueModRegistration<class CardPackageManager, ScriptedCard>;
   LoadCardMods(cardPackagePartitioner->GetPartition(Game::LocalPartition), "resources/mods/cards", "Card Mods");
   cardPackagePartitioner->GetPartition(Game::LocalPartition).LoadAllPackages(*progress);
+  CardMeta::IconAtlas().LogUsage("Card icon");
 
   Logger::Logf(LogLevel::info, "Loaded registered cards: %f secs", float(clock() - begin_time) / CLOCKS_PER_SEC);
 }
@@ -16,6 +16,10 @@
 #include "bnShaderResourceManager.h"
 #include "bnInputManager.h"
 #include "bnPackageManager.h"
+#include "bnBattleReplay.h"
+#include "bnProfiler.h"
+#include "bnProfilerOverlay.h"
+#include "bnFixedStepClock.h"
 
 #define ONB_REGION_JAPAN 0
 #define ONB_ENABLE_PIXELATE_GFX 0
@@ -99,6 +103,11 @@ private:
   // total elapsed frame time
   frame_time_t elapsed{};
 
+  // decides how many logic ticks run per rendered frame
+  FixedStepClock simulationClock{ 1.0 / static_cast<double>(frame_time_t::frames_per_second) };
+  bool interpolate{ true }; /*!< Draw overworld actors between ticks */
+  bool tickedLastFrame{}; /*!< The previous rendered frame ran at least one tick */
+
   Endianness endian{ Endianness::big };
   std::vector<cxxopts::KeyValue> commandlineArgs; /*!< User-provided values from the command line*/
   cxxopts::ParseResult const* commandline{ nullptr }; /*!< Final values parsed from the command line configuration*/
@@ -107,8 +116,23 @@ private:
   std::mutex windowMutex;
   std::thread renderThread, recordOutThread;
 
+  // input replays
+  std::unique_ptr<BattleReplay> replayRecording, replayPlayback;
+  std::string replayRecordingPath;
+  frame_time_t replayFrame{};
+
+  // profiler
+  std::unique_ptr<ProfilerOverlay> profilerOverlay;
+  std::string profilePath; /*!< Chrome trace is written here on exit if set */
+  bool showProfiler{};
+
   void HandleRecordingEvents();
+  void HandleReplayEvents();
+  void HandleProfilerEvents();
+  void DrawProfilerOverlay();
   void UpdateMouse(double dt);
+  void Tick(double delta);
+  void Render(unsigned ticks);
   void ProcessFrame();
   void RunSingleThreaded();
   bool NextFrame();
@@ -139,6 +163,25 @@ public:
   bool IsSingleThreaded() const;
   bool IsRecording() const;
   void Record(bool enabled = true);
+
+  /**
+   * @brief Records the processed input of every following frame into a replay
+   * @param header seed, packages, and folder of the battle about to start
+   * @param path where the replay is written when recording stops
+   */
+  void RecordReplay(const BattleReplay& header, const std::string& path);
+
+  /**
+   * @brief Feeds a replay's input back in real time instead of the keyboard and gamepad
+   * Hardware input is restored when the replay runs out of frames.
+   */
+  void PlayReplay(const BattleReplay& replay);
+
+  /**
+   * @brief Stops playback and writes any replay being recorded to disk
+   */
+  void StopReplay();
+  bool IsPlayingReplay() const;
   void SetSubtitle(const std::string& subtitle);
 
   const std::string AppDataPath();
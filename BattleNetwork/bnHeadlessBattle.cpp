@@ -0,0 +1,477 @@
+#include "bnHeadlessBattle.h"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <atomic>
+#include <type_traits>
+
+#include "bnField.h"
+#include "bnTile.h"
+#include "bnMob.h"
+#include "bnPlayer.h"
+#include "bnAgent.h"
+#include "bnCardFolder.h"
+#include "bnPlayerIdleState.h"
+#include "bnPlayerControlledState.h"
+#include "bnPlayerSelectedCardsUI.h"
+#include "bnResourceHandle.h"
+#include "bnInputHandle.h"
+#include "bnRandom.h"
+#include "bnLogger.h"
+#include "bnProfiler.h"
+#include "bnGame.h"
+
+#include "bnPlayerPackageManager.h"
+#include "bnCardPackageManager.h"
+#include "bnMobPackageManager.h"
+#include "bnBlockPackageManager.h"
+#include "bnLuaLibraryPackageManager.h"
+
+#ifdef BN_MOD_SUPPORT
+#include "bindings/bnScriptedBlock.h"
+#include "bindings/bnScriptedCard.h"
+#include "bindings/bnScriptedPlayer.h"
+#include "bindings/bnScriptedMob.h"
+#include "bindings/bnLuaLibrary.h"
+#include "bnQueueModRegistration.h"
+#endif
+
+// Same cust gauge length and hand size as the battle scene
+#define HEADLESS_CUST_DURATION_SECONDS 10.0
+#define HEADLESS_HAND_SIZE 5
+
+namespace {
+  using HeadlessClock = std::chrono::steady_clock;
+
+  double SecondsSince(const HeadlessClock::time_point& start) {
+    return std::chrono::duration<double>(HeadlessClock::now() - start).count();
+  }
+
+  // 64-bit FNV-1a
+  void HashBytes(uint64_t& hash, const void* data, size_t len) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+    for (size_t i = 0; i < len; i++) {
+      hash ^= bytes[i];
+      hash *= 1099511628211ull;
+    }
+  }
+
+  template<typename T>
+  void HashValue(uint64_t& hash, const T& value) {
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "only hash plain values");
+    HashBytes(hash, &value, sizeof(T));
+  }
+}
+
+const char* HeadlessBattleResults::PhaseName(Phase phase)
+{
+  switch (phase) {
+  case Phase::input:
+    return "input";
+  case Phase::spawn:
+    return "spawn";
+  case Phase::field:
+    return "field";
+  case Phase::cards:
+    return "cards";
+  }
+
+  return "unknown";
+}
+
+const char* HeadlessBattleResults::OutcomeName(Outcome outcome)
+{
+  switch (outcome) {
+  case Outcome::timeout:
+    return "timeout";
+  case Outcome::mobCleared:
+    return "mob cleared";
+  case Outcome::playerDeleted:
+    return "player deleted";
+  }
+
+  return "unknown";
+}
+
+HeadlessBattle::HeadlessBattle() :
+  textureManager(),
+  audioManager(),
+  shaderManager(),
+  inputManager(window)
+{
+  // Nothing is drawn or heard
+  textureManager.SetHeadless(true);
+  audioManager.EnableAudio(false);
+
+  ResourceHandle::audio    = &audioManager;
+  ResourceHandle::textures = &textureManager;
+  ResourceHandle::shaders  = &shaderManager;
+
+  cardPackagePartitioner = new class CardPackagePartitioner();
+  playerPackagePartitioner = new class PlayerPackagePartitioner();
+  blockPackagePartitioner = new class BlockPackagePartitioner();
+  mobPackagePartitioner = new class MobPackagePartitioner();
+  luaLibraryPackagePartitioner = new class LuaLibraryPackagePartitioner();
+
+  cardPackagePartitioner->CreateNamespace(Game::LocalPartition);
+  playerPackagePartitioner->CreateNamespace(Game::LocalPartition);
+  blockPackagePartitioner->CreateNamespace(Game::LocalPartition);
+  mobPackagePartitioner->CreateNamespace(Game::LocalPartition);
+  luaLibraryPackagePartitioner->CreateNamespace(Game::LocalPartition);
+
+#ifdef BN_MOD_SUPPORT
+  ResourceHandle::scripts = &scriptManager;
+  scriptManager.SetCardPackagePartitioner(*cardPackagePartitioner);
+#endif
+
+  InputHandle::input = &inputManager;
+}
+
+HeadlessBattle::~HeadlessBattle()
+{
+  // Battle objects may reference package data so they go first
+  cardUI = nullptr;
+  player = nullptr;
+  field = nullptr;
+  folder = nullptr;
+  cardListener = nullptr;
+
+  delete mob;
+
+  delete cardPackagePartitioner;
+  delete playerPackagePartitioner;
+  delete blockPackagePartitioner;
+  delete mobPackagePartitioner;
+  delete luaLibraryPackagePartitioner;
+}
+
+void HeadlessBattle::LoadPackages()
+{
+  std::atomic<int> progress{};
+  const clock_t begin_time = clock();
+
+#ifdef BN_MOD_SUPPORT
+  QueueModRegistration<class LuaLibraryPackageManager, LuaLibrary>(luaLibraryPackagePartitioner->GetPartition(Game::LocalPartition), "resources/mods/libs", "Core Libs Mods");
+  luaLibraryPackagePartitioner->GetPartition(Game::LocalPartition).LoadAllPackages(progress);
+
+  QueueModRegistration<class PlayerPackageManager, ScriptedPlayer>(playerPackagePartitioner->GetPartition(Game::LocalPartition), "resources/mods/players", "Player Mods");
+  playerPackagePartitioner->GetPartition(Game::LocalPartition).LoadAllPackages(progress);
+
+  QueueModRegistration<class MobPackageManager, ScriptedMob>(mobPackagePartitioner->GetPartition(Game::LocalPartition), "resources/mods/enemies", "Enemy Mods");
+  mobPackagePartitioner->GetPartition(Game::LocalPartition).LoadAllPackages(progress);
+
+  QueueModRegistration<class CardPackageManager, ScriptedCard>(cardPackagePartitioner->GetPartition(Game::LocalPartition), "resources/mods/cards", "Card Mods");
+  cardPackagePartitioner->GetPartition(Game::LocalPartition).LoadAllPackages(progress);
+
+  QueueModRegistration<class BlockPackageManager, ScriptedBlock>(blockPackagePartitioner->GetPartition(Game::LocalPartition), "resources/mods/blocks", "Prog Block Mods");
+  blockPackagePartitioner->GetPartition(Game::LocalPartition).LoadAllPackages(progress);
+#endif
+
+  Logger::Logf(LogLevel::info, "Loaded packages: %f secs", float(clock() - begin_time) / CLOCKS_PER_SEC);
+}
+
+HeadlessBattleResults HeadlessBattle::Run(const HeadlessBattleProps& props)
+{
+  using Phase = HeadlessBattleResults::Phase;
+
+  HeadlessBattleResults results;
+
+  const BattleReplay* replay = props.replay;
+  const unsigned int seed = replay ? replay->seed : props.seed;
+  const std::string& playerPackage = replay ? replay->player.packageId : props.playerPackage;
+  const std::string& mobPackage = replay ? replay->mob.packageId : props.mobPackage;
+
+  srand(seed);
+  SeedSyncedRand(seed);
+
+  PlayerPackageManager& players = playerPackagePartitioner->GetPartition(Game::LocalPartition);
+  MobPackageManager& mobs = mobPackagePartitioner->GetPartition(Game::LocalPartition);
+  CardPackageManager& cards = cardPackagePartitioner->GetPartition(Game::LocalPartition);
+
+  if (!players.HasPackage(playerPackage)) {
+    throw std::runtime_error("Player package `" + playerPackage + "` is not installed");
+  }
+
+  if (!mobs.HasPackage(mobPackage)) {
+    throw std::runtime_error("Mob package `" + mobPackage + "` is not installed");
+  }
+
+  if (replay) {
+    // Warns if a package changed since the replay was recorded
+    BattleReplay::VerifyPackage(players, replay->player);
+    BattleReplay::VerifyPackage(mobs, replay->mob);
+  }
+
+  field = std::make_shared<Field>(6, 3);
+  field->HandleMissingLayout();
+  CharacterDeleteListener::Subscribe(*field);
+  CharacterSpawnListener::Subscribe(*field);
+
+  player = std::shared_ptr<Player>(players.FindPackageByID(playerPackage).GetData());
+  mob = mobs.FindPackageByID(mobPackage).GetData()->Build(field);
+  folder = replay ? replay->BuildFolder(cards) : LoadFolderFromFile(props.folderPath, cards);
+  nextFolderCard = 0;
+
+  results.replay.seed = seed;
+  results.replay.player = BattleReplay::DescribePackage(players, playerPackage);
+  results.replay.mob = BattleReplay::DescribePackage(mobs, mobPackage);
+  results.replay.RecordFolder(*folder, cards);
+  isPlayerDeleted = false;
+
+  // Spawn the player the same way MobBattleScene does
+  int playerX = 2, playerY = 2;
+
+  if (mob->HasPlayerSpawnPoint(1)) {
+    Mob::PlayerSpawnData data = mob->GetPlayerSpawnPoint(1);
+    playerX = data.tileX;
+    playerY = data.tileY;
+  }
+
+  player->Init();
+  player->ChangeState<PlayerIdleState>();
+  player->SetTeam(field->GetAt(playerX, playerY)->GetTeam());
+  field->AddEntity(player, playerX, playerY);
+
+  cardUI = player->CreateComponent<PlayerSelectedCardsUI>(player, cardPackagePartitioner);
+  cardListener = std::make_unique<RealtimeCardActionUseListener>(*cardPackagePartitioner);
+  cardListener->Subscribe(*player);
+  cardListener->Subscribe(*cardUI);
+
+  const double delta = 1.0 / static_cast<double>(frame_time_t::frames_per_second);
+  std::vector<std::shared_ptr<Character>> friendlies;
+  bool introDone = false;
+  double customProgress = 0;
+  frame_time_t frame{};
+  std::unordered_map<std::string, InputState> frameInputs;
+
+  const HeadlessClock::time_point start = HeadlessClock::now();
+
+  for (; frame < props.maxFrames; frame++) {
+    Profiler::BeginFrame();
+    BN_PROFILE_ZONE("HeadlessBattle::Run");
+    HeadlessClock::time_point phaseStart = HeadlessClock::now();
+
+    frameInputs.clear();
+
+    // Keys are re-sent every frame they are held, like the input manager does
+    if (replay) {
+      replay->PlayFrame(0, frame, [&frameInputs](const InputEvent& event) {
+        frameInputs[event.name] = event.state;
+      });
+    }
+    else {
+      for (const HeadlessInput& input : props.inputs) {
+        if (input.start <= frame && frame <= input.end) {
+          frameInputs[input.name] = InputState::pressed;
+        }
+      }
+    }
+
+    for (auto& [name, state] : frameInputs) {
+      player->InputState().VirtualKeyEvent(InputEvent{ name, state });
+    }
+
+    results.replay.RecordFrame(0, frame, frameInputs);
+
+    results.phaseSeconds[static_cast<size_t>(Phase::input)] += SecondsSince(phaseStart);
+    phaseStart = HeadlessClock::now();
+
+    if (!introDone) {
+      if (mob->NextMobReady()) {
+        std::unique_ptr<Mob::SpawnData> data = mob->GetNextSpawn();
+        std::shared_ptr<Character>& enemy = data->character;
+
+        if (Agent* agent = dynamic_cast<Agent*>(enemy.get())) {
+          agent->SetTarget(player);
+        }
+
+        enemy->ToggleTimeFreeze(false);
+
+        Battle::Tile* destTile = field->GetAt(data->tileX, data->tileY);
+        enemy->SetTeam(destTile->GetTeam());
+        field->AddEntity(enemy, data->tileX, data->tileY);
+
+        if (destTile->GetTeam() == Team::red) {
+          friendlies.push_back(enemy);
+        }
+      }
+      else if (mob->IsSpawningDone()) {
+        mob->DefaultState();
+
+        for (std::shared_ptr<Character>& f : friendlies) {
+          mob->Forget(*f);
+        }
+
+        friendlies.clear();
+        player->ChangeState<PlayerControlledState>();
+
+        DrawNextHand();
+        field->RequestBattleStart();
+        introDone = true;
+      }
+    }
+
+    results.phaseSeconds[static_cast<size_t>(Phase::spawn)] += SecondsSince(phaseStart);
+    phaseStart = HeadlessClock::now();
+
+    field->Update(delta);
+
+    results.phaseSeconds[static_cast<size_t>(Phase::field)] += SecondsSince(phaseStart);
+    phaseStart = HeadlessClock::now();
+
+    if (introDone) {
+      customProgress += delta;
+
+      // Card select is instant, the next hand is drawn as soon as the player asks for it
+      bool isGaugeFull = customProgress >= HEADLESS_CUST_DURATION_SECONDS;
+      if (isGaugeFull && player->InputState().Has(InputEvents::pressed_cust_menu)) {
+        field->RequestBattleStop();
+        DrawNextHand();
+        field->RequestBattleStart();
+        customProgress = 0;
+      }
+    }
+
+    results.phaseSeconds[static_cast<size_t>(Phase::cards)] += SecondsSince(phaseStart);
+
+    if (isPlayerDeleted) {
+      results.outcome = HeadlessBattleResults::Outcome::playerDeleted;
+      frame++;
+      break;
+    }
+
+    if (introDone && mob->IsCleared()) {
+      results.outcome = HeadlessBattleResults::Outcome::mobCleared;
+      frame++;
+      break;
+    }
+  }
+
+  results.wallSeconds = SecondsSince(start);
+  results.frames = frame;
+  results.stateHash = HashFieldState(frame);
+
+  return results;
+}
+
+void HeadlessBattle::DrawNextHand()
+{
+  std::vector<Battle::Card> hand;
+
+  // Draw in folder list order so runs are repeatable
+  for (CardFolder::Iter iter = folder->Begin() + nextFolderCard; iter != folder->End() && hand.size() < HEADLESS_HAND_SIZE; iter++) {
+    hand.push_back(**iter);
+    nextFolderCard++;
+  }
+
+  cardUI->LoadCards(hand);
+}
+
+uint64_t HeadlessBattle::HashFieldState(frame_time_t frame) const
+{
+  uint64_t hash = 14695981039346656037ull;
+
+  HashValue(hash, frame.count());
+  HashValue(hash, SyncedRandomGenerator().Checksum());
+
+  std::vector<Battle::Tile*> tiles = field->FindTiles([](Battle::Tile*) { return true; });
+
+  std::sort(tiles.begin(), tiles.end(), [](Battle::Tile* a, Battle::Tile* b) {
+    return a->GetY() == b->GetY() ? a->GetX() < b->GetX() : a->GetY() < b->GetY();
+  });
+
+  for (Battle::Tile* tile : tiles) {
+    HashValue(hash, tile->GetX());
+    HashValue(hash, tile->GetY());
+    HashValue(hash, tile->GetState());
+    HashValue(hash, tile->GetTeam());
+  }
+
+  std::vector<std::shared_ptr<Entity>> entities = field->FindEntities([](std::shared_ptr<Entity>&) { return true; });
+
+  std::sort(entities.begin(), entities.end(), [](const std::shared_ptr<Entity>& a, const std::shared_ptr<Entity>& b) {
+    return a->GetID() < b->GetID();
+  });
+
+  for (const std::shared_ptr<Entity>& entity : entities) {
+    HashValue(hash, entity->GetID());
+    HashValue(hash, entity->GetHealth());
+    HashValue(hash, entity->GetTeam());
+    HashValue(hash, entity->GetElement());
+    HashValue(hash, entity->IsDeleted());
+
+    if (Battle::Tile* tile = entity->GetTile()) {
+      HashValue(hash, tile->GetX());
+      HashValue(hash, tile->GetY());
+    }
+  }
+
+  return hash;
+}
+
+std::vector<HeadlessInput> HeadlessBattle::LoadInputsFromFile(const std::string& filePath)
+{
+  std::vector<HeadlessInput> inputs;
+  std::ifstream file(filePath);
+
+  if (!file.is_open()) {
+    Logger::Logf(LogLevel::warning, "Could not open input script %s", filePath.c_str());
+    return inputs;
+  }
+
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#') continue;
+
+    std::istringstream ss(line);
+    int64_t start{}, end{};
+    std::string name;
+
+    if (!(ss >> start >> end) || !std::getline(ss >> std::ws, name) || name.empty()) {
+      Logger::Logf(LogLevel::debug, "Input script lines need three entries: `START END NAME`");
+      continue;
+    }
+
+    inputs.push_back(HeadlessInput{ frames(start), frames(end), name });
+  }
+
+  return inputs;
+}
+
+void HeadlessBattle::OnSpawnEvent(std::shared_ptr<Character>& spawned)
+{
+  // Only the enemy mob is tracked
+  if (spawned->GetTeam() == Team::blue) {
+    mob->Track(spawned);
+  }
+}
+
+void HeadlessBattle::OnDeleteEvent(Character& pending)
+{
+  if (player.get() == &pending) {
+    isPlayerDeleted = true;
+  }
+
+  Character* pendingPtr = &pending;
+
+  // Find any AI using this character as a target and free that pointer
+  field->FindEntities([pendingPtr](std::shared_ptr<Entity>& in) {
+    Agent* agent = dynamic_cast<Agent*>(in.get());
+
+    if (agent && agent->GetTarget().get() == pendingPtr) {
+      agent->FreeTarget();
+    }
+
+    return false;
+  });
+
+  if (mob) {
+    mob->Forget(pending);
+  }
+}
@@ -0,0 +1,163 @@
+/*! \file bnHeadlessBattle.h */
+
+/*! \brief Runs a mob battle without a window, rendering, or audio
+ *
+ * HeadlessBattle owns its own resource managers and package partitions so
+ * player, mob, and card packages can be loaded on machines without a display.
+ * Textures are never uploaded to the GPU, shaders are never compiled, and
+ * audio playback is disabled.
+ *
+ * Each frame feeds the scripted inputs to the player, spawns the next mob
+ * character, and steps the field at a fixed 60 fps delta as fast as the CPU
+ * allows. The battle flow mirrors the MobIntro, CardSelect, and Combat states
+ * of MobBattleScene but card selection is instant: the next hand is drawn in
+ * folder order whenever the custom gauge is full and the player presses the
+ * cust menu input.
+ *
+ * Every battle is recorded into a BattleReplay. Running with a replay feeds
+ * the recorded inputs back on the same frames instead of the scripted inputs.
+ *
+ * Components injected into a BattleSceneBase (ui and battlestep lifetimes)
+ * are not updated because there is no scene to own them.
+ */
+
+#pragma once
+#include <SFML/Window/Window.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bnTextureResourceManager.h"
+#include "bnAudioResourceManager.h"
+#include "bnShaderResourceManager.h"
+#include "bnInputManager.h"
+#include "bnRealtimeCardUseListener.h"
+#include "bnCharacterSpawnListener.h"
+#include "bnCharacterDeleteListener.h"
+#include "bnInputEvent.h"
+#include "bnBattleReplay.h"
+#include "frame_time_t.h"
+
+#ifdef BN_MOD_SUPPORT
+#include "bnScriptResourceManager.h"
+#endif
+
+class Field;
+class Mob;
+class Player;
+class CardFolder;
+class PlayerSelectedCardsUI;
+class PlayerPackagePartitioner;
+class MobPackagePartitioner;
+class BlockPackagePartitioner;
+class LuaLibraryPackagePartitioner;
+
+/**
+ * @brief A key held down by the player for a range of frames
+ */
+struct HeadlessInput {
+  frame_time_t start{}, end{}; /*!< Inclusive range of frames */
+  std::string name; /*!< InputEvent name e.g. `Move Up` */
+};
+
+struct HeadlessBattleProps {
+  std::string playerPackage;
+  std::string mobPackage;
+  std::string folderPath; /*!< Same folder list format as battle-only mode */
+  std::vector<HeadlessInput> inputs;
+  unsigned int seed{};
+  frame_time_t maxFrames{ frames(60 * 60 * 5) }; /*!< Stop after 5 minutes of battle time by default */
+  const BattleReplay* replay{ nullptr }; /*!< If set, replaces the packages, folder, inputs, and seed above */
+};
+
+struct HeadlessBattleResults {
+  enum class Phase : size_t {
+    input = 0,
+    spawn,
+    field,
+    cards,
+    size
+  };
+
+  enum class Outcome : unsigned char {
+    timeout = 0,
+    mobCleared,
+    playerDeleted
+  };
+
+  frame_time_t frames{};
+  double wallSeconds{};
+  std::array<double, static_cast<size_t>(Phase::size)> phaseSeconds{};
+  Outcome outcome{};
+  uint64_t stateHash{};
+  BattleReplay replay; /*!< Seed, packages, folder, and the inputs fed to the player on each frame */
+
+  static const char* PhaseName(Phase phase);
+  static const char* OutcomeName(Outcome outcome);
+};
+
+class HeadlessBattle final :
+  public CharacterSpawnListener,
+  public CharacterDeleteListener {
+  sf::Window window; //!< Never created. InputManager needs a window reference.
+  TextureResourceManager textureManager;
+  AudioResourceManager audioManager;
+  ShaderResourceManager shaderManager;
+  InputManager inputManager;
+
+#ifdef BN_MOD_SUPPORT
+  ScriptResourceManager scriptManager;
+#endif
+
+  class CardPackagePartitioner* cardPackagePartitioner{ nullptr };
+  class PlayerPackagePartitioner* playerPackagePartitioner{ nullptr };
+  class MobPackagePartitioner* mobPackagePartitioner{ nullptr };
+  class BlockPackagePartitioner* blockPackagePartitioner{ nullptr };
+  class LuaLibraryPackagePartitioner* luaLibraryPackagePartitioner{ nullptr };
+
+  std::shared_ptr<Field> field;
+  std::shared_ptr<Player> player;
+  std::shared_ptr<PlayerSelectedCardsUI> cardUI;
+  std::unique_ptr<CardFolder> folder;
+  std::unique_ptr<RealtimeCardActionUseListener> cardListener;
+  Mob* mob{ nullptr };
+  size_t nextFolderCard{};
+  bool isPlayerDeleted{ false };
+
+  void DrawNextHand();
+  uint64_t HashFieldState(frame_time_t frame) const;
+
+public:
+  HeadlessBattle();
+  ~HeadlessBattle();
+
+  HeadlessBattle(const HeadlessBattle&) = delete;
+
+  /**
+   * @brief Loads every library, player, mob, card, and block package from resources/mods
+   */
+  void LoadPackages();
+
+  /**
+   * @brief Builds the field, player, and mob then runs the battle to completion
+   * @param props packages, folder, inputs, and limits for this battle
+   * @return frame count, timings, and the hash of the field on the last frame
+   * @throws std::runtime_error if the player or mob package is not installed
+   */
+  HeadlessBattleResults Run(const HeadlessBattleProps& props);
+
+  /**
+   * @brief Reads a list of held inputs from disk
+   * @param filePath path to the input script
+   * @return list of inputs. Malformed lines are skipped.
+   *
+   * Each line is `START END NAME` where START and END are inclusive frame numbers
+   * and NAME is the input event name e.g. `120 125 Move Up`. Lines starting with `#` are ignored.
+   */
+  static std::vector<HeadlessInput> LoadInputsFromFile(const std::string& filePath);
+
+  void OnSpawnEvent(std::shared_ptr<Character>& spawned) override;
+  void OnDeleteEvent(Character& pending) override;
+};
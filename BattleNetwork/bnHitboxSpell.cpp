@@ -3,6 +3,16 @@
 #include "bnField.h"
 
 HitboxSpell::HitboxSpell(Team _team, int _damage) : Spell(_team) {
+  Reset(_team, _damage);
+}
+
+HitboxSpell::~HitboxSpell() {
+}
+
+void HitboxSpell::Reset(Team _team, int _damage)
+{
+  Spell::Reset(_team);
+
   hit = false;
   damage = _damage;
 
@@ -10,9 +20,9 @@ HitboxSpell::HitboxSpell(Team _team, int _damage) : Spell(_team) {
   props.flags |= Hit::impact;
   props.damage = _damage;
   SetHitboxProperties(props);
-}
 
-HitboxSpell::~HitboxSpell() {
+  attackCallback = nullptr;
+  collisionCallback = nullptr;
 }
 
 void HitboxSpell::OnSpawn(Battle::Tile & start)
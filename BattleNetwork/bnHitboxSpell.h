@@ -25,6 +25,11 @@ public:
    */
   ~HitboxSpell();
 
+  /**
+   * @brief Restores the constructed state when recycled from an EntityPool
+   */
+  void Reset(Team _team, int damage = 0);
+
   void OnSpawn(Battle::Tile& start) override;
 
   /**
@@ -6,6 +6,7 @@ class InputManager;
 
 class InputHandle {
   friend class Game;
+  friend class HeadlessBattle;
 
 private:
   static InputManager* input;
@@ -245,7 +245,7 @@ void InputManager::EventPoll() {
         }
       }
     }
-    else {
+    else if (useKeyboardControls) {
       if (keyboardState[sf::Keyboard::Key::Up]) {
         VirtualKeyEvent(InputEvents::pressed_move_up);
         VirtualKeyEvent(InputEvents::pressed_ui_up);
@@ -286,6 +286,9 @@ void InputManager::EventPoll() {
         VirtualKeyEvent(InputEvents::pressed_shoulder_right);
         VirtualKeyEvent(InputEvents::pressed_cust_menu);
       }
+      if (keyboardState[sf::Keyboard::Key::F3]) {
+        VirtualKeyEvent(InputEvents::pressed_profiler);
+      }
     }
   }
 
@@ -322,6 +325,11 @@ const std::unordered_map<std::string, InputState> InputManager::StateThisFrame()
   return inputState.ToHash();
 }
 
+const std::unordered_map<std::string, InputState> InputManager::EventsThisFrame() const
+{
+  return inputState.EventsThisFrame();
+}
+
 const bool InputManager::ConvertKeyToString(const sf::Keyboard::Key key, std::string & out) const
 {
   switch (key) {
@@ -60,6 +60,11 @@ public:
 
   Gamepad GetAnyGamepadButton() const;
   const std::unordered_map<std::string, InputState> StateThisFrame() const;
+
+  /**
+   * @brief Key events queued for this frame before they were processed into StateThisFrame()
+   */
+  const std::unordered_map<std::string, InputState> EventsThisFrame() const;
   const bool ConvertKeyToString(const sf::Keyboard::Key key, std::string& out) const;
 
   /**
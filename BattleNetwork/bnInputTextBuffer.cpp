@@ -10,8 +10,7 @@ static float GetCharacterWidth(Font& font, float letterSpacing, char c) {
   case L'\n':
     return 0;
   default:
-    font.SetLetter(c);
-    return font.GetLetterWidth() + letterSpacing;
+    return font.GetGlyph(c).advance + letterSpacing;
   }
 }
 
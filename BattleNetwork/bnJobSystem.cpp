@@ -0,0 +1,122 @@
+#include "bnJobSystem.h"
+#include <algorithm>
+
+JobSystem::JobSystem(unsigned workers)
+{
+  if (workers == 0) {
+    unsigned cores = std::thread::hardware_concurrency();
+    workers = cores > 1 ? cores - 1 : 0;
+  }
+
+  workerCount = workers;
+}
+
+JobSystem::~JobSystem()
+{
+  {
+    std::scoped_lock lock(mutex);
+    quit = true;
+  }
+
+  wake.notify_all();
+
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+}
+
+JobSystem& JobSystem::Shared()
+{
+  static JobSystem jobs;
+  return jobs;
+}
+
+unsigned JobSystem::GetWorkerCount() const
+{
+  return workerCount;
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grain, const Job& job)
+{
+  grain = std::max<size_t>(grain, 1);
+
+  if (workerCount == 0 || count <= grain) {
+    for (size_t i = 0; i < count; i++) {
+      job(i);
+    }
+    return;
+  }
+
+  std::scoped_lock call(callMutex);
+
+  if (workers.empty()) {
+    Start();
+  }
+
+  {
+    std::scoped_lock lock(mutex);
+    this->job = &job;
+    this->count = count;
+    this->grain = grain;
+    next = 0;
+    busy = workerCount;
+    generation++;
+  }
+
+  wake.notify_all();
+  RunChunks();
+
+  // Workers read job, count, and grain until they leave the generation
+  std::unique_lock lock(mutex);
+  finished.wait(lock, [this] { return busy == 0; });
+  this->job = nullptr;
+}
+
+void JobSystem::Start()
+{
+  workers.reserve(workerCount);
+
+  for (unsigned i = 0; i < workerCount; i++) {
+    workers.emplace_back(&JobSystem::WorkerLoop, this);
+  }
+}
+
+void JobSystem::WorkerLoop()
+{
+  uint64_t seen = 0;
+
+  while (true) {
+    {
+      std::unique_lock lock(mutex);
+      wake.wait(lock, [this, seen] { return quit || generation != seen; });
+
+      if (quit) return;
+
+      seen = generation;
+    }
+
+    RunChunks();
+
+    {
+      std::scoped_lock lock(mutex);
+      busy--;
+    }
+
+    finished.notify_one();
+  }
+}
+
+void JobSystem::RunChunks()
+{
+  while (true) {
+    size_t start = next.fetch_add(grain);
+
+    if (start >= count) return;
+
+    size_t end = std::min(start + grain, count);
+
+    for (size_t i = start; i < end; i++) {
+      (*job)(i);
+    }
+  }
+}
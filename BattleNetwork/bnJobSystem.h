@@ -0,0 +1,75 @@
+/*! \brief Runs a loop body across a fixed set of worker threads
+ *
+ * ParallelFor() splits [0, count) into chunks of `grain` indices. The calling
+ * thread takes chunks alongside the workers and returns once every index has
+ * run. Jobs must only write to state owned by their own index. Anything that
+ * touches shared state should be recorded and applied by the caller afterwards
+ * in index order so the result does not depend on which thread ran what.
+ *
+ * Workers are started on the first parallel call. When there is one core, or
+ * the loop fits in a single chunk, the body runs on the calling thread.
+ *
+ * Use Shared() rather than creating a pool per object so the process keeps
+ * one worker per core no matter how many systems run parallel loops.
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem {
+public:
+  using Job = std::function<void(size_t)>;
+
+  /**
+   * @param workers number of threads besides the caller. 0 uses one less than the core count.
+   */
+  explicit JobSystem(unsigned workers = 0);
+  ~JobSystem();
+
+  JobSystem(const JobSystem&) = delete;
+  JobSystem& operator=(const JobSystem&) = delete;
+
+  /**
+   * @brief The process-wide pool sized to the core count
+   */
+  static JobSystem& Shared();
+
+  /**
+   * @brief Calls job(i) for every i in [0, count) and waits for all of them
+   * @param count number of indices
+   * @param grain indices each thread takes at a time
+   * @param job the loop body
+   *
+   * Calls from different threads take turns. Must not be called from inside a job.
+   */
+  void ParallelFor(size_t count, size_t grain, const Job& job);
+
+  /**
+   * @brief Threads that help the caller. 0 means every job runs serially.
+   */
+  unsigned GetWorkerCount() const;
+
+private:
+  unsigned workerCount{};
+  std::vector<std::thread> workers;
+  std::mutex callMutex; /*!< Held for a whole ParallelFor call so callers on other threads wait their turn */
+  std::mutex mutex;
+  std::condition_variable wake, finished;
+  bool quit{ false };
+  uint64_t generation{}; /*!< Incremented for each ParallelFor call */
+  const Job* job{ nullptr };
+  size_t count{}, grain{ 1 };
+  std::atomic<size_t> next{ 0 }; /*!< First index of the next chunk to claim */
+  unsigned busy{}; /*!< Workers still inside the current generation */
+
+  void Start();
+  void WorkerLoop();
+  void RunChunks();
+};
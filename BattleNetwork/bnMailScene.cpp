@@ -52,16 +52,16 @@ MailScene::MailScene(swoosh::ActivityController& controller, Inbox& inbox) :
 {
   label.setScale(2.f, 2.f);
 
-  moreText.setTexture(*Textures().LoadFromFile(TexturePaths::TEXT_BOX_NEXT_CURSOR));
+  moreText.setTexture(*Textures().LoadPinnedFromFile(TexturePaths::TEXT_BOX_NEXT_CURSOR));
   moreText.setScale(2.f, 2.f);
 
-  scroll.setTexture(*Textures().LoadFromFile(TexturePaths::FOLDER_SCROLLBAR));
+  scroll.setTexture(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_SCROLLBAR));
   scroll.setScale(2.f, 2.f);
 
-  cursor.setTexture(*Textures().LoadFromFile(TexturePaths::FOLDER_CURSOR));
+  cursor.setTexture(*Textures().LoadPinnedFromFile(TexturePaths::FOLDER_CURSOR));
   cursor.setScale(2.f, 2.f);
 
-  bg.setTexture(*Textures().LoadFromFile("resources/scenes/items/bg.png"), true);
+  bg.setTexture(*Textures().LoadPinnedFromFile("resources/scenes/items/bg.png"), true);
   bg.setScale(2.f, 2.f);
 
   iconTexture = Textures().LoadFromFile("resources/scenes/mail/icons.png");
@@ -0,0 +1,115 @@
+#include "bnMappedFile.h"
+#include "bnFileUtil.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif !defined(__ANDROID__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+bool MappedFile::Open(const std::string& path)
+{
+  Close();
+
+#if defined(_WIN32)
+  HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (handle == INVALID_HANDLE_VALUE) return false;
+
+  LARGE_INTEGER length{};
+
+  if (!GetFileSizeEx(handle, &length) || length.QuadPart == 0) {
+    CloseHandle(handle);
+    return false;
+  }
+
+  HANDLE view = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+  if (!view) {
+    CloseHandle(handle);
+    return false;
+  }
+
+  const void* address = MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0);
+
+  if (!address) {
+    CloseHandle(view);
+    CloseHandle(handle);
+    return false;
+  }
+
+  file = handle;
+  mapping = view;
+  data = static_cast<const char*>(address);
+  size = static_cast<size_t>(length.QuadPart);
+  return true;
+#elif !defined(__ANDROID__)
+  int fd = open(path.c_str(), O_RDONLY);
+
+  if (fd < 0) return false;
+
+  struct stat info {};
+
+  if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+    close(fd);
+    return false;
+  }
+
+  void* address = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+  // The mapping stays valid after the descriptor is closed
+  close(fd);
+
+  if (address == MAP_FAILED) return false;
+
+  data = static_cast<const char*>(address);
+  size = static_cast<size_t>(info.st_size);
+  return true;
+#else
+  fallback = FileUtil::Read(path);
+
+  if (fallback.empty()) return false;
+
+  data = fallback.data();
+  size = fallback.size();
+  return true;
+#endif
+}
+
+void MappedFile::Close()
+{
+  if (!data) return;
+
+#if defined(_WIN32)
+  UnmapViewOfFile(data);
+  CloseHandle(mapping);
+  CloseHandle(file);
+  mapping = file = nullptr;
+#elif !defined(__ANDROID__)
+  munmap(const_cast<char*>(data), size);
+#endif
+
+  fallback.clear();
+  data = nullptr;
+  size = 0;
+}
+
+const char* MappedFile::Data() const
+{
+  return data;
+}
+
+size_t MappedFile::Size() const
+{
+  return size;
+}
@@ -0,0 +1,44 @@
+/*! \brief Read-only view of a whole file mapped into memory
+ *
+ * The pages are loaded on first access by the OS instead of being copied
+ * into a buffer. Where files cannot be mapped, e.g. assets packed inside an
+ * Android APK, the file is read into memory instead so callers see the same
+ * interface on every platform.
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+
+class MappedFile {
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /**
+   * @brief Maps the file at path. Any previous file is unmapped first.
+   * @return false if the file could not be opened or is empty
+   */
+  bool Open(const std::string& path);
+
+  /**
+   * @brief Unmaps the file. Data() is invalid afterwards.
+   */
+  void Close();
+
+  const char* Data() const;
+  size_t Size() const;
+
+private:
+  const char* data{ nullptr };
+  size_t size{};
+  std::string fallback; /*!< Contents when the file could not be mapped */
+
+#ifdef _WIN32
+  void* file{ nullptr };
+  void* mapping{ nullptr };
+#endif
+};
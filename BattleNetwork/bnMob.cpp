@@ -5,6 +5,7 @@
 #include "bnBattleItem.h"
 #include "bnBackground.h"
 #include "bnField.h"
+#include "bnRandom.h"
 #include <vector>
 #include <map>
 #include <stdexcept>
@@ -50,7 +51,7 @@ BattleItem* Mob::GetRankedReward(int score) {
     return nullptr;
   }
 
-  int random = rand() % possible.size();
+  int random = SyncedRandRange(0, static_cast<int32_t>(possible.size()) - 1);
 
   std::vector<BattleItem>::iterator possibleIter;
   possibleIter = possible.begin();
@@ -0,0 +1,220 @@
+#include "bnPackageFingerprintCache.h"
+#include "bnLogger.h"
+#include "stx/string.h"
+#include "stx/zip_utils.h"
+#include "stx/crypto_utils.h"
+#include "crypto/md5.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace {
+  const char* MANIFEST_HEADER = "# package fingerprints v1";
+}
+
+PackageFingerprintCache& PackageFingerprintCache::Instance()
+{
+  static PackageFingerprintCache cache(BN_PACKAGE_FINGERPRINT_CACHE_PATH);
+  return cache;
+}
+
+PackageFingerprintCache::PackageFingerprintCache(const std::string& path) :
+  path(path)
+{
+}
+
+void PackageFingerprintCache::SetRebuild(bool enabled)
+{
+  std::scoped_lock lock(mutex);
+  rebuild = enabled;
+}
+
+stx::result_t<std::string> PackageFingerprintCache::Fingerprint(const std::string& packagePath)
+{
+  const std::string contentKey = ContentKey(packagePath);
+  const std::string zipPath = packagePath + ".zip";
+
+  {
+    std::scoped_lock lock(mutex);
+    Load();
+
+    auto iter = entries.find(packagePath);
+
+    if (!rebuild && !contentKey.empty() && iter != entries.end()) {
+      const Entry& entry = iter->second;
+      std::error_code error;
+      uintmax_t zipBytes = std::filesystem::file_size(zipPath, error);
+
+      if (!error && entry.contentKey == contentKey && entry.zipPath == zipPath && entry.zipBytes == zipBytes) {
+        reused++;
+        return stx::ok(entry.fingerprint);
+      }
+    }
+  }
+
+  // zip and hash outside of the lock, these are the slow part
+  stx::result_t<bool> zip_result = stx::zip(packagePath, zipPath);
+  if (zip_result.is_error()) {
+    return stx::error<std::string>(zip_result.error_cstr());
+  }
+
+  stx::result_t<std::string> md5_result = stx::generate_md5_from_file(zipPath);
+  if (md5_result.is_error()) {
+    return stx::error<std::string>(md5_result.error_cstr());
+  }
+
+  std::error_code error;
+  uintmax_t zipBytes = std::filesystem::file_size(zipPath, error);
+
+  std::scoped_lock lock(mutex);
+  rebuilt++;
+
+  if (error || contentKey.empty()) {
+    entries.erase(packagePath);
+  }
+  else {
+    entries[packagePath] = Entry{ contentKey, zipPath, zipBytes, md5_result.value() };
+  }
+
+  dirty = true;
+  return md5_result;
+}
+
+void PackageFingerprintCache::Save()
+{
+  std::scoped_lock lock(mutex);
+
+  if (reused || rebuilt) {
+    Logger::Logf(LogLevel::info, "Package fingerprints: %zu unchanged, %zu zipped and hashed", reused, rebuilt);
+    reused = rebuilt = 0;
+  }
+
+  if (!dirty) return;
+
+  for (auto iter = entries.begin(); iter != entries.end();) {
+    std::error_code error;
+    iter = std::filesystem::is_directory(iter->first, error) ? std::next(iter) : entries.erase(iter);
+  }
+
+  std::error_code error;
+  std::filesystem::path manifestPath(path);
+
+  if (manifestPath.has_parent_path()) {
+    std::filesystem::create_directories(manifestPath.parent_path(), error);
+  }
+
+  // write beside the manifest then swap so an interrupted write keeps the old one
+  const std::string temp = path + ".tmp";
+
+  {
+    std::ofstream file(temp, std::ios::trunc);
+
+    if (!file.is_open()) {
+      Logger::Logf(LogLevel::warning, "Could not write package fingerprints to %s", temp.c_str());
+      return;
+    }
+
+    file << MANIFEST_HEADER << '\n';
+
+    for (const auto& [packagePath, entry] : entries) {
+      file << packagePath << '\t' << entry.contentKey << '\t' << entry.zipPath << '\t' << entry.zipBytes << '\t' << entry.fingerprint << '\n';
+    }
+
+    if (!file.good()) {
+      Logger::Logf(LogLevel::warning, "Could not write package fingerprints to %s", temp.c_str());
+      return;
+    }
+  }
+
+  std::filesystem::rename(temp, path, error);
+
+  if (error) {
+    Logger::Logf(LogLevel::warning, "Could not replace %s: %s", path.c_str(), error.message().c_str());
+    return;
+  }
+
+  dirty = false;
+}
+
+std::string PackageFingerprintCache::ContentKey(const std::string& packagePath)
+{
+  std::vector<std::string> files;
+  std::error_code error;
+  std::filesystem::recursive_directory_iterator iter(packagePath, error);
+
+  if (error) return {};
+
+  for (const auto end = std::filesystem::recursive_directory_iterator(); iter != end; iter.increment(error)) {
+    if (error) return {};
+    if (!iter->is_regular_file(error)) continue;
+
+    uintmax_t size = iter->file_size(error);
+    if (error) return {};
+
+    auto modified = iter->last_write_time(error);
+    if (error) return {};
+
+    std::ostringstream line;
+    line << iter->path().lexically_relative(packagePath).generic_string() << '|' << size << '|' << modified.time_since_epoch().count();
+    files.push_back(line.str());
+  }
+
+  // directory iteration order is not specified
+  std::sort(files.begin(), files.end());
+
+  std::string listing;
+
+  for (const std::string& file : files) {
+    listing += file;
+    listing += '\n';
+  }
+
+  std::vector<char> digest(16);
+  MD5(digest.data(), listing.data(), listing.size());
+
+  return stx::as_hex(std::string(digest.data(), digest.size()), 0);
+}
+
+void PackageFingerprintCache::Load()
+{
+  if (loaded) return;
+
+  loaded = true;
+
+  std::ifstream file(path);
+
+  if (!file.is_open()) return;
+
+  std::string line;
+
+  if (!std::getline(file, line) || line != MANIFEST_HEADER) {
+    Logger::Logf(LogLevel::info, "%s is from another version and will be rebuilt", path.c_str());
+    return;
+  }
+
+  while (std::getline(file, line)) {
+    std::istringstream fields(line);
+    std::string packagePath, zipBytes;
+    Entry entry;
+
+    if (!std::getline(fields, packagePath, '\t') ||
+        !std::getline(fields, entry.contentKey, '\t') ||
+        !std::getline(fields, entry.zipPath, '\t') ||
+        !std::getline(fields, zipBytes, '\t') ||
+        !std::getline(fields, entry.fingerprint)) {
+      continue;
+    }
+
+    try {
+      entry.zipBytes = std::stoull(zipBytes);
+    }
+    catch (std::exception&) {
+      continue;
+    }
+
+    entries[packagePath] = entry;
+  }
+}
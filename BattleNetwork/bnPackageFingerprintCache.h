@@ -0,0 +1,66 @@
+/*! \brief Remembers package zips and fingerprints between runs
+ *
+ * Every extracted package is zipped next to its folder so it can be sent to
+ * other players, and the md5 of that zip is its fingerprint. Zipping and
+ * hashing hundreds of packages on every boot is slow, so the result is kept
+ * in a manifest keyed by the folder's file list, sizes and modified times.
+ * A package is zipped and hashed again only when that key changes or its zip
+ * is missing or a different size than the one recorded.
+ *
+ * Manifest lines are tab separated:
+ *   folder, content key, zip path, zip size, fingerprint
+ */
+
+#pragma once
+#include "stx/result.h"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+#define BN_PACKAGE_FINGERPRINT_CACHE_PATH "cache/package_fingerprints.txt"
+
+class PackageFingerprintCache {
+public:
+  static PackageFingerprintCache& Instance();
+
+  /**
+   * @brief If true, cached fingerprints are ignored and every package is zipped and hashed again this run
+   */
+  void SetRebuild(bool enabled);
+
+  /**
+   * @brief Zips a package folder to `<folder>.zip` and returns the md5 of the zip, or the cached md5 if the folder is unchanged
+   */
+  stx::result_t<std::string> Fingerprint(const std::string& packagePath);
+
+  /**
+   * @brief Writes the manifest if anything changed. Folders that no longer exist are dropped.
+   */
+  void Save();
+
+private:
+  struct Entry {
+    std::string contentKey;
+    std::string zipPath;
+    uintmax_t zipBytes{};
+    std::string fingerprint;
+  };
+
+  explicit PackageFingerprintCache(const std::string& path);
+
+  /**
+   * @brief md5 of every file path under the folder with its size and modified time
+   * @return empty if the folder could not be read
+   */
+  static std::string ContentKey(const std::string& packagePath);
+
+  void Load();
+
+  std::mutex mutex;
+  std::string path;
+  bool loaded{ false }, rebuild{ false }, dirty{ false };
+  size_t reused{}, rebuilt{}; /*!< Fingerprints served from the manifest or computed since the last Save() */
+  std::map<std::string, Entry> entries;
+};
@@ -2,6 +2,7 @@
 
 #include "bnPackageAddress.h"
 #include "bnLogger.h"
+#include "bnPackageFingerprintCache.h"
 #include "bnResourceHandle.h"
 #include "bnScriptResourceManager.h"
 #include "bnSolHelpers.h"
@@ -73,6 +74,7 @@ class PackageManager {
         std::string filepath;
         std::string packageId;
         std::string fingerprint;
+        std::vector<std::string> declaredAssets; /*!< Files the package uses in battle, loaded before it starts */
 
         DataType* data{nullptr};
 
@@ -97,6 +99,16 @@ class PackageManager {
           return *(static_cast<MetaClass*>(this));
         }
 
+        /**
+         * @brief Lists a texture or animation file to load before battles using this package
+         *
+         * Packages that declare nothing have their folder searched instead
+         */
+        MetaClass& DeclareAsset(const std::string& path) {
+          declaredAssets.push_back(path);
+          return *(static_cast<MetaClass*>(this));
+        }
+
         const std::string& GetPackageID() const {
           return packageId;
         }
@@ -109,6 +121,10 @@ class PackageManager {
           return fingerprint;
         }
 
+        const std::vector<std::string>& GetDeclaredAssets() const {
+          return declaredAssets;
+        }
+
         DataType* GetData() {
           this->PreGetData();
 
@@ -260,14 +276,8 @@ stx::result_t<std::string> PackageManager<MetaClass>::LoadPackageFromDisk(const
     std::string file_path = modpath.generic_string();
     packageClass->SetFilePath(file_path);
 
-    stx::result_t<bool> zip_result = stx::zip(file_path, file_path + ".zip");
-    if (zip_result.is_error()) {
-      delete packageClass;
-      std::string msg = std::string("Failed to install package `") + packageName + "`. Reason: " + zip_result.error_cstr();
-      return stx::error<std::string>(msg);
-    }
-
-    stx::result_t<std::string> md5_result = stx::generate_md5_from_file(file_path + ".zip");
+    // zips the package to file_path + ".zip" unless it is unchanged since the last run
+    stx::result_t<std::string> md5_result = PackageFingerprintCache::Instance().Fingerprint(file_path);
     if (md5_result.is_error()) {
       delete packageClass;
       std::string msg = std::string("Failed to install package `") + packageName + "`. Reason: " + md5_result.error_cstr();
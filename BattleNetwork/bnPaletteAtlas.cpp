@@ -0,0 +1,111 @@
+#include "bnPaletteAtlas.h"
+#include "bnLogger.h"
+
+#include <algorithm>
+#include <vector>
+
+int PaletteAtlas::Register(const std::shared_ptr<sf::Texture>& palette)
+{
+  if (!palette) return -1;
+
+  std::scoped_lock lock(mutex);
+
+  auto iter = lookup.find(palette.get());
+
+  if (iter != lookup.end()) {
+    // The same address may belong to a new texture after the old one was freed
+    if (rows[iter->second].palette.lock() == palette) {
+      return iter->second;
+    }
+
+    lookup.erase(iter);
+  }
+
+  if (auto iter = rejected.find(palette.get()); iter != rejected.end()) {
+    if (iter->second.lock() == palette) {
+      return -1;
+    }
+
+    rejected.erase(iter);
+  }
+
+  if (!atlas) {
+    atlas = std::make_shared<sf::Texture>();
+
+    if (!atlas->create(BN_PALETTE_ATLAS_WIDTH, BN_PALETTE_ATLAS_ROWS)) {
+      Logger::Log(LogLevel::critical, "Failed to create the palette atlas");
+      atlas.reset();
+      return -1;
+    }
+  }
+
+  for (int i = 0; i < BN_PALETTE_ATLAS_ROWS; i++) {
+    Row& row = rows[i];
+
+    if (!row.palette.expired()) continue;
+
+    if (row.key) {
+      lookup.erase(row.key);
+    }
+
+    if (!WriteRow(i, *palette)) {
+      Reject(palette);
+      return -1;
+    }
+
+    row.key = palette.get();
+    row.palette = palette;
+    lookup[row.key] = i;
+    return i;
+  }
+
+  Logger::Logf(LogLevel::warning, "Palette atlas is full with %i palettes. This palette is bound on its own.", BN_PALETTE_ATLAS_ROWS);
+  Reject(palette);
+  return -1;
+}
+
+float PaletteAtlas::RowCoordinate(int row)
+{
+  return (static_cast<float>(row) + 0.5f) / static_cast<float>(BN_PALETTE_ATLAS_ROWS);
+}
+
+const std::shared_ptr<sf::Texture>& PaletteAtlas::GetTexture() const
+{
+  return atlas;
+}
+
+void PaletteAtlas::Reject(const std::shared_ptr<sf::Texture>& palette)
+{
+  for (auto iter = rejected.begin(); iter != rejected.end();) {
+    iter = iter->second.expired() ? rejected.erase(iter) : std::next(iter);
+  }
+
+  rejected[palette.get()] = palette;
+}
+
+bool PaletteAtlas::WriteRow(int row, const sf::Texture& palette)
+{
+  const sf::Image image = palette.copyToImage();
+  const unsigned width = image.getSize().x;
+
+  if (width == 0 || image.getSize().y == 0) {
+    Logger::Log(LogLevel::warning, "Palette texture is empty and was not added to the atlas");
+    return false;
+  }
+
+  // The shader samples the atlas at u = r / 255 which lands on texel r.
+  // The original texture would have returned texel floor(r / 255 * width).
+  std::vector<sf::Uint8> pixels(BN_PALETTE_ATLAS_WIDTH * 4);
+
+  for (unsigned x = 0; x < BN_PALETTE_ATLAS_WIDTH; x++) {
+    unsigned source = std::min((x * width) / 255u, width - 1u);
+    sf::Color color = image.getPixel(source, 0);
+    pixels[x * 4 + 0] = color.r;
+    pixels[x * 4 + 1] = color.g;
+    pixels[x * 4 + 2] = color.b;
+    pixels[x * 4 + 3] = color.a;
+  }
+
+  atlas->update(pixels.data(), BN_PALETTE_ATLAS_WIDTH, 1, 0, static_cast<unsigned>(row));
+  return true;
+}
@@ -0,0 +1,59 @@
+/*! \brief Packs every palette in use into the rows of one texture
+ *
+ * The battle character shader looks colors up by the red channel of each pixel.
+ * Instead of binding a separate palette texture for every character, each
+ * palette gets a row in this atlas and the shader is given the row to read.
+ * Every character then samples the same texture and only the row changes.
+ *
+ * Rows are resampled to BN_PALETTE_ATLAS_WIDTH texels so the red channel picks
+ * the same color it did from the original texture. A row is reused once the
+ * palette it was made from has been freed.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#define BN_PALETTE_ATLAS_WIDTH 256
+#define BN_PALETTE_ATLAS_ROWS 128
+
+class PaletteAtlas {
+public:
+  /**
+   * @brief Finds or adds the row for a palette texture
+   * @return row index or -1 if the palette could not be added. Such a palette is logged once and not tried again.
+   */
+  int Register(const std::shared_ptr<sf::Texture>& palette);
+
+  /**
+   * @brief Texture coordinate of the center of a row for the shader
+   */
+  static float RowCoordinate(int row);
+
+  /**
+   * @brief The atlas texture. nullptr until the first palette is registered.
+   */
+  const std::shared_ptr<sf::Texture>& GetTexture() const;
+
+private:
+  struct Row {
+    const sf::Texture* key{ nullptr };
+    std::weak_ptr<sf::Texture> palette; /*!< Row is free when this has expired */
+  };
+
+  std::mutex mutex;
+  std::shared_ptr<sf::Texture> atlas;
+  std::array<Row, BN_PALETTE_ATLAS_ROWS> rows;
+  std::unordered_map<const sf::Texture*, int> lookup;
+  std::unordered_map<const sf::Texture*, std::weak_ptr<sf::Texture>> rejected; /*!< Palettes that could not be added */
+
+  bool WriteRow(int row, const sf::Texture& palette);
+
+  /**
+   * @brief Remembers a palette that could not be added so later calls return -1 without logging again
+   */
+  void Reject(const std::shared_ptr<sf::Texture>& palette);
+};
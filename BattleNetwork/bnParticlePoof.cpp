@@ -11,15 +11,23 @@ using sf::IntRect;
 ParticlePoof::ParticlePoof() : 
   Artifact()
 {
-  SetLayer(0);
   setTexture(Textures().LoadFromFile(TexturePaths::SPELL_POOF));
-  setScale(2.f, 2.f);
   poof = getSprite();
 
   //Components setup and load
   animation = Animation(RESOURCE_PATH);
   animation.Reload();
 
+  Reset();
+}
+
+void ParticlePoof::Reset()
+{
+  Artifact::Reset();
+
+  SetLayer(0);
+  setScale(2.f, 2.f);
+
   animation.SetAnimation("DEFAULT");
 
   auto onEnd = [this]() {
@@ -29,7 +37,6 @@ ParticlePoof::ParticlePoof() :
   animation << onEnd;
 
   animation.Update(0, getSprite());
-
 }
 
 void ParticlePoof::OnUpdate(double _elapsed) {
@@ -21,6 +21,11 @@ public:
    */
   ~ParticlePoof();
 
+  /**
+   * @brief Restarts the animation when recycled from an EntityPool
+   */
+  void Reset();
+
   /**
    * @brief plays the animation and deletes when finished 
    * @param _elapsed in seconds
@@ -3,9 +3,9 @@
 #pragma once
 #include <vector>
 #include <cmath>
-#include <random>
 #include <algorithm>
 #include <numeric>
+#include "bnRandom.h"
 
 class PerlinNoise
 {
@@ -33,11 +33,14 @@ public:
   PerlinNoise(unsigned int seed) {
     p.resize(256);
 
-    std::is_permutation(p.begin(), p.end(), 0);
+    std::iota(p.begin(), p.end(), 0);
 
-    std::default_random_engine engine(seed);
+    // Fisher-Yates with our own generator, std::shuffle is not the same on every platform
+    RandomGenerator generator(seed);
 
-    std::shuffle(p.begin(), p.end(), engine);
+    for (int i = static_cast<int>(p.size()) - 1; i > 0; i--) {
+      std::swap(p[i], p[generator.NextRange(0, i)]);
+    }
 
     p.insert(p.end(), p.begin(), p.end());
   }
@@ -60,7 +63,7 @@ public:
     double v = Fade(y);
     double w = Fade(z);
 
-    std::vector<int>& p = p;
+    std::vector<int>& p = this->p;
 
     // Hash coordinates of the 8 cube corners
     int A = p[X] + Y;
@@ -110,7 +110,6 @@ void PlayerSelectedCardsUI::draw(sf::RenderTarget& target, sf::RenderStates stat
         target.draw(frame, states);
 
         // Grab the ID of the card and draw that icon from the spritesheet
-        std::shared_ptr<sf::Texture> texture;
         std::string id = selectedCards[drawOrderIndex].GetUUID();
         stx::result_t<PackageAddress> maybe_addr = PackageAddress::FromStr(id);
         bool found = false;
@@ -120,8 +119,9 @@ void PlayerSelectedCardsUI::draw(sf::RenderTarget& target, sf::RenderStates stat
 
           if (SelectedCardsUI::partition->HasPackage(addr)) {
             CardPackageManager& packages = SelectedCardsUI::partition->GetPartition(addr.namespaceId);
-            texture = packages.FindPackageByID(id).GetIconTexture();
-            icon.setTexture(texture);
+            const TextureRegion& region = packages.FindPackageByID(id).GetIconRegion();
+            icon.setTexture(region.texture, false);
+            icon.setTextureRect(region.rect);
           }
           else {
             icon.setTexture(noIcon);
@@ -0,0 +1,277 @@
+#include "bnProfiler.h"
+#include "bnLogger.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace {
+  using ProfileClock = std::chrono::steady_clock;
+
+  const ProfileClock::time_point epoch = ProfileClock::now();
+
+  //!< A zone in a ring buffer. Atomic so other threads can copy it while the owner overwrites it.
+  struct ZoneSlot {
+    std::atomic<const char*> name{ nullptr };
+    std::atomic<int64_t> start{}, end{};
+    std::atomic<uint32_t> frame{};
+    std::atomic<uint16_t> depth{};
+  };
+
+  //!< Ring buffer of zones recorded by a single thread. Only the owner writes, readers copy without locking.
+  struct ThreadLog {
+    std::unique_ptr<ZoneSlot[]> slots;
+    std::atomic<size_t> head{}; // total number of zones ever written
+    uint32_t threadId{};
+    uint16_t depth{};
+
+    ThreadLog(uint32_t threadId) : threadId(threadId) {
+      slots = std::make_unique<ZoneSlot[]>(BN_PROFILER_ZONES_PER_THREAD);
+    }
+
+    void Write(const Profiler::Zone& zone) {
+      size_t index = head.load(std::memory_order_relaxed);
+      ZoneSlot& slot = slots[index % BN_PROFILER_ZONES_PER_THREAD];
+
+      // a reader that sees any of the stores below also sees head at index or later
+      std::atomic_thread_fence(std::memory_order_release);
+      slot.name.store(zone.name, std::memory_order_relaxed);
+      slot.start.store(zone.start, std::memory_order_relaxed);
+      slot.end.store(zone.end, std::memory_order_relaxed);
+      slot.frame.store(zone.frame, std::memory_order_relaxed);
+      slot.depth.store(zone.depth, std::memory_order_relaxed);
+      head.store(index + 1, std::memory_order_release);
+    }
+
+    //!< Copies the buffered zones, oldest first, leaving out any the owner overwrote during the copy
+    std::vector<Profiler::Zone> Copy() const {
+      size_t end = head.load(std::memory_order_acquire);
+      size_t begin = end - std::min<size_t>(end, BN_PROFILER_ZONES_PER_THREAD);
+      std::vector<Profiler::Zone> zones;
+      zones.reserve(end - begin);
+
+      for (size_t i = begin; i < end; i++) {
+        const ZoneSlot& slot = slots[i % BN_PROFILER_ZONES_PER_THREAD];
+        Profiler::Zone zone;
+        zone.name = slot.name.load(std::memory_order_relaxed);
+        zone.start = slot.start.load(std::memory_order_relaxed);
+        zone.end = slot.end.load(std::memory_order_relaxed);
+        zone.frame = slot.frame.load(std::memory_order_relaxed);
+        zone.depth = slot.depth.load(std::memory_order_relaxed);
+        zones.push_back(zone);
+      }
+
+      // the slot for zone i is reused by zone i + BN_PROFILER_ZONES_PER_THREAD
+      std::atomic_thread_fence(std::memory_order_acquire);
+      size_t written = head.load(std::memory_order_relaxed);
+
+      if (written >= begin + BN_PROFILER_ZONES_PER_THREAD) {
+        size_t overwritten = std::min(written - BN_PROFILER_ZONES_PER_THREAD + 1 - begin, zones.size());
+        zones.erase(zones.begin(), zones.begin() + overwritten);
+      }
+
+      return zones;
+    }
+  };
+
+  // Logs are never freed so zones from threads that have exited can still be exported
+  std::mutex registryMutex;
+  std::vector<std::unique_ptr<ThreadLog>> registry;
+
+  std::mutex frameMutex;
+  std::array<Profiler::Frame, BN_PROFILER_FRAME_HISTORY> frameHistory;
+  size_t frameHead{}; // total number of frames ever completed
+  Profiler::Frame currentFrame;
+  ThreadLog* frameThreadLog{ nullptr };
+  std::atomic<uint32_t> frameIndex{ 0 };
+  std::vector<std::pair<const char*, int64_t>> counters;
+
+  ThreadLog& LocalLog() {
+    thread_local ThreadLog* log = nullptr;
+
+    if (!log) {
+      std::lock_guard lock(registryMutex);
+      registry.push_back(std::make_unique<ThreadLog>(static_cast<uint32_t>(registry.size())));
+      log = registry.back().get();
+    }
+
+    return *log;
+  }
+
+  void WriteJsonString(std::ofstream& out, const char* str) {
+    out << '"';
+
+    for (; str && *str; str++) {
+      if (*str == '"' || *str == '\\') {
+        out << '\\';
+      }
+
+      out << *str;
+    }
+
+    out << '"';
+  }
+}
+
+std::atomic<bool> Profiler::enabled{ false };
+
+void Profiler::SetEnabled(bool enabled)
+{
+  if (enabled && !IsEnabled()) {
+    // Frames are not closed while disabled, do not record one that spans the gap
+    std::lock_guard lock(frameMutex);
+    currentFrame.start = 0;
+  }
+
+  Profiler::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::IsEnabled()
+{
+  return enabled.load(std::memory_order_relaxed);
+}
+
+int64_t Profiler::Now()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(ProfileClock::now() - epoch).count();
+}
+
+int64_t Profiler::Enter()
+{
+  LocalLog().depth++;
+  return Now();
+}
+
+void Profiler::Leave(const char* name, int64_t start)
+{
+  int64_t end = Now();
+  ThreadLog& log = LocalLog();
+  log.depth--;
+
+  Zone zone;
+  zone.name = name;
+  zone.start = start;
+  zone.end = end;
+  zone.frame = frameIndex.load(std::memory_order_relaxed);
+  zone.depth = log.depth;
+  log.Write(zone);
+}
+
+void Profiler::BeginFrame()
+{
+  if (!IsEnabled()) return;
+
+  int64_t now = Now();
+  ThreadLog& log = LocalLog();
+
+  std::lock_guard lock(frameMutex);
+
+  // The first frame after enabling has no start time
+  if (frameThreadLog == &log && currentFrame.start > 0) {
+    currentFrame.end = now;
+    frameHistory[frameHead % frameHistory.size()] = currentFrame;
+    frameHead++;
+  }
+
+  frameThreadLog = &log;
+  currentFrame.index = frameIndex.fetch_add(1, std::memory_order_relaxed) + 1u;
+  currentFrame.start = now;
+}
+
+void Profiler::SetCounter(const char* name, int64_t value)
+{
+  if (!IsEnabled()) return;
+
+  std::lock_guard lock(frameMutex);
+
+  for (auto& counter : counters) {
+    if (std::strcmp(counter.first, name) == 0) {
+      counter.second = value;
+      return;
+    }
+  }
+
+  counters.emplace_back(name, value);
+}
+
+std::vector<std::pair<const char*, int64_t>> Profiler::Counters()
+{
+  std::lock_guard lock(frameMutex);
+  return counters;
+}
+
+std::vector<Profiler::Frame> Profiler::RecentFrames()
+{
+  std::lock_guard lock(frameMutex);
+
+  size_t count = std::min(frameHead, frameHistory.size());
+  std::vector<Frame> frames;
+  frames.reserve(count);
+
+  for (size_t i = frameHead - count; i < frameHead; i++) {
+    frames.push_back(frameHistory[i % frameHistory.size()]);
+  }
+
+  return frames;
+}
+
+std::vector<Profiler::Zone> Profiler::FrameZones(uint32_t firstFrame)
+{
+  ThreadLog* log = nullptr;
+
+  {
+    std::lock_guard lock(frameMutex);
+    log = frameThreadLog;
+  }
+
+  std::vector<Zone> zones;
+
+  if (!log) return zones;
+
+  for (const Zone& zone : log->Copy()) {
+    if (zone.frame >= firstFrame) {
+      zones.push_back(zone);
+    }
+  }
+
+  return zones;
+}
+
+bool Profiler::ExportChromeTrace(const std::string& path)
+{
+  std::ofstream out(path);
+
+  if (!out.is_open()) {
+    Logger::Logf(LogLevel::critical, "Could not open %s to write the profiler trace", path.c_str());
+    return false;
+  }
+
+  size_t zoneCount = 0;
+  bool first = true;
+
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+  std::lock_guard registryLock(registryMutex);
+
+  for (std::unique_ptr<ThreadLog>& log : registry) {
+    for (const Zone& zone : log->Copy()) {
+      out << (first ? "\n" : ",\n");
+      out << "{\"name\":";
+      WriteJsonString(out, zone.name);
+      out << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << log->threadId;
+      out << ",\"ts\":" << zone.start << ",\"dur\":" << (zone.end - zone.start);
+      out << ",\"args\":{\"frame\":" << zone.frame << "}}";
+      first = false;
+      zoneCount++;
+    }
+  }
+
+  out << "\n]}\n";
+
+  Logger::Logf(LogLevel::info, "Wrote %d profiler zones to %s", static_cast<int>(zoneCount), path.c_str());
+  return out.good();
+}
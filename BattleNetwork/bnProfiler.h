@@ -0,0 +1,125 @@
+/*! \brief Scoped timing zones for finding where frame time goes
+ *
+ * Wrap any block in BN_PROFILE_ZONE("Name") to time it. When the profiler is
+ * disabled a zone costs one relaxed atomic load. When enabled, each zone
+ * appends its start and end time to a ring buffer owned by the calling thread
+ * without taking a lock. The overlay and exporter copy and merge the buffers
+ * only when they read them.
+ *
+ * The thread that calls BeginFrame() is the frame thread. The last
+ * BN_PROFILER_FRAME_HISTORY frame boundaries are kept so the overlay can
+ * show what each recent frame was spent on. Every zone still in the ring
+ * buffers can be exported to the Chrome trace JSON format and opened in
+ * chrome://tracing or Perfetto.
+ *
+ * Zone names must be string literals or otherwise outlive the profiler.
+ * Set BN_ENABLE_PROFILER to 0 to compile all zones out.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define BN_ENABLE_PROFILER 1
+#define BN_PROFILER_FRAME_HISTORY 120
+#define BN_PROFILER_ZONES_PER_THREAD 16384
+
+#define BN_PROFILE_CONCAT_INNER(a, b) a##b
+#define BN_PROFILE_CONCAT(a, b) BN_PROFILE_CONCAT_INNER(a, b)
+
+#if BN_ENABLE_PROFILER
+#define BN_PROFILE_ZONE(name) Profiler::Scope BN_PROFILE_CONCAT(profileZone, __LINE__){ name }
+#else
+#define BN_PROFILE_ZONE(name) (void)0
+#endif
+
+class Profiler {
+public:
+  struct Zone {
+    const char* name{ nullptr };
+    int64_t start{}, end{}; /*!< Microseconds since the profiler was first used */
+    uint32_t frame{}; /*!< Frame the zone ended on */
+    uint16_t depth{}; /*!< Number of zones this zone is nested in */
+  };
+
+  struct Frame {
+    uint32_t index{};
+    int64_t start{}, end{};
+  };
+
+  /**
+   * @brief Times the enclosing scope. Use BN_PROFILE_ZONE instead of constructing directly.
+   */
+  class Scope {
+    const char* name{ nullptr };
+    int64_t start{};
+    bool active{ false };
+
+  public:
+    explicit Scope(const char* name) : name(name) {
+      if (Profiler::enabled.load(std::memory_order_relaxed)) {
+        active = true;
+        start = Profiler::Enter();
+      }
+    }
+
+    ~Scope() {
+      if (active) {
+        Profiler::Leave(name, start);
+      }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+  };
+
+  static void SetEnabled(bool enabled);
+  static bool IsEnabled();
+
+  /**
+   * @brief Closes the current frame and starts the next one. Call once per frame from the main loop.
+   */
+  static void BeginFrame();
+
+  /**
+   * @brief Completed frames from oldest to newest, at most BN_PROFILER_FRAME_HISTORY
+   */
+  static std::vector<Frame> RecentFrames();
+
+  /**
+   * @brief Zones the frame thread recorded on or after frame `firstFrame` in the order they ended
+   */
+  static std::vector<Zone> FrameZones(uint32_t firstFrame);
+
+  /**
+   * @brief Records a per-frame statistic such as a draw call count. Does nothing while disabled.
+   * @param name must outlive the profiler like zone names
+   */
+  static void SetCounter(const char* name, int64_t value);
+
+  /**
+   * @brief Most recent value of every counter in the order they were first set
+   */
+  static std::vector<std::pair<const char*, int64_t>> Counters();
+
+  /**
+   * @brief Writes every buffered zone of every thread to disk
+   * @param path output file. Open it with chrome://tracing or Perfetto.
+   * @return false if the file could not be written
+   */
+  static bool ExportChromeTrace(const std::string& path);
+
+  /**
+   * @brief Microseconds since the profiler was first used
+   */
+  static int64_t Now();
+
+private:
+  static std::atomic<bool> enabled;
+
+  static int64_t Enter();
+  static void Leave(const char* name, int64_t start);
+};
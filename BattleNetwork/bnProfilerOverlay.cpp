@@ -0,0 +1,144 @@
+#include "bnProfilerOverlay.h"
+#include "bnProfiler.h"
+#include "frame_time_t.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <unordered_map>
+
+#define PROFILER_OVERLAY_BAR_HEIGHT 40.0f
+#define PROFILER_OVERLAY_ROW_HEIGHT 6.0f
+#define PROFILER_OVERLAY_MAX_DEPTH 8
+#define PROFILER_OVERLAY_LEGEND_SIZE 6
+
+namespace {
+  // Time budget of one frame in microseconds
+  const double frameBudget = 1000000.0 / frame_time_t::frames_per_second;
+
+  void AddQuad(sf::VertexArray& vertices, sf::FloatRect rect, sf::Color color) {
+    vertices.append(sf::Vertex({ rect.left, rect.top }, color));
+    vertices.append(sf::Vertex({ rect.left + rect.width, rect.top }, color));
+    vertices.append(sf::Vertex({ rect.left + rect.width, rect.top + rect.height }, color));
+    vertices.append(sf::Vertex({ rect.left, rect.top + rect.height }, color));
+  }
+
+  // Same zone gets the same color every frame
+  sf::Color ZoneColor(const char* name) {
+    size_t hash = std::hash<std::string>{}(name ? name : "");
+    return sf::Color(
+      static_cast<sf::Uint8>(100 + (hash & 0x7F)),
+      static_cast<sf::Uint8>(100 + ((hash >> 8) & 0x7F)),
+      static_cast<sf::Uint8>(100 + ((hash >> 16) & 0x7F)),
+      200
+    );
+  }
+}
+
+ProfilerOverlay::ProfilerOverlay(const sf::Vector2f& size) :
+  history(sf::Quads),
+  flame(sf::Quads),
+  frameLabel(Font::Style::tiny),
+  size(size)
+{
+  frameLabel.setPosition(2.0f, 2.0f);
+}
+
+void ProfilerOverlay::Update()
+{
+  history.clear();
+  flame.clear();
+  legend.clear();
+
+  std::vector<Profiler::Frame> frames = Profiler::RecentFrames();
+
+  if (frames.empty()) {
+    frameLabel.SetString("profiler: waiting for frames");
+    return;
+  }
+
+  // History strip along the bottom, full height is two frame budgets
+  const float barWidth = size.x / BN_PROFILER_FRAME_HISTORY;
+  const float barBottom = size.y;
+
+  AddQuad(history, { 0.0f, barBottom - PROFILER_OVERLAY_BAR_HEIGHT, size.x, PROFILER_OVERLAY_BAR_HEIGHT }, sf::Color(0, 0, 0, 150));
+
+  double totalTime = 0;
+  for (size_t i = 0; i < frames.size(); i++) {
+    double duration = static_cast<double>(frames[i].end - frames[i].start);
+    float height = static_cast<float>(std::min(duration / (frameBudget * 2.0), 1.0)) * PROFILER_OVERLAY_BAR_HEIGHT;
+    sf::Color color = duration > frameBudget ? sf::Color(230, 60, 60) : sf::Color(60, 200, 90);
+
+    // Newest frame is on the right
+    float x = size.x - (frames.size() - i) * barWidth;
+    AddQuad(history, { x, barBottom - height, barWidth - 1.0f, height }, color);
+    totalTime += duration;
+  }
+
+  // Budget line halfway up the strip
+  AddQuad(history, { 0.0f, barBottom - PROFILER_OVERLAY_BAR_HEIGHT * 0.5f, size.x, 1.0f }, sf::Color(255, 255, 255, 120));
+
+  const Profiler::Frame& last = frames.back();
+  const double lastDuration = static_cast<double>(std::max<int64_t>(last.end - last.start, 1));
+
+  char label[64];
+  std::snprintf(label, sizeof(label), "frame %.2fms avg %.2fms", lastDuration / 1000.0, totalTime / frames.size() / 1000.0);
+  frameLabel.SetString(label);
+
+  // Flame graph of the most recent frame above the history strip
+  const float flameTop = barBottom - PROFILER_OVERLAY_BAR_HEIGHT - PROFILER_OVERLAY_ROW_HEIGHT * PROFILER_OVERLAY_MAX_DEPTH - 4.0f;
+  std::unordered_map<const char*, int64_t> totals;
+
+  for (const Profiler::Zone& zone : Profiler::FrameZones(frames.front().index)) {
+    if (zone.frame > last.index) continue;
+
+    totals[zone.name] += zone.end - zone.start;
+
+    if (zone.frame != last.index || zone.depth >= PROFILER_OVERLAY_MAX_DEPTH) continue;
+
+    float x = static_cast<float>((zone.start - last.start) / lastDuration) * size.x;
+    float width = static_cast<float>((zone.end - zone.start) / lastDuration) * size.x;
+    float y = flameTop + zone.depth * PROFILER_OVERLAY_ROW_HEIGHT;
+    AddQuad(flame, { std::max(x, 0.0f), y, std::max(width, 1.0f), PROFILER_OVERLAY_ROW_HEIGHT - 1.0f }, ZoneColor(zone.name));
+  }
+
+  // Legend of the slowest zones on average
+  std::vector<std::pair<const char*, int64_t>> sorted(totals.begin(), totals.end());
+  std::sort(sorted.begin(), sorted.end(), [](auto& a, auto& b) { return a.second > b.second; });
+  sorted.resize(std::min<size_t>(sorted.size(), PROFILER_OVERLAY_LEGEND_SIZE));
+
+  float y = 12.0f;
+  for (auto& [name, total] : sorted) {
+    std::snprintf(label, sizeof(label), "%s %.2fms", name, total / static_cast<double>(frames.size()) / 1000.0);
+
+    Text text(Font::Style::tiny);
+    text.SetString(label);
+    text.SetColor(ZoneColor(name));
+    text.setPosition(2.0f, y);
+    legend.push_back(text);
+    y += 10.0f;
+  }
+
+  // Counters are listed under the zones
+  for (auto& [name, value] : Profiler::Counters()) {
+    std::snprintf(label, sizeof(label), "%s %lld", name, static_cast<long long>(value));
+
+    Text text(Font::Style::tiny);
+    text.SetString(label);
+    text.setPosition(2.0f, y);
+    legend.push_back(text);
+    y += 10.0f;
+  }
+}
+
+void ProfilerOverlay::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+  states.transform *= getTransform();
+  target.draw(history, states);
+  target.draw(flame, states);
+  target.draw(frameLabel, states);
+
+  for (const Text& text : legend) {
+    target.draw(text, states);
+  }
+}
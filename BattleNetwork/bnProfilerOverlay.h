@@ -0,0 +1,32 @@
+/*! \brief Draws the profiler's recent frames on top of the game
+ *
+ * The bottom strip is a bar per frame for the last BN_PROFILER_FRAME_HISTORY
+ * frames. Bars turn red when a frame takes longer than the 60 fps budget.
+ * Above it is a flame graph of the most recent frame: each zone is a box as
+ * wide as its share of the frame and nested zones are stacked below their
+ * parents. The legend lists the slowest zones averaged over the history
+ * followed by the latest value of each counter.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+#include "bnText.h"
+
+class ProfilerOverlay : public sf::Drawable, public sf::Transformable {
+  sf::VertexArray history, flame;
+  std::vector<Text> legend;
+  Text frameLabel;
+  sf::Vector2f size;
+
+public:
+  ProfilerOverlay(const sf::Vector2f& size);
+
+  /**
+   * @brief Rebuilds the graphs from the profiler's recent frames
+   */
+  void Update();
+
+  void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+};
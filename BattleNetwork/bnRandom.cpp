@@ -1,23 +1,150 @@
 #include "bnRandom.h"
-#include <random>
 
-// same as std::mt19937, but using uint32_t instead of uint32_fast_t
-static std::mersenne_twister_engine<
-  uint32_t, 32, 624, 397, 31,
-  0x9908b0df, 11,
-  0xffffffff, 7,
-  0x9d2c5680, 15,
-  0xefc60000, 18, 1812433253
-> randomGenerator;
+namespace {
+  inline uint32_t RotateLeft(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+  }
+
+  inline uint64_t SplitMix64(uint64_t& x) {
+    uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  }
+
+  // xoshiro128** step on a local copy so bulk generation stays in registers
+  inline uint32_t Step(uint32_t& s0, uint32_t& s1, uint32_t& s2, uint32_t& s3) {
+    const uint32_t result = RotateLeft(s1 * 5, 7) * 9;
+    const uint32_t t = s1 << 9;
+
+    s2 ^= s0;
+    s3 ^= s1;
+    s1 ^= s2;
+    s0 ^= s3;
+    s2 ^= t;
+    s3 = RotateLeft(s3, 11);
+
+    return result;
+  }
+
+  RandomGenerator randomGenerator;
+}
+
+RandomGenerator::RandomGenerator(uint32_t seed)
+{
+  Seed(seed);
+}
+
+void RandomGenerator::Seed(uint32_t seed)
+{
+  this->seed = seed;
+
+  uint64_t x = seed;
+  uint64_t a = SplitMix64(x);
+  uint64_t b = SplitMix64(x);
+
+  state[0] = static_cast<uint32_t>(a);
+  state[1] = static_cast<uint32_t>(a >> 32);
+  state[2] = static_cast<uint32_t>(b);
+  state[3] = static_cast<uint32_t>(b >> 32);
+}
+
+uint32_t RandomGenerator::GetSeed() const
+{
+  return seed;
+}
+
+uint32_t RandomGenerator::Next()
+{
+  return Step(state[0], state[1], state[2], state[3]);
+}
+
+int32_t RandomGenerator::NextRange(int32_t min, int32_t max)
+{
+  if (max <= min) return min;
+
+  // Lemire's multiply and reject method
+  const uint32_t range = static_cast<uint32_t>(static_cast<int64_t>(max) - min) + 1u;
+
+  // The full 32-bit range needs no reduction
+  if (range == 0) {
+    return static_cast<int32_t>(Next());
+  }
+
+  uint64_t m = static_cast<uint64_t>(Next()) * range;
+  uint32_t low = static_cast<uint32_t>(m);
+
+  if (low < range) {
+    const uint32_t threshold = (0u - range) % range;
+
+    while (low < threshold) {
+      m = static_cast<uint64_t>(Next()) * range;
+      low = static_cast<uint32_t>(m);
+    }
+  }
+
+  return static_cast<int32_t>(static_cast<int64_t>(min) + static_cast<int64_t>(m >> 32));
+}
+
+float RandomGenerator::NextFloat()
+{
+  // top 24 bits fill a float mantissa exactly
+  return (Next() >> 8) * (1.0f / 16777216.0f);
+}
+
+void RandomGenerator::Fill(uint32_t* out, size_t count)
+{
+  uint32_t s0 = state[0], s1 = state[1], s2 = state[2], s3 = state[3];
+
+  for (size_t i = 0; i < count; i++) {
+    out[i] = Step(s0, s1, s2, s3);
+  }
+
+  state = { s0, s1, s2, s3 };
+}
+
+const RandomGenerator::State& RandomGenerator::GetState() const
+{
+  return state;
+}
+
+void RandomGenerator::SetState(const State& state)
+{
+  this->state = state;
+}
+
+uint64_t RandomGenerator::Checksum() const
+{
+  uint64_t hash = 14695981039346656037ull;
+
+  for (uint32_t word : state) {
+    hash ^= word;
+    hash *= 1099511628211ull;
+  }
+
+  return hash;
+}
+
+RandomGenerator& SyncedRandomGenerator() {
+  return randomGenerator;
+}
 
 uint32_t SyncedRand() {
-  return randomGenerator();
+  return randomGenerator.Next();
 }
 
 uint32_t SyncedRandMax() {
-  return randomGenerator.max();
+  return RandomGenerator::Max();
+}
+
+int32_t SyncedRandRange(int32_t min, int32_t max) {
+  return randomGenerator.NextRange(min, max);
+}
+
+float SyncedRandFloat() {
+  return randomGenerator.NextFloat();
 }
 
 void SeedSyncedRand(uint32_t seed) {
-  randomGenerator.seed(seed);
+  randomGenerator.Seed(seed);
 }
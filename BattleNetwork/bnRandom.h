@@ -1,8 +1,66 @@
 #pragma once
+#include <array>
+#include <cstddef>
 #include <cstdint>
 
+/**
+ * @class RandomGenerator
+ * @brief xoshiro128** pseudo random number generator
+ *
+ * Produces the same sequence on every platform and compiler for the same seed,
+ * unlike the std engines and distributions whose algorithms are implementation defined.
+ * The full state is four 32-bit words so it can be saved, restored, and hashed
+ * as part of a battle snapshot.
+ */
+class RandomGenerator {
+public:
+  using State = std::array<uint32_t, 4>;
+
+  RandomGenerator(uint32_t seed = 0);
+
+  /**
+   * @brief Expands a 32-bit seed into the full state with splitmix64
+   */
+  void Seed(uint32_t seed);
+  uint32_t GetSeed() const;
+
+  uint32_t Next();
+  static constexpr uint32_t Max() { return UINT32_MAX; }
+
+  /**
+   * @brief Unbiased integer in [min, max]
+   */
+  int32_t NextRange(int32_t min, int32_t max);
+
+  /**
+   * @brief Float in [0, 1)
+   */
+  float NextFloat();
+
+  /**
+   * @brief Writes `count` values at once. Faster than calling Next() in a loop.
+   */
+  void Fill(uint32_t* out, size_t count);
+
+  const State& GetState() const;
+  void SetState(const State& state);
+
+  /**
+   * @brief 64-bit hash of the current state for desync checks
+   */
+  uint64_t Checksum() const;
+
+private:
+  uint32_t seed{};
+  State state{};
+};
+
 // for random values that need to be synced, use these in lockstep only where necessary
+// these draw from the battle's generator which is seeded by Game::SeedRand() e.g. from the PVP handshake
 
+RandomGenerator& SyncedRandomGenerator();
 uint32_t SyncedRand();
 uint32_t SyncedRandMax();
+int32_t SyncedRandRange(int32_t min, int32_t max);
+float SyncedRandFloat();
 void SeedSyncedRand(uint32_t seed);
@@ -0,0 +1,137 @@
+#include "bnRenderQueue.h"
+#include <algorithm>
+#include <cmath>
+
+void RenderQueue::Push(uint64_t depth, const sf::Sprite& sprite, sf::RenderStates states)
+{
+  const sf::Texture* texture = sprite.getTexture();
+
+  if (!texture) return;
+
+  if (states.shader) {
+    // uniforms are applied per draw, this sprite cannot share a batch
+    Push(depth, static_cast<const sf::Drawable&>(sprite), states);
+    return;
+  }
+
+  const sf::IntRect rect = sprite.getTextureRect();
+  const sf::Color color = sprite.getColor();
+  const float width = static_cast<float>(std::abs(rect.width));
+  const float height = static_cast<float>(std::abs(rect.height));
+  const float left = static_cast<float>(rect.left);
+  const float right = left + rect.width;
+  const float top = static_cast<float>(rect.top);
+  const float bottom = top + rect.height;
+
+  const sf::Transform transform = states.transform * sprite.getTransform();
+
+  Item item;
+  item.depth = depth;
+  item.sequence = static_cast<uint32_t>(items.size());
+  item.vertex = static_cast<uint32_t>(spriteVertices.size());
+  item.states.texture = texture;
+  item.states.blendMode = states.blendMode;
+  items.push_back(item);
+
+  const sf::Vertex topLeft(transform.transformPoint(0.f, 0.f), color, { left, top });
+  const sf::Vertex topRight(transform.transformPoint(width, 0.f), color, { right, top });
+  const sf::Vertex bottomLeft(transform.transformPoint(0.f, height), color, { left, bottom });
+  const sf::Vertex bottomRight(transform.transformPoint(width, height), color, { right, bottom });
+
+  spriteVertices.push_back(topLeft);
+  spriteVertices.push_back(topRight);
+  spriteVertices.push_back(bottomLeft);
+  spriteVertices.push_back(bottomLeft);
+  spriteVertices.push_back(topRight);
+  spriteVertices.push_back(bottomRight);
+}
+
+void RenderQueue::Push(uint64_t depth, const sf::Drawable& drawable, sf::RenderStates states)
+{
+  Item item;
+  item.depth = depth;
+  item.sequence = static_cast<uint32_t>(items.size());
+  item.drawable = &drawable;
+  item.states = states;
+  items.push_back(item);
+}
+
+void RenderQueue::Push(uint64_t depth, std::function<void(sf::RenderTarget&)> callback)
+{
+  Item item;
+  item.depth = depth;
+  item.sequence = static_cast<uint32_t>(items.size());
+  item.callback = callbacks.size();
+  items.push_back(item);
+  callbacks.push_back(std::move(callback));
+}
+
+void RenderQueue::Flush(sf::RenderTarget& target)
+{
+  stats = Stats{};
+  stats.items = items.size();
+
+  std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+    if (a.depth != b.depth) return a.depth < b.depth;
+    if (a.states.shader != b.states.shader) return a.states.shader < b.states.shader;
+    if (a.states.texture != b.states.texture) return a.states.texture < b.states.texture;
+    return a.sequence < b.sequence;
+  });
+
+  batch.clear();
+  sf::RenderStates batchStates;
+
+  for (const Item& item : items) {
+    const bool isSprite = !item.drawable && item.callback == SIZE_MAX;
+
+    if (isSprite) {
+      stats.sprites++;
+
+      if (batch.getVertexCount() &&
+        (batchStates.texture != item.states.texture || !(batchStates.blendMode == item.states.blendMode))) {
+        DrawBatch(target, batchStates);
+      }
+
+      batchStates = item.states;
+
+      for (uint32_t i = 0; i < 6; i++) {
+        batch.append(spriteVertices[item.vertex + i]);
+      }
+
+      continue;
+    }
+
+    if (batch.getVertexCount()) {
+      DrawBatch(target, batchStates);
+    }
+
+    if (item.drawable) {
+      target.draw(*item.drawable, item.states);
+    }
+    else {
+      callbacks[item.callback](target);
+    }
+
+    stats.drawCalls++;
+  }
+
+  if (batch.getVertexCount()) {
+    DrawBatch(target, batchStates);
+  }
+
+  items.clear();
+  spriteVertices.clear();
+  callbacks.clear();
+}
+
+const RenderQueue::Stats& RenderQueue::GetStats() const
+{
+  return stats;
+}
+
+void RenderQueue::DrawBatch(sf::RenderTarget& target, const sf::RenderStates& states)
+{
+  target.draw(batch, states);
+  batch.clear();
+  stats.drawCalls++;
+}
@@ -0,0 +1,83 @@
+/*! \brief Collects draw items for a pass and submits them in as few draw calls as possible
+ *
+ * Items are pushed with a depth and flushed in depth order. Items that share a
+ * depth do not overlap and may be reordered, so they are sorted by shader and
+ * texture to put identical state next to each other.
+ *
+ * Plain sprites with no shader are transformed on the CPU when pushed and
+ * consecutive sprites with the same texture and blend mode are merged into
+ * one vertex array. Anything else is kept as a drawable and drawn as-is when
+ * flushed. Drawables must outlive the call to Flush() and are drawn with the
+ * state they have at that time, so put per-item offsets in the render states
+ * instead of moving the drawable.
+ *
+ * Buffers are kept between frames so a steady scene does not allocate.
+ */
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+class RenderQueue {
+public:
+  struct Stats {
+    size_t items{}; /*!< Items pushed before the last flush */
+    size_t sprites{}; /*!< How many of those items were batchable sprites */
+    size_t drawCalls{}; /*!< Submissions made by the queue. A drawable counts as one. */
+  };
+
+  /**
+   * @brief Queues a sprite. Batched with its neighbors unless `states` has a shader.
+   */
+  void Push(uint64_t depth, const sf::Sprite& sprite, sf::RenderStates states = sf::RenderStates::Default);
+
+  /**
+   * @brief Queues any drawable. Never batched.
+   */
+  void Push(uint64_t depth, const sf::Drawable& drawable, sf::RenderStates states = sf::RenderStates::Default);
+
+  /**
+   * @brief Queues a callback for draws that need to touch the target or their own state when flushed
+   */
+  void Push(uint64_t depth, std::function<void(sf::RenderTarget&)> callback);
+
+  /**
+   * @brief Draws every queued item in order and empties the queue
+   */
+  void Flush(sf::RenderTarget& target);
+
+  /**
+   * @brief Numbers from the most recent Flush()
+   */
+  const Stats& GetStats() const;
+
+  /**
+   * @brief Builds a depth from a pass, a group within the pass, and an order within the group
+   * @param pass 16 bits
+   * @param group 24 bits
+   * @param order 24 bits
+   */
+  static constexpr uint64_t Depth(uint64_t pass, uint64_t group = 0, uint64_t order = 0) {
+    return ((pass & 0xFFFF) << 48) | ((group & 0xFFFFFF) << 24) | (order & 0xFFFFFF);
+  }
+
+private:
+  struct Item {
+    uint64_t depth{};
+    uint32_t sequence{}; /*!< Push order, keeps the sort stable */
+    uint32_t vertex{}; /*!< First of 6 vertices for sprites */
+    const sf::Drawable* drawable{ nullptr };
+    size_t callback{ SIZE_MAX };
+    sf::RenderStates states;
+  };
+
+  std::vector<Item> items;
+  std::vector<sf::Vertex> spriteVertices;
+  std::vector<std::function<void(sf::RenderTarget&)>> callbacks;
+  sf::VertexArray batch{ sf::Triangles };
+  Stats stats;
+
+  void DrawBatch(sf::RenderTarget& target, const sf::RenderStates& states);
+};
@@ -0,0 +1,199 @@
+#pragma once
+#include "bnCachedResource.h"
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+/*! \brief Counters of a ResourceCache since it was made */
+struct ResourceCacheStats {
+  size_t hits{}; //!< Requests served from the cache
+  size_t misses{}; //!< Requests for resources that were not cached
+  size_t evictions{}; //!< Resources dropped for being over budget or expired
+  size_t bytes{}; //!< Estimated memory held by cached resources
+  size_t count{}; //!< Number of cached resources
+};
+
+/*! \brief Shared resources by path under a memory budget
+ *
+ * Resources are ordered by when they were last requested. When the cache holds
+ * more bytes than its budget, the least recently used resources are dropped.
+ * Only resources that nothing outside the cache holds can be dropped, so the
+ * budget is exceeded while permanent or in use resources add up to more than it.
+ */
+template<typename T>
+class ResourceCache {
+public:
+  using SharedPtrType = std::shared_ptr<T>;
+
+  /**
+   * @param budget bytes to keep cached. 0 is unlimited
+   */
+  explicit ResourceCache(size_t budget = 0) : budget(budget) {}
+
+  ResourceCache(const ResourceCache&) = delete;
+  ResourceCache& operator=(const ResourceCache&) = delete;
+
+  void SetBudget(size_t bytes) {
+    std::scoped_lock lock(mutex);
+    budget = bytes;
+    Trim();
+  }
+
+  size_t GetBudget() const {
+    std::scoped_lock lock(mutex);
+    return budget;
+  }
+
+  /**
+   * @brief Returns the cached resource and marks it as the most recently used
+   * @param pin if true the resource is never evicted from now on
+   * @return nullptr if key is not cached
+   */
+  SharedPtrType Find(const std::string& key, bool pin = false) {
+    std::scoped_lock lock(mutex);
+
+    auto iter = entries.find(key);
+
+    if (iter == entries.end()) {
+      stats.misses++;
+
+      if (recordMisses) {
+        missedKeys.insert(key);
+      }
+
+      return nullptr;
+    }
+
+    stats.hits++;
+
+    if (pin) {
+      iter->second.resource.Pin();
+    }
+
+    order.splice(order.begin(), order, iter->second.order);
+    return iter->second.resource.GetResource();
+  }
+
+  /**
+   * @brief Caches a resource, replacing any under the same key, then evicts down to the budget
+   * @param bytes estimated memory of the resource
+   * @param permanent if true the resource is never evicted
+   */
+  void Insert(const std::string& key, SharedPtrType resource, size_t bytes, bool permanent = false) {
+    std::scoped_lock lock(mutex);
+
+    if (auto iter = entries.find(key); iter != entries.end()) {
+      Remove(iter);
+    }
+
+    order.push_front(key);
+    entries.emplace(key, Entry{ CachedResource<T>(resource, permanent), bytes, order.begin() });
+    stats.bytes += bytes;
+    stats.count++;
+
+    Trim();
+  }
+
+  /**
+   * @brief Drops a resource whether or not it is in use
+   */
+  void Erase(const std::string& key) {
+    std::scoped_lock lock(mutex);
+
+    if (auto iter = entries.find(key); iter != entries.end()) {
+      Remove(iter);
+    }
+  }
+
+  /**
+   * @brief Evicts resources that are not in use and were not requested for the last `seconds`
+   */
+  void EvictExpired(float seconds) {
+    std::scoped_lock lock(mutex);
+
+    auto iter = entries.begin();
+    while (iter != entries.end()) {
+      auto next = std::next(iter);
+      CachedResource<T>& resource = iter->second.resource;
+
+      if (!resource.IsInUse() && resource.GetSecondsSinceLastRequest() > seconds) {
+        Remove(iter);
+        stats.evictions++;
+      }
+
+      iter = next;
+    }
+  }
+
+  ResourceCacheStats GetStats() const {
+    std::scoped_lock lock(mutex);
+    return stats;
+  }
+
+  /**
+   * @brief While enabled, keys that Find() misses are kept for TakeMissedKeys()
+   */
+  void RecordMisses(bool enabled) {
+    std::scoped_lock lock(mutex);
+    recordMisses = enabled;
+  }
+
+  /**
+   * @brief Keys missed while recording since the last call, each listed once
+   */
+  std::vector<std::string> TakeMissedKeys() {
+    std::scoped_lock lock(mutex);
+    std::vector<std::string> out(missedKeys.begin(), missedKeys.end());
+    missedKeys.clear();
+    return out;
+  }
+
+private:
+  struct Entry {
+    CachedResource<T> resource;
+    size_t bytes{};
+    typename std::list<std::string>::iterator order;
+  };
+
+  using EntryIter = typename std::map<std::string, Entry>::iterator;
+
+  void Remove(EntryIter iter) {
+    stats.bytes -= iter->second.bytes;
+    stats.count--;
+    order.erase(iter->second.order);
+    entries.erase(iter);
+  }
+
+  // Walk from the least recently used resource until under budget
+  void Trim() {
+    if (budget == 0) return;
+
+    // iter stays one past the candidate so removing the candidate does not invalidate it
+    auto iter = order.end();
+    while (stats.bytes > budget && iter != order.begin()) {
+      auto candidate = std::prev(iter);
+      auto entry = entries.find(*candidate);
+
+      if (entry->second.resource.IsInUse()) {
+        iter = candidate;
+        continue;
+      }
+
+      Remove(entry);
+      stats.evictions++;
+    }
+  }
+
+  mutable std::mutex mutex;
+  size_t budget{}; //!< 0 is unlimited
+  std::map<std::string, Entry> entries;
+  std::list<std::string> order; //!< Keys from most to least recently used
+  ResourceCacheStats stats;
+  bool recordMisses{ false };
+  std::set<std::string> missedKeys;
+};
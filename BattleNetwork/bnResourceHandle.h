@@ -10,6 +10,7 @@ class ScriptResourceManager;
 
 class ResourceHandle {
   friend class Game;
+  friend class HeadlessBattle;
 
 private:
   static TextureResourceManager* textures;
@@ -5,11 +5,22 @@ show(true), layer(0), parent(nullptr), childNodes() {
 }
 
 SceneNode::~SceneNode() {
-
+  for (std::shared_ptr<SceneNode>& child : childNodes) {
+    if (child->parent == this) {
+      child->parent = nullptr;
+    }
+  }
 }
 
 void SceneNode::SetLayer(int layer) {
+  if (SceneNode::layer == layer) return;
+
   SceneNode::layer = layer;
+  drawOrderDirty = true;
+
+  if (parent) {
+    parent->drawOrderDirty = true;
+  }
 }
 
 const int SceneNode::GetLayer() const {
@@ -35,10 +46,10 @@ const bool SceneNode::IsVisible() const {
 void SceneNode::draw(sf::RenderTarget& target, sf::RenderStates states) const {
   if (!show) return;
 
-  std::sort(childNodes.begin(), childNodes.end(), [](std::shared_ptr<SceneNode>& a, std::shared_ptr<SceneNode>& b) { return (a->GetLayer() > b->GetLayer()); });
-
   // draw its children
-  for (auto& childNode : childNodes) {
+  for (SceneNode* childNode : GetDrawOrder()) {
+    if (childNode == this) continue;
+
     auto childStates = states;
 
     if (!childNode->useParentShader) {
@@ -50,7 +61,7 @@ void SceneNode::draw(sf::RenderTarget& target, sf::RenderStates states) const {
 }
 
 void SceneNode::AddNode(std::shared_ptr<SceneNode> child) { 
-  if (child == nullptr) return;  child->parent = this; childNodes.push_back(child); 
+  if (child == nullptr) return;  child->parent = this; childNodes.push_back(child); drawOrderDirty = true;
 }
 
 void SceneNode::RemoveNode(std::shared_ptr<SceneNode> find) {
@@ -68,6 +79,7 @@ void SceneNode::RemoveNode(SceneNode* find) {
   }
 
   childNodes.erase(iter, childNodes.end());
+  drawOrderDirty = true;
 }
 
 void SceneNode::EnableParentShader(bool use)
@@ -80,11 +92,40 @@ const bool SceneNode::IsUsingParentShader() const
   return useParentShader;
 }
 
-std::vector<std::shared_ptr<SceneNode>>& SceneNode::GetChildNodes() const
+const std::vector<std::shared_ptr<SceneNode>>& SceneNode::GetChildNodes() const
 {
   return childNodes;
 }
 
+void SceneNode::AdoptChildren()
+{
+  for (std::shared_ptr<SceneNode>& child : childNodes) {
+    child->parent = this;
+  }
+
+  drawOrderDirty = true;
+}
+
+const std::vector<SceneNode*>& SceneNode::GetDrawOrder() const
+{
+  if (drawOrderDirty) {
+    drawOrder.clear();
+    drawOrder.reserve(childNodes.size() + 1);
+
+    for (const std::shared_ptr<SceneNode>& child : childNodes) {
+      drawOrder.push_back(child.get());
+    }
+
+    drawOrder.push_back(const_cast<SceneNode*>(this));
+
+    // stable so nodes on the same layer keep the order they were added in
+    std::stable_sort(drawOrder.begin(), drawOrder.end(), [](SceneNode* a, SceneNode* b) { return (a->GetLayer() > b->GetLayer()); });
+    drawOrderDirty = false;
+  }
+
+  return drawOrder;
+}
+
 std::set<std::shared_ptr<SceneNode>> SceneNode::GetChildNodesWithTag(const std::vector<std::string>& query)
 {
   std::set<std::shared_ptr<SceneNode>> results;
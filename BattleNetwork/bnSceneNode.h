@@ -3,6 +3,10 @@
  * 
  * Nodes attached are not handled by the parent node.
  * Do not expect the deletion of this node to free the memory.
+ *
+ * Each node keeps its children and itself sorted by layer for drawing. The list
+ * is only sorted again after AddNode(), RemoveNode() or SetLayer() on the node
+ * or one of its children.
  * */
 
 #pragma once
@@ -20,6 +24,13 @@ protected:
   bool show; /*!< Flag to hide or display a scene node and its children */
   int layer; /*!< Draw order of this node */
   bool useParentShader{ false }; /*!< Default: use your own internal shader*/
+  mutable std::vector<SceneNode*> drawOrder; /*!< Children and this node sorted by descending layer */
+  mutable bool drawOrderDirty{ true }; /*!< Sort drawOrder again before the next draw */
+
+  /**
+   * @brief Children and this node sorted by descending layer. Sorted only when marked dirty.
+   */
+  const std::vector<SceneNode*>& GetDrawOrder() const;
 
 public:
   /**
@@ -30,7 +41,7 @@ public:
   SceneNode(const SceneNode& rhs) = delete;
 
   /**
-   * @brief Deconstructor does not delete children
+   * @brief Deconstructor does not delete children but detaches them
    */
   virtual ~SceneNode();
   
@@ -106,7 +117,7 @@ public:
   * Fetches all the child nodes attached to this node
   * @return a reference to the vector of SceneNode*
   */
-  std::vector<std::shared_ptr<SceneNode>>& GetChildNodes() const;
+  const std::vector<std::shared_ptr<SceneNode>>& GetChildNodes() const;
 
   /**
   * Fetches all the nodes attached to this node with any of the tags
@@ -116,6 +127,11 @@ public:
   
   SceneNode* GetParent();
 
+  /**
+   * @brief Points every child back at this node, e.g. after another node borrowed them
+   */
+  void AdoptChildren();
+
   void AddTags(std::vector<std::string> tags);
   void RemoveTags(std::vector<std::string> tags);
   const bool HasTag(const std::string& name);
@@ -1,4 +1,5 @@
 #ifdef BN_MOD_SUPPORT
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <functional>
@@ -100,14 +101,13 @@ void ScriptResourceManager::SetSystemFunctions(ScriptPackage& scriptPackage)
 
   state["math"]["random"] = sol::overload(
     [] (int n, int m) -> int { // [n, m]
-      int range = m - n;
-      return SyncedRand() % (range + 1) + n;
+      return SyncedRandRange(n, m);
     },
     [] (int n) -> int { // [1, n]
-      return SyncedRand() % n + 1;
+      return SyncedRandRange(1, n);
     },
     [] () -> float { // [0, 1)
-      return (float)SyncedRand() / ((float)(SyncedRandMax()) + 1);
+      return SyncedRandFloat();
     }
   );
 
@@ -228,9 +228,20 @@ void ScriptResourceManager::ConfigureEnvironment(ScriptPackage& scriptPackage) {
   sol::table overworld_namespace = state.create_table("Overworld");
   sol::table engine_namespace = state.create_table("Engine");
 
-  engine_namespace.set_function("get_rand_seed", [this]() -> unsigned int {
-    Logger::Log(LogLevel::warning, "Engine.get_rand_seed() is deprecated");
-    return 0;
+  engine_namespace.set_function("get_rand_seed", []() -> unsigned int {
+    return SyncedRandomGenerator().GetSeed();
+  });
+
+  // Draws many values from the battle's generator in one call, [n, m] like math.random(n, m)
+  engine_namespace.set_function("random_list", [](int count, int n, int m) {
+    std::vector<int> values(static_cast<size_t>(std::max(count, 0)));
+    RandomGenerator& generator = SyncedRandomGenerator();
+
+    for (int& value : values) {
+      value = generator.NextRange(n, m);
+    }
+
+    return sol::as_table(values);
   });
 
   DefineFieldUserType(battle_namespace);
@@ -294,6 +305,9 @@ void ScriptResourceManager::ConfigureEnvironment(ScriptPackage& scriptPackage) {
     "set_emotions_texture_path", &PlayerMeta::SetEmotionsTexturePath,
     "set_preview_texture", &PlayerMeta::SetPreviewTexture,
     "set_icon_texture", &PlayerMeta::SetIconTexture,
+    "declare_asset", [] (PlayerMeta& meta, const std::string& path) {
+      meta.DeclareAsset(path);
+    },
     "declare_package_id", [SetPackageId] (PlayerMeta& meta, const std::string& packageId) {
       SetPackageId(packageId);
       meta.SetPackageID(packageId);
@@ -313,6 +327,9 @@ void ScriptResourceManager::ConfigureEnvironment(ScriptPackage& scriptPackage) {
     "set_speed", &MobMeta::SetSpeed,
     "set_attack", &MobMeta::SetAttack,
     "set_health", &MobMeta::SetHP,
+    "declare_asset", [] (MobMeta& meta, const std::string& path) {
+      meta.DeclareAsset(path);
+    },
     "declare_package_id", [SetPackageId] (MobMeta& meta, const std::string& packageId) {
       SetPackageId(packageId);
       meta.SetPackageID(packageId);
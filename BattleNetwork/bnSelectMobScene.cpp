@@ -369,7 +369,7 @@ void SelectMobScene::onUpdate(double elapsed) {
       const std::string& image = meta.GetMugshotTexturePath();
       const std::string& mugshotAnim = meta.GetMugshotAnimationPath();
       const std::string& emotionsTexture = meta.GetEmotionsTexturePath();
-      auto mugshot = Textures().LoadFromFile(image);
+      auto mugshot = Textures().LoadPinnedFromFile(image);
       auto emotions = Textures().LoadFromFile(emotionsTexture);
       auto player = std::shared_ptr<Player>(meta.GetData());
 
@@ -392,13 +392,18 @@ void SelectMobScene::onUpdate(double elapsed) {
         mob->SetBackground(defaultBackground);
       }
 
+      std::vector<PackageAssets> preloadPackages = {
+        PackageAssets::Of(packageManager.FindPackageByID(mobSelectionId)),
+        PackageAssets::Of(meta)
+      };
+
       using effect = segue<WhiteWashFade>;
 
       // Queue screen transition to Battle Scene with a white fade effect
       // just like the game
       if (mob->IsFreedomMission()) {
         FreedomMissionProps props{
-          { player, programAdvance, std::move(newFolder), mob->GetField(), mob->GetBackground() },
+          { player, programAdvance, std::move(newFolder), mob->GetField(), mob->GetBackground(), preloadPackages },
           { mob },
           mob->GetTurnLimit(),
           sf::Sprite(*mugshot),
@@ -411,7 +416,7 @@ void SelectMobScene::onUpdate(double elapsed) {
       }
       else {
         MobBattleProperties props{ 
-          { player, programAdvance, std::move(newFolder), mob->GetField(), mob->GetBackground() },
+          { player, programAdvance, std::move(newFolder), mob->GetField(), mob->GetBackground(), preloadPackages },
           MobBattleProperties::RewardBehavior::take,
           { mob },
           sf::Sprite(*mugshot),
@@ -76,7 +76,6 @@ void SelectedCardsUI::draw(sf::RenderTarget & target, sf::RenderStates states) c
     target.draw(frame, states);
 
     // Grab the ID of the card and draw that icon from the spritesheet
-    std::shared_ptr<sf::Texture> texture;
     std::string id = (*selectedCards)[drawOrderIndex].GetUUID();
 
     bool found = false;
@@ -87,8 +86,13 @@ void SelectedCardsUI::draw(sf::RenderTarget & target, sf::RenderStates states) c
 
       CardPackageManager& packageManager = partition->GetPartition(addr.namespaceId);
       if (packageManager.HasPackage(addr.packageId)) {
-        texture = packageManager.FindPackageByID(addr.packageId).GetIconTexture();
-        icon.setTexture(texture);
+        const TextureRegion& region = packageManager.FindPackageByID(addr.packageId).GetIconRegion();
+
+        if (region) {
+          icon.setTexture(region.texture, false);
+          icon.setTextureRect(region.rect);
+          found = true;
+        }
       }
     }
 
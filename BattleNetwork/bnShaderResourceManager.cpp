@@ -76,6 +76,11 @@ const bool ShaderResourceManager::IsEnabled() const
   return isEnabled;
 }
 
+PaletteAtlas& ShaderResourceManager::GetPaletteAtlas()
+{
+  return paletteAtlas;
+}
+
 ShaderResourceManager::ShaderResourceManager() {
 
 #ifdef SFML_SYSTEM_ANDROID
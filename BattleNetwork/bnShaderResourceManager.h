@@ -10,6 +10,7 @@
 #pragma once
 #include "bnShaderType.h"
 #include "bnLogger.h"
+#include "bnPaletteAtlas.h"
 
 #include <SFML/Graphics.hpp>
 #include <map>
@@ -49,6 +50,11 @@ public:
 
   const bool IsEnabled() const;
 
+  /**
+   * @brief Palettes used by the battle character shader
+   */
+  PaletteAtlas& GetPaletteAtlas();
+
   ShaderResourceManager();
   ~ShaderResourceManager();
 private:
@@ -56,4 +62,5 @@ private:
   vector<string> paths;  /*!< Paths to all shaders. Must be in order of ShaderType @see ShaderType */
   bool isEnabled{};
   map<ShaderType, sf::Shader*> shaders; /*!< cache */
+  PaletteAtlas paletteAtlas;
 };
\ No newline at end of file
@@ -1,199 +1,324 @@
 #include "bnSmartShader.h"
-
-  SmartShader::SmartShader() {
-    ref = nullptr;
+#include "bnLogger.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+
+static_assert(std::is_trivially_copyable<SmartShader::Uniforms>::value, "Uniforms must be saved and restored with a memcpy");
+
+//!< The last value uploaded for every uniform id of one sf::Shader
+struct SmartShader::AppliedUniforms {
+  std::vector<UniformValue> values;
+};
+
+namespace {
+  struct UniformNames {
+    std::mutex mutex;
+    std::unordered_map<std::string, SmartShader::UniformId> ids;
+    std::deque<std::string> names; // push_back never moves existing names
+  };
+
+  UniformNames& Names() {
+    static UniformNames names;
+    return names;
   }
 
-  SmartShader::SmartShader(const SmartShader& copy) {
-    funiforms = copy.funiforms;
-    iuniforms = copy.iuniforms;
-    vfuniforms = copy.vfuniforms;
-    duniforms = copy.duniforms;
-    farruniforms = copy.farruniforms;
-    coluniforms = copy.coluniforms;
-    texuniforms = copy.texuniforms;
-    textypeuniforms = copy.textypeuniforms;
-
-    ref = copy.ref;
+  // Names are only ever appended so the reference stays valid after the lock is released
+  const std::string& NameOf(SmartShader::UniformId id) {
+    UniformNames& names = Names();
+    std::scoped_lock lock(names.mutex);
+    return names.names[id];
   }
 
-  SmartShader::~SmartShader() {
-    ref = nullptr;
+  bool SameValue(const SmartShader::UniformValue& a, const SmartShader::UniformValue& b) {
+    return a.type == b.type
+      && a.count == b.count
+      && a.i == b.i
+      && a.texture == b.texture
+      && std::memcmp(a.f, b.f, sizeof(a.f)) == 0;
   }
 
-  SmartShader::SmartShader(const sf::Shader& rhs) {
-    ref = &const_cast<sf::Shader&>(rhs);
+  void Upload(sf::Shader& shader, const SmartShader::UniformValue& value) {
+    const std::string& name = NameOf(value.id);
+
+    switch (value.type) {
+    case SmartShader::UniformType::integer:
+      shader.setUniform(name, value.i);
+      break;
+    case SmartShader::UniformType::floating:
+      shader.setUniform(name, value.f[0]);
+      break;
+    case SmartShader::UniformType::vec2:
+      shader.setUniform(name, sf::Glsl::Vec2(value.f[0], value.f[1]));
+      break;
+    case SmartShader::UniformType::vec4:
+      shader.setUniform(name, sf::Glsl::Vec4(value.f[0], value.f[1], value.f[2], value.f[3]));
+      break;
+    case SmartShader::UniformType::floatArray:
+      shader.setUniformArray(name, value.f, value.count);
+      break;
+    case SmartShader::UniformType::texture:
+      if (value.texture) {
+        shader.setUniform(name, *value.texture);
+      }
+      break;
+    case SmartShader::UniformType::currentTexture:
+      shader.setUniform(name, sf::Shader::CurrentTexture);
+      break;
+    default:
+      break;
+    }
   }
 
- SmartShader& SmartShader::operator=(const sf::Shader& rhs) {
-   ref = &const_cast<sf::Shader&>(rhs);
-   return *this;
-  }
+  // Shaders are owned by the resource manager and live as long as the game
+  std::mutex appliedMutex;
+  std::unordered_map<const sf::Shader*, std::unique_ptr<SmartShader::AppliedUniforms>> appliedByShader;
+}
 
- SmartShader& SmartShader::operator=(const sf::Shader* rhs) {
-   ref = const_cast<sf::Shader*>(rhs);
-   return *this;
- }
+SmartShader::SmartShader() {
+  ref = nullptr;
+}
 
- sf::Shader* SmartShader::Get() {
-   ApplyUniforms();
-   return ref;
- }
+SmartShader::~SmartShader() {
+  ref = nullptr;
+}
 
- bool SmartShader::HasShader() {
-   return ref != nullptr;
- }
+SmartShader::SmartShader(const sf::Shader& rhs) {
+  SetRef(&const_cast<sf::Shader&>(rhs));
+}
 
-  void SmartShader::ApplyUniforms() {
-    if (!ref) return;
+SmartShader& SmartShader::operator=(const sf::Shader& rhs) {
+  SetRef(&const_cast<sf::Shader&>(rhs));
+  return *this;
+}
 
-    iiter iIter = iuniforms.begin();
-    fiter fIter = funiforms.begin();
-    diter dIter = duniforms.begin();
-    farriter farrIter = farruniforms.begin();
-    vfiter vfIter = vfuniforms.begin();
-    coliter colIter = coluniforms.begin();
-    texiter texIter = texuniforms.begin();
-    textypeiter texTypeIter = textypeuniforms.begin();
+SmartShader& SmartShader::operator=(const sf::Shader* rhs) {
+  SetRef(const_cast<sf::Shader*>(rhs));
+  return *this;
+}
 
-    for (; iIter != iuniforms.end(); iIter++) {
-      ref->setUniform(iIter->first, iIter->second);
-    }
+void SmartShader::SetRef(sf::Shader* shader) {
+  ref = shader;
+  applied = nullptr;
 
-    for (; fIter != funiforms.end(); fIter++) {
-      ref->setUniform(fIter->first, fIter->second);
-    }
-
-    for (; dIter != duniforms.end(); dIter++) {
-      ref->setUniform(dIter->first, static_cast<float>(dIter->second));
-    }
+  if (!ref) return;
 
-    for (; farrIter != farruniforms.end(); farrIter++) {
-      ref->setUniformArray(farrIter->first, farrIter->second.data(), farrIter->second.size());
-    }
+  std::scoped_lock lock(appliedMutex);
+  std::unique_ptr<AppliedUniforms>& entry = appliedByShader[ref];
 
-    for (; vfIter != vfuniforms.end(); vfIter++) {
-      ref->setUniform(vfIter->first, vfIter->second);
-    }
+  if (!entry) {
+    entry = std::make_unique<AppliedUniforms>();
+  }
 
-    for (; colIter != coluniforms.end(); colIter++) {
-      sf::Color col = colIter->second;
-      ref->setUniform(colIter->first, 
-        sf::Glsl::Vec4{ 
-          col.r/255.f,
-          col.g/255.f, 
-          col.b/255.f, 
-          col.a/255.f 
-        }
-      );
-    }
+  applied = entry.get();
+}
 
-    for (; texIter != texuniforms.end(); texIter++) {
-      ref->setUniform(texIter->first, *texIter->second);
-    }
+SmartShader::UniformId SmartShader::Uniform(const std::string& name) {
+  UniformNames& names = Names();
+  std::scoped_lock lock(names.mutex);
 
-    for (; texTypeIter != textypeuniforms.end(); texTypeIter++) {
-      ref->setUniform(texTypeIter->first, texTypeIter->second);
-    }
+  auto iter = names.ids.find(name);
 
+  if (iter != names.ids.end()) {
+    return iter->second;
   }
 
-  void SmartShader::ResetUniforms() {
-    if (!ref) {
-      return;
-    }
+  UniformId id = static_cast<UniformId>(names.names.size());
+  names.names.push_back(name);
+  names.ids.emplace(name, id);
+  return id;
+}
 
-    iiter iIter = iuniforms.begin();
-    fiter fIter = funiforms.begin();
-    diter dIter = duniforms.begin();
-    farriter farrIter = farruniforms.begin();
-    vfiter vfIter = vfuniforms.begin();
-    coliter colIter = coluniforms.begin();
-    texiter texIter = texuniforms.begin();
-    textypeiter texTypeIter = textypeuniforms.begin();
-
-    for (; iIter != iuniforms.end(); iIter++) {
-      ref->setUniform(iIter->first, 0);
-    }
+sf::Shader* SmartShader::Get() {
+  ApplyUniforms();
+  return ref;
+}
 
-    for (; fIter != funiforms.end(); fIter++) {
-      ref->setUniform(fIter->first, 0.f);
-    }
+sf::Shader* SmartShader::Peek() const {
+  return ref;
+}
 
-    for (; dIter != duniforms.end(); dIter++) {
-      ref->setUniform(dIter->first, 0.f);
-    }
+bool SmartShader::HasShader() {
+  return ref != nullptr;
+}
 
-    for (; farrIter != farruniforms.end(); farrIter++) {
-      std::vector<float> dummyVec;
-      dummyVec.reserve(farrIter->second.size());
-      ref->setUniformArray(farrIter->first, dummyVec.data(), farrIter->second.size());
-    }
+void SmartShader::ApplyUniforms() {
+  if (!ref || !applied) return;
 
-    for (; vfIter != vfuniforms.end(); vfIter++) {
-      ref->setUniform(vfIter->first, 0.f);
-    }
+  for (uint8_t i = 0; i < uniforms.count; i++) {
+    const UniformValue& value = uniforms.values[i];
 
-    for (; colIter != coluniforms.end(); colIter++) {
-      ref->setUniform(colIter->first, 0.f);
+    if (applied->values.size() <= value.id) {
+      applied->values.resize(static_cast<size_t>(value.id) + 1u);
     }
 
-    for (; texIter != texuniforms.end(); texIter++) {
-      ref->setUniform(texIter->first, sf::Shader::CurrentTexture);
-    }
+    UniformValue& last = applied->values[value.id];
 
-    for (; texTypeIter != textypeuniforms.end(); texTypeIter++) {
-      ref->setUniform(texTypeIter->first, sf::Shader::CurrentTexture);
-    }
+    if (SameValue(last, value)) continue;
 
-    iuniforms.clear();
-    funiforms.clear();
-    duniforms.clear();
-    farruniforms.clear();
-    vfuniforms.clear();
-    coluniforms.clear();
-    texuniforms.clear();
-    textypeuniforms.clear();
+    Upload(*ref, value);
+    last = value;
   }
+}
 
-  void SmartShader::SetUniform(std::string uniform, float fvalue) {
-    funiforms[uniform] = fvalue;
+void SmartShader::ResetUniforms() {
+  if (!ref) {
+    return;
   }
 
-  void SmartShader::SetUniform(std::string uniform, double dvalue)
-  {
-    duniforms[uniform] = dvalue;
-  }
+  for (uint8_t i = 0; i < uniforms.count; i++) {
+    UniformValue& value = uniforms.values[i];
+    UniformValue zero;
+    zero.id = value.id;
+
+    switch (value.type) {
+    case UniformType::integer:
+      zero.type = UniformType::integer;
+      break;
+    case UniformType::floating:
+    case UniformType::vec2:
+    case UniformType::vec4:
+      // vectors were zeroed with a single float before too
+      zero.type = UniformType::floating;
+      break;
+    case UniformType::floatArray:
+      zero.type = UniformType::floatArray;
+      zero.count = value.count;
+      break;
+    default:
+      zero.type = UniformType::currentTexture;
+      break;
+    }
 
-  void SmartShader::SetUniform(std::string uniform, const std::vector<float>& farr)
-  {
-    farruniforms[uniform] = farr;
+    value = zero;
   }
 
-  void SmartShader::SetUniform(std::string uniform, int ivalue) {
-    iuniforms[uniform] = ivalue;
-  }
+  ApplyUniforms();
 
-  void SmartShader::SetUniform(std::string uniform, const sf::Vector2f& vfvalue) {
-    vfuniforms[uniform] = vfvalue;
-  }
+  uniforms.count = 0;
+  textures.fill(nullptr);
+}
 
-  void SmartShader::SetUniform(std::string uniform, const sf::Color& colvalue)
-  {
-    coluniforms[uniform] = colvalue;
+SmartShader::UniformValue* SmartShader::Slot(UniformId id) {
+  for (uint8_t i = 0; i < uniforms.count; i++) {
+    if (uniforms.values[i].id == id) {
+      return &uniforms.values[i];
+    }
   }
 
-  void SmartShader::SetUniform(std::string uniform, const std::shared_ptr<sf::Texture>& texvalue)
-  {
-    texuniforms[uniform] = texvalue;
+  if (uniforms.count == BN_SMART_SHADER_MAX_UNIFORMS) {
+    Logger::Logf(LogLevel::warning, "SmartShader has no room for uniform %s", NameOf(id).c_str());
+    return nullptr;
   }
 
-  void SmartShader::SetUniform(std::string uniform, const sf::Shader::CurrentTextureType& value)
-  {
-    textypeuniforms[uniform] = value;
+  UniformValue& value = uniforms.values[uniforms.count++];
+  value = UniformValue{};
+  value.id = id;
+  return &value;
+}
+
+void SmartShader::SetUniform(UniformId uniform, float fvalue) {
+  if (UniformValue* value = Slot(uniform)) {
+    *value = UniformValue{};
+    value->id = uniform;
+    value->type = UniformType::floating;
+    value->f[0] = fvalue;
+  }
+}
+
+void SmartShader::SetUniform(UniformId uniform, double dvalue)
+{
+  SetUniform(uniform, static_cast<float>(dvalue));
+}
+
+void SmartShader::SetUniform(UniformId uniform, const float* farr, size_t count)
+{
+  if (count > BN_SMART_SHADER_MAX_ARRAY) {
+    Logger::Logf(LogLevel::warning, "SmartShader uniform array %s is truncated to %i floats", NameOf(uniform).c_str(), BN_SMART_SHADER_MAX_ARRAY);
+    count = BN_SMART_SHADER_MAX_ARRAY;
   }
 
-  void SmartShader::Reset() {
-    ResetUniforms();
-    ref = nullptr;
+  if (UniformValue* value = Slot(uniform)) {
+    *value = UniformValue{};
+    value->id = uniform;
+    value->type = UniformType::floatArray;
+    value->count = static_cast<uint8_t>(count);
+    std::copy(farr, farr + count, value->f);
+  }
+}
+
+void SmartShader::SetUniform(UniformId uniform, const std::vector<float>& farr)
+{
+  SetUniform(uniform, farr.data(), farr.size());
+}
+
+void SmartShader::SetUniform(UniformId uniform, int ivalue) {
+  if (UniformValue* value = Slot(uniform)) {
+    *value = UniformValue{};
+    value->id = uniform;
+    value->type = UniformType::integer;
+    value->i = ivalue;
+  }
+}
+
+void SmartShader::SetUniform(UniformId uniform, const sf::Vector2f& vfvalue) {
+  if (UniformValue* value = Slot(uniform)) {
+    *value = UniformValue{};
+    value->id = uniform;
+    value->type = UniformType::vec2;
+    value->f[0] = vfvalue.x;
+    value->f[1] = vfvalue.y;
+  }
+}
+
+void SmartShader::SetUniform(UniformId uniform, const sf::Color& colvalue)
+{
+  if (UniformValue* value = Slot(uniform)) {
+    *value = UniformValue{};
+    value->id = uniform;
+    value->type = UniformType::vec4;
+    value->f[0] = colvalue.r / 255.f;
+    value->f[1] = colvalue.g / 255.f;
+    value->f[2] = colvalue.b / 255.f;
+    value->f[3] = colvalue.a / 255.f;
+  }
+}
+
+void SmartShader::SetUniform(UniformId uniform, const std::shared_ptr<sf::Texture>& texvalue)
+{
+  if (UniformValue* value = Slot(uniform)) {
+    *value = UniformValue{};
+    value->id = uniform;
+    value->type = UniformType::texture;
+    value->texture = texvalue.get();
+    textures[value - uniforms.values] = texvalue;
+  }
+}
+
+void SmartShader::SetUniform(UniformId uniform, const sf::Shader::CurrentTextureType& type)
+{
+  if (UniformValue* value = Slot(uniform)) {
+    *value = UniformValue{};
+    value->id = uniform;
+    value->type = UniformType::currentTexture;
   }
+}
+
+const SmartShader::Uniforms& SmartShader::GetUniforms() const
+{
+  return uniforms;
+}
+
+void SmartShader::SetUniforms(const Uniforms& uniforms)
+{
+  std::memcpy(&this->uniforms, &uniforms, sizeof(Uniforms));
+}
+
+void SmartShader::Reset() {
+  ResetUniforms();
+  SetRef(nullptr);
+}
@@ -1,154 +1,229 @@
 /*! \brief A shader wrapper that intelligently applies itself during draw calls
- * 
- * Currently supports int, float, double, vector2f uniforms
- * 
- * Additional uniforms must be added
+ *
+ * Currently supports int, float, double, vector2f, color, float array, and texture uniforms
+ *
+ * Uniform names are interned into ids once with SmartShader::Uniform() and the
+ * values are kept in a fixed size block. Copying the block with GetUniforms()
+ * and SetUniforms() is how callers save and restore shader state.
+ *
+ * Many smart shaders usually share one sf::Shader, e.g. every entity uses the
+ * battle character shader. The last value uploaded to each sf::Shader is
+ * remembered so Get() only calls setUniform() for values that differ from it.
+ * Setting the same uniform directly on the sf::Shader bypasses this and
+ * should be avoided.
  */
 
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
 #include <memory>
-#include <map>
+#include <string>
+#include <vector>
+
+#define BN_SMART_SHADER_MAX_UNIFORMS 8
+#define BN_SMART_SHADER_MAX_ARRAY 4
 
 class SmartShader
 {
   friend class DrawWindow;
 
+public:
+  using UniformId = uint16_t;
+
+  enum class UniformType : uint8_t {
+    none = 0,
+    integer,
+    floating,
+    vec2,
+    vec4,
+    floatArray,
+    texture,
+    currentTexture
+  };
+
+  //!< One uniform. Trivially copyable.
+  struct UniformValue {
+    UniformId id{};
+    UniformType type{ UniformType::none };
+    uint8_t count{}; /*!< Number of floats used */
+    int i{};
+    float f[BN_SMART_SHADER_MAX_ARRAY]{};
+    const sf::Texture* texture{ nullptr };
+  };
+
+  //!< Every uniform set on a smart shader. Trivially copyable.
+  struct Uniforms {
+    uint8_t count{};
+    UniformValue values[BN_SMART_SHADER_MAX_UNIFORMS];
+  };
+
+  struct AppliedUniforms; //!< Defined in the source file
+
 private:
   sf::Shader* ref; /*!< Pointer to shader object */
-  std::map<std::string, int>    iuniforms; /*!< lookup of integer uniforms */
-  std::map<std::string, float>  funiforms; /*!< lookup of float uniforms */
-  std::map<std::string, double> duniforms; /*!< lookup of double uniforms */
-  std::map<std::string, std::vector<float>> farruniforms; /*! lookup of float arrays */
-  std::map<std::string, sf::Vector2f> vfuniforms; /*!< lookup of vector2f uniforms */
-  std::map<std::string, sf::Color> coluniforms; /*!< lookup of sf::Color uniforms */
-  std::map<std::string, std::shared_ptr<sf::Texture>> texuniforms; /*! lookups of texture uniforms */
-  std::map<std::string, sf::Shader::CurrentTextureType> textypeuniforms;
-
-  typedef std::map<std::string, int>::iterator iiter; 
-  typedef std::map<std::string, float>::iterator fiter;
-  typedef std::map<std::string, double>::iterator diter;
-  typedef std::map<std::string, std::vector<float>>::iterator farriter;
-  typedef std::map<std::string, sf::Vector2f>::iterator vfiter;
-  typedef std::map<std::string, sf::Color>::iterator coliter;
-  typedef std::map<std::string, std::shared_ptr<sf::Texture>>::iterator texiter;
-  typedef std::map<std::string, sf::Shader::CurrentTextureType>::iterator textypeiter;
-
-  /**
-   * @brief Applies all registered uniform values before drawing
+  AppliedUniforms* applied{ nullptr }; /*!< What has been uploaded to ref */
+  Uniforms uniforms; /*!< Values to upload before drawing */
+  std::array<std::shared_ptr<sf::Texture>, BN_SMART_SHADER_MAX_UNIFORMS> textures; /*!< Keeps texture uniforms alive by slot */
+
+  /**
+   * @brief Applies all registered uniform values that changed since they were last applied
    */
   void ApplyUniforms();
-  
+
   /**
    * @brief Clears the shader object of all uniform values
    */
   void ResetUniforms();
 
+  /**
+   * @brief Finds the slot for a uniform or claims a new one
+   * @return nullptr if every slot is taken
+   */
+  UniformValue* Slot(UniformId id);
+
+  void SetRef(sf::Shader* shader);
+
 public:
   /**
    * @brief Constructs a smart shader with pointer to sf::Shader ref set to nullptr
    */
   SmartShader();
-  
+
   /**
    * @brief Constructs a smart shader from another smart shader
    */
-  SmartShader(const SmartShader&);
-  
+  SmartShader(const SmartShader&) = default;
+  SmartShader& operator=(const SmartShader&) = default;
+
   /**
-   * @brief Frees the reference to the shader object and empties the uniform dictionaries
+   * @brief Frees the reference to the shader object
    */
   ~SmartShader();
-  
+
   /**
    * @brief Assigns shader object ref to rhs
    * @param rhs shader object to assign itself to
    */
   SmartShader(const sf::Shader& rhs);
-  
+
   /**
    * @brief Assignment ops assigns ref to a shader object rhs
    * @param rhs
    */
   SmartShader& operator=(const sf::Shader& rhs);
-  
+
   /**
    * @brief Assignment ops assigns ref to a shader object rhs
    * @param rhs
    */
   SmartShader& operator=(const sf::Shader* rhs);
-  
+
+  /**
+   * @brief Interns a uniform name. Store the result to skip the lookup on every set.
+   * @param name the name of the uniform
+   */
+  static UniformId Uniform(const std::string& name);
+
   /**
    * @brief Set a float uniform value
    * @param uniform the name of the uniform
    * @param fvalue
    */
-  void SetUniform(std::string uniform, float fvalue);
+  void SetUniform(UniformId uniform, float fvalue);
 
   /**
-   * @brief Set a double uniform value
+   * @brief Set a double uniform value. Uploaded as a float.
    * @param uniform the name of the uniform
    * @param dvalue
    */
-  void SetUniform(std::string uniform, double dvalue);
+  void SetUniform(UniformId uniform, double dvalue);
 
   /**
-   * @brief Set a float array uniform value
+   * @brief Set a float array uniform value of at most BN_SMART_SHADER_MAX_ARRAY floats
    * @param uniform the name of the uniform
-   * @param farrvalue
+   * @param farr
+   * @param count
    */
-  void SetUniform(std::string uniform, const std::vector<float>& farr);
-  
+  void SetUniform(UniformId uniform, const float* farr, size_t count);
+  void SetUniform(UniformId uniform, const std::vector<float>& farr);
+
   /**
    * @brief Set an integer uniform value
    * @param uniform the name of the uniform
    * @param ivalue
    */
-  void SetUniform(std::string uniform, int ivalue);
-  
+  void SetUniform(UniformId uniform, int ivalue);
+
   /**
    * @brief Set a vector2f uniform value
    * @param uniform the name of the uniform
    * @param vfvalue
    */
-  void SetUniform(std::string uniform, const sf::Vector2f& vfvalue);
-  
+  void SetUniform(UniformId uniform, const sf::Vector2f& vfvalue);
+
   /**
    * @brief Set a color uniform value
    * @param uniform the name of the uniform
    * @param colvalue
    */
-  void SetUniform(std::string uniform, const sf::Color& colvalue);
+  void SetUniform(UniformId uniform, const sf::Color& colvalue);
 
   /**
    * @brief Set a texture uniform value
    * @param uniform the name of the uniform
    * @param texvalue
    */
-  void SetUniform(std::string uniform, const std::shared_ptr<sf::Texture>& texvalue);
+  void SetUniform(UniformId uniform, const std::shared_ptr<sf::Texture>& texvalue);
 
   /**
   * @brief Set a texture type uniform value
   * @param uniform the name of the uniform
   * @param value
   */
-  void SetUniform(std::string uniform, const sf::Shader::CurrentTextureType& value);
+  void SetUniform(UniformId uniform, const sf::Shader::CurrentTextureType& value);
+
+  /**
+   * @brief Interns the name on every call. Prefer the UniformId overloads in code that runs every frame.
+   */
+  template<typename T>
+  void SetUniform(const std::string& uniform, const T& value) {
+    SetUniform(Uniform(uniform), value);
+  }
+
+  /**
+   * @brief Snapshot of every uniform value
+   *
+   * Texture uniforms are only kept alive while they are set on this shader.
+   * Restore a snapshot before replacing the textures it refers to.
+   */
+  const Uniforms& GetUniforms() const;
+
+  /**
+   * @brief Restores a snapshot from GetUniforms()
+   */
+  void SetUniforms(const Uniforms& uniforms);
 
   /**
    * @brief Sets all pre-existing uniforms to 0, empties the lookups, and frees ref
    */
   void Reset();
-  
+
   /**
-   * @brief Fetch the shader object
+   * @brief Fetch the shader object with this smart shader's uniforms applied
    * @return sf::Shader*
    */
   sf::Shader* Get();
 
+  /**
+   * @brief Fetch the shader object without applying any uniforms
+   * @return sf::Shader*
+   */
+  sf::Shader* Peek() const;
+
   /**
    * @brief Lighter than checking if Get() returns nullptr
    * @return true if ref is not nullptr
    */
   bool HasShader();
 };
-
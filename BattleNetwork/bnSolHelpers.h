@@ -1,6 +1,7 @@
 #pragma once
 #include <sol/sol.hpp>
 #include "stx/result.h"
+#include "bnProfiler.h"
 
 template<typename Table, typename ...Args>
 stx::result_t<sol::object> CallLuaFunction(Table& script, const std::string& functionName, Args... args)
@@ -13,6 +14,8 @@ stx::result_t<sol::object> CallLuaFunction(Table& script, const std::string& fun
   }
 
   sol::protected_function func = possible_func;
+
+  BN_PROFILE_ZONE("Lua");
   auto result = func(std::forward<Args>(args)...);
 
   if(!result.valid()) {
@@ -47,6 +50,7 @@ stx::result_t<Result> CallLuaFunctionExpectingValue(Table& script, const std::st
 
 template<typename ...Args>
 stx::result_t<sol::object> CallLuaCallback(const sol::protected_function& func, Args... args) {
+  BN_PROFILE_ZONE("Lua");
   auto result = func(std::forward<Args>(args)...);
 
   if(!result.valid()) {
@@ -62,6 +66,7 @@ stx::result_t<sol::object> CallLuaCallback(const sol::protected_function& func,
 template<typename Result, typename ...Args>
 stx::result_t<Result> CallLuaCallbackExpectingValue(const sol::protected_function& func, Args... args)
 {
+  BN_PROFILE_ZONE("Lua");
   auto result = func(std::forward<Args>(args)...);
 
   if(!result.valid()) {
@@ -83,6 +88,7 @@ stx::result_t<Result> CallLuaCallbackExpectingValue(const sol::protected_functio
 template<typename ...Args>
 stx::result_t<bool> CallLuaCallbackExpectingBool(const sol::protected_function& func, Args... args)
 {
+  BN_PROFILE_ZONE("Lua");
   auto result = func(std::forward<Args>(args)...);
 
   if(!result.valid()) {
@@ -1,6 +1,11 @@
 #include "bnSpell.h"
 
 Spell::Spell(Team team) : Entity()
+{
+  Reset(team);
+}
+
+void Spell::Reset(Team team)
 {
   SetFloatShoe(true);
   SetLayer(1);
@@ -18,6 +18,11 @@ public:
    */
   Spell(Team team);
 
+  /**
+   * @brief Restores the constructed spell state when recycled from an EntityPool
+   */
+  void Reset(Team team);
+
   /**
    * @brief Implement OnUpdate required
    * @param _elapsed in seconds
@@ -32,6 +32,9 @@ SpriteProxyNode::SpriteProxyNode(SpriteProxyNode&& rhs) noexcept
   rhs.allocatedSprite = false;
   rhs.textureRef.reset();
 
+  AdoptChildren();
+  rhs.AdoptChildren();
+
 }
 
 SpriteProxyNode::SpriteProxyNode(sf::Sprite& rhs) : SceneNode() {
@@ -147,16 +150,7 @@ void SpriteProxyNode::draw(sf::RenderTarget& target, sf::RenderStates states) co
     states.shader = nullptr;
   }
 
-  std::vector<SceneNode*> copies;
-  copies.reserve(childNodes.size() + 1);
-
-  for (auto& child : childNodes) {
-    copies.push_back(child.get());
-  }
-
-  copies.push_back((SceneNode*)this);
-
-  std::sort(copies.begin(), copies.end(), [](SceneNode* a, SceneNode* b) { return (a->GetLayer() > b->GetLayer()); });
+  const std::vector<SceneNode*>& copies = GetDrawOrder();
 
   // draw its children
   for (std::size_t i = 0; i < copies.size(); i++) {
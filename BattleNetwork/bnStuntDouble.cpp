@@ -1,8 +1,15 @@
 #include "bnStuntDouble.h"
 #include "bnAnimationComponent.h"
 
-StuntDouble::StuntDouble(std::shared_ptr<Character> ref) : ref(ref)
+StuntDouble::StuntDouble(std::shared_ptr<Character> ref)
 {
+  Borrow(ref);
+}
+
+void StuntDouble::Borrow(std::shared_ptr<Character> ref)
+{
+  this->ref = ref;
+
   // Copy attributes & stats
   setTexture(ref->getTexture());
   setScale(ref->getScale());
@@ -17,6 +24,27 @@ StuntDouble::StuntDouble(std::shared_ptr<Character> ref) : ref(ref)
   }
 }
 
+void StuntDouble::Release()
+{
+  if (!ref) return;
+
+  std::vector<std::shared_ptr<SceneNode>> nodes = ref->GetChildNodes();
+  for (std::shared_ptr<SceneNode>& node : nodes) {
+    RemoveNode(node);
+  }
+
+  // the borrowed nodes belong to the original again
+  ref->AdoptChildren();
+  ref.reset();
+}
+
+void StuntDouble::Reset(std::shared_ptr<Character> ref)
+{
+  Release();
+  Recycle();
+  Borrow(ref);
+}
+
 void StuntDouble::Init() {
   Character::Init();
 
@@ -45,7 +73,7 @@ void StuntDouble::Init() {
 
 StuntDouble::~StuntDouble()
 {
-
+  Release();
 }
 
 void StuntDouble::OnDelete()
@@ -63,3 +91,51 @@ bool StuntDouble::CanMoveTo(Battle::Tile*)
 {
   return true;
 }
+
+StuntDoublePool::Storage::~Storage()
+{
+  for (StuntDouble* stuntDouble : idle) {
+    delete stuntDouble;
+  }
+}
+
+StuntDoublePool::StuntDoublePool() :
+  storage(std::make_shared<Storage>())
+{
+}
+
+std::shared_ptr<StuntDouble> StuntDoublePool::Acquire(std::shared_ptr<Character> ref)
+{
+  std::weak_ptr<Storage> weakStorage = storage;
+
+  auto reclaim = [weakStorage](StuntDouble* stuntDouble) {
+    if (std::shared_ptr<Storage> storage = weakStorage.lock()) {
+      // let go of the original now instead of when this double is reused
+      stuntDouble->Release();
+      storage->idle.push_back(stuntDouble);
+      return;
+    }
+
+    delete stuntDouble;
+  };
+
+  std::shared_ptr<StuntDouble> stuntDouble;
+
+  if (storage->idle.empty()) {
+    stuntDouble = std::shared_ptr<StuntDouble>(new StuntDouble(ref), reclaim);
+  }
+  else {
+    // The previous control block is gone so this one becomes the new weak_from_this()
+    stuntDouble = std::shared_ptr<StuntDouble>(storage->idle.back(), reclaim);
+    storage->idle.pop_back();
+    stuntDouble->Reset(ref);
+  }
+
+  stuntDouble->Init();
+  return stuntDouble;
+}
+
+const size_t StuntDoublePool::IdleCount() const
+{
+  return storage->idle.size();
+}
@@ -1,15 +1,69 @@
 #pragma once
 #include "bnCharacter.h"
 
+/**
+ * @class StuntDouble
+ * @brief Stands in for a character while it performs a time freeze card
+ *
+ * Shares the texture, palette, and attached nodes of the character it doubles
+ * for and keeps its own copy of the animation state. Stunt doubles come from a
+ * StuntDoublePool so chained time freezes reuse them.
+ */
 class StuntDouble : public Character {
+  friend class StuntDoublePool;
+
   sf::Color defaultColor;
   std::shared_ptr<Character> ref;
+
+  /**
+   * @brief Copies the attributes of `ref` and borrows its nodes
+   */
+  void Borrow(std::shared_ptr<Character> ref);
+
+  /**
+   * @brief Gives the borrowed nodes back and lets go of the original character
+   */
+  void Release();
 public:
   StuntDouble(std::shared_ptr<Character> ref);
   ~StuntDouble();
 
+  /**
+   * @brief Recycles this stunt double to stand in for another character
+   */
+  void Reset(std::shared_ptr<Character> ref);
+
   void Init() override;
   void OnDelete();
   void OnUpdate(double elapsed);
   bool CanMoveTo(Battle::Tile*) override;
-};
\ No newline at end of file
+};
+
+/**
+ * @class StuntDoublePool
+ * @brief Hands out stunt doubles and takes them back when the last reference is gone
+ *
+ * Every stunt double handed out gets a new shared_ptr control block. Weak
+ * references to a previous use expire as normal, so scripts that kept one
+ * never see the recycled double.
+ *
+ * Stunt doubles that are still alive when the pool is destroyed are freed normally.
+ */
+class StuntDoublePool {
+  struct Storage {
+    std::vector<StuntDouble*> idle;
+    ~Storage();
+  };
+
+  std::shared_ptr<Storage> storage;
+
+public:
+  StuntDoublePool();
+
+  /**
+   * @brief Reuses an idle stunt double or makes a new one, ready to be added to the field
+   */
+  std::shared_ptr<StuntDouble> Acquire(std::shared_ptr<Character> ref);
+
+  const size_t IdleCount() const;
+};
@@ -2,15 +2,11 @@
 #include <cmath>
 #include <cctype> // for control codes
 
-void Text::AddLetterQuad(sf::Vector2f position, const sf::Color & color, char letter) const
-{
-  font.SetLetter(letter);
-  const auto texcoords = font.GetTextureCoords();
-  const auto origin = font.GetOrigin();
-  const sf::Texture& texture = font.GetTexture();
-  float width  = static_cast<float>(texture.getSize().x);
-  float height = static_cast<float>(texture.getSize().y);
-  
+void Text::AddLetterQuad(sf::Vector2f position, const sf::Color & color, const Font::Glyph& glyph) const
+{
+  const sf::IntRect& texcoords = glyph.texcoords;
+  const sf::Vector2f& origin = glyph.origin;
+
   float left   = 0;
   float top    = 0;
   float right  = static_cast<float>(texcoords.width);
@@ -39,22 +35,28 @@ void Text::AddLetterQuad(sf::Vector2f position, const sf::Color & color, char le
 
 void Text::UpdateGeometry() const
 {
-  if (!geometryDirty) return;
-
-  vertices.clear();
-  bounds = sf::FloatRect();
+  if (geometryDirty) {
+    vertices.clear();
+    bounds = sf::FloatRect();
+    laidOut = 0;
+    cursor = sf::Vector2f();
+    layoutWidth = 0.f;
+    geometryDirty = false;
+  }
 
-  if (message.empty()) return; // nothing to draw
+  if (laidOut >= message.size()) return; // nothing new to draw
 
   // Precompute the variables needed by the algorithm
   float whitespaceWidth = font.GetWhiteSpaceWidth();
   whitespaceWidth += letterSpacing;
   float lineSpacing = font.GetLineHeight() * Text::lineSpacing;
-  float x = 0.f;
-  float y = 0.f;
-  float width = 0.f;
+  float& x = cursor.x;
+  float& y = cursor.y;
+  float& width = layoutWidth;
+
+  for (size_t i = laidOut; i < message.size(); i++) {
+    char letter = message[i];
 
-  for (char letter : message) {
     // Handle special characters
     if ((letter == L' ') || (letter == L'\n') || (letter == L'\t'))
     {
@@ -68,21 +70,23 @@ void Text::UpdateGeometry() const
       // skip user-defined control codes
       if (letter > 0 && iscntrl(letter)) continue;
 
-      AddLetterQuad(sf::Vector2f(x, y), color, letter);
+      const Font::Glyph& glyph = font.GetGlyph(letter);
 
-      x += font.GetLetterWidth() + letterSpacing;
+      AddLetterQuad(sf::Vector2f(x, y), color, glyph);
+
+      x += glyph.advance + letterSpacing;
     }
 
     width = std::max(x, width);
   }
 
+  laidOut = message.size();
+
   // Update the bounding rectangle
   bounds.left = 0;
   bounds.top = 0;
   bounds.width = width;
   bounds.height = y + lineSpacing;
-
-  geometryDirty = false;
 }
 
 Text::Text(const Font& font) : font(font), message(""), geometryDirty(true)
@@ -110,6 +114,9 @@ Text::Text(const Text& rhs) : font(rhs.font)
   bounds = rhs.bounds;
   vertices = rhs.vertices;
   geometryDirty = rhs.geometryDirty;
+  laidOut = rhs.laidOut;
+  cursor = rhs.cursor;
+  layoutWidth = rhs.layoutWidth;
 }
 
 Text::~Text()
@@ -134,7 +141,10 @@ void Text::SetFont(const Font& font)
 
 void Text::SetString(const std::string& message)
 {
-  geometryDirty |= Text::message != message;
+  // Typing text out only appends letters, so keep the quads already laid out
+  bool appended = message.size() >= Text::message.size() && message.compare(0, Text::message.size(), Text::message) == 0;
+
+  geometryDirty |= !appended;
   Text::message = message;
 }
 
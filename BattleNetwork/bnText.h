@@ -12,11 +12,14 @@ private:
   mutable sf::FloatRect bounds;
   mutable sf::VertexArray vertices;
   mutable bool geometryDirty; //!< Flag if text needs to be recomputed due to a change in properties
+  mutable size_t laidOut{}; //!< Number of characters of message already in the vertex array
+  mutable sf::Vector2f cursor{}; //!< Where the next letter is placed
+  mutable float layoutWidth{}; //!< Widest line laid out so far
 
   // Add a glyph quad to the vertex array
-  void AddLetterQuad(sf::Vector2f position, const sf::Color& color, char letter) const;
+  void AddLetterQuad(sf::Vector2f position, const sf::Color& color, const Font::Glyph& glyph) const;
 
-  // Computes geometry before draw
+  // Computes geometry before draw. Letters appended since the last call are added without rebuilding the rest.
   void UpdateGeometry() const;
 
 public:
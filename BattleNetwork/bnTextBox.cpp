@@ -3,11 +3,35 @@
 #include "bnTextureResourceManager.h"
 #include "stx/string.h"
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <tuple>
+
 namespace {
   const char dramatic_token = '\x01';
   const char nolip_token = '\x02';
   const char fast_token = '\x03';
   const auto special_chars = { ::nolip_token, ::dramatic_token, ' ',  '\n' };
+
+  bool IsEffectToken(char c) {
+    return c == ::nolip_token || c == ::dramatic_token || c == ::fast_token;
+  }
+
+  //!< Result of word wrapping a message in an area
+  struct WrappedMessage {
+    std::string message;
+    std::vector<int> lines;
+    std::vector<int> insertedNewLines;
+    int numberOfFittingLines{};
+  };
+
+  //!< font style, area width, area height, unformatted message
+  using WrapKey = std::tuple<Font::Style, int, int, std::string>;
+
+  // NPCs and menus show the same messages over and over
+  std::mutex wrapCacheMutex;
+  std::map<WrapKey, WrappedMessage> wrapCache;
 }
 
 TextBox::TextBox(int width, int height) :
@@ -40,6 +64,21 @@ void TextBox::FormatToFit() {
   message = stx::replace(message, "\\x01", "\x01"); // replace ascii
   message = stx::replace(message, "\\x02", "\x02"); // replace ascii
 
+  WrapKey key{ font.GetStyle(), areaWidth, areaHeight, message };
+
+  {
+    std::scoped_lock lock(wrapCacheMutex);
+
+    if (auto iter = wrapCache.find(key); iter != wrapCache.end()) {
+      message = iter->second.message;
+      lines = iter->second.lines;
+      insertedNewLines = iter->second.insertedNewLines;
+      numberOfFittingLines = iter->second.numberOfFittingLines;
+      text.SetString("");
+      return;
+    }
+  }
+
   insertedNewLines.clear();
   lines.push_back(0); // All text begins at pos 0
 
@@ -52,6 +91,10 @@ void TextBox::FormatToFit() {
 
   double fitHeight = 0;
 
+  // The measured string grows by one letter per step until a line break
+  std::string fitString;
+  int fitStart = -1, fitEnd = -1;
+
   while (index < message.size()) {
     auto iter = std::find(::special_chars.begin(), ::special_chars.end(), message[index]);
     if (iter == special_chars.end()) {
@@ -63,12 +106,19 @@ void TextBox::FormatToFit() {
       wordIndex = -1;
     }
 
-    std::string fitString = message.substr(lastRow, (size_t)index - (size_t)lastRow + 1);
+    if (fitStart == lastRow && fitEnd == index) {
+      // fx sections shouldn't increase real estate...
+      if (!IsEffectToken(message[index])) {
+        fitString.push_back(message[index]);
+      }
+    }
+    else {
+      fitString = message.substr(lastRow, (size_t)index - (size_t)lastRow + 1);
+      fitString.erase(std::remove_if(fitString.begin(), fitString.end(), IsEffectToken), fitString.end());
+      fitStart = lastRow;
+    }
 
-    // fx sections shouldn't increase real estate...
-    fitString = stx::replace(fitString, std::string(1, ::nolip_token), ""); 
-    fitString = stx::replace(fitString, std::string(1, ::dramatic_token), "");
-    fitString = stx::replace(fitString, std::string(1, ::fast_token), "");
+    fitEnd = index + 1;
 
     text.SetString(fitString);
 
@@ -96,6 +146,7 @@ void TextBox::FormatToFit() {
     else if (width > areaWidth && wordIndex != -1 && wordIndex > lastRow + 1) {
       // Line break at the next word
       message.insert(wordIndex, "\n");
+      fitStart = -1;
 
       lastRow = wordIndex + 1;
       lines.push_back(lastRow);
@@ -116,6 +167,7 @@ void TextBox::FormatToFit() {
 
       lastRow = index;
       message.insert(lastRow, "\n");
+      fitStart = -1;
       lines.push_back(lastRow + 1);
       insertedNewLines.push_back(lastRow + 1);
 
@@ -133,6 +185,14 @@ void TextBox::FormatToFit() {
   text.SetString("");
 
   numberOfFittingLines = line;
+
+  std::scoped_lock lock(wrapCacheMutex);
+
+  if (wrapCache.size() >= BN_TEXTBOX_WRAP_CACHE_SIZE) {
+    wrapCache.clear();
+  }
+
+  wrapCache.emplace(std::move(key), WrappedMessage{ message, lines, insertedNewLines, numberOfFittingLines });
 }
 
 const bool TextBox::ProcessSpecialCharacters(int& pos) {
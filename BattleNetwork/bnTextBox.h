@@ -10,6 +10,8 @@
 #include "bnFont.h"
 #include "bnResourceHandle.h"
 
+#define BN_TEXTBOX_WRAP_CACHE_SIZE 128 //!< Wrapped messages kept before the cache is emptied
+
 class TextBox : public sf::Drawable, public sf::Transformable, public ResourceHandle {
 public:
   typedef uint16_t vfx;
@@ -45,6 +47,8 @@ private:
 
   /**
    * @brief Takes the input message and finds where the text breaks to form new lines
+   *
+   * Results are cached per font style and area so repeated messages skip the measuring.
    */
   void FormatToFit();
   void StoreCurrentBlock();
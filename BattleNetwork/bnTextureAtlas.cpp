@@ -0,0 +1,144 @@
+#include "bnTextureAtlas.h"
+#include "bnLogger.h"
+
+#include <algorithm>
+
+TextureRegion TextureRegion::Whole(const std::shared_ptr<sf::Texture>& texture)
+{
+  if (!texture) return {};
+
+  sf::Vector2u size = texture->getSize();
+  return { texture, sf::IntRect(0, 0, static_cast<int>(size.x), static_cast<int>(size.y)) };
+}
+
+TextureAtlas::TextureAtlas(unsigned pageSize, unsigned maxPages) :
+  pageSize(pageSize),
+  maxPages(maxPages)
+{
+}
+
+TextureRegion TextureAtlas::Add(const std::shared_ptr<sf::Texture>& texture)
+{
+  if (!texture) return {};
+
+  std::scoped_lock lock(mutex);
+
+  if (auto iter = lookup.find(texture.get()); iter != lookup.end()) {
+    if (iter->second.source.lock() == texture) {
+      return iter->second.region;
+    }
+
+    lookup.erase(iter);
+  }
+
+  const sf::Image image = texture->copyToImage();
+  const sf::Vector2u size = image.getSize();
+  const unsigned paddedWidth = size.x + BN_TEXTURE_ATLAS_PADDING * 2;
+  const unsigned paddedHeight = size.y + BN_TEXTURE_ATLAS_PADDING * 2;
+
+  if (size.x == 0 || size.y == 0 || paddedWidth > pageSize || paddedHeight > pageSize) {
+    return {};
+  }
+
+  sf::Vector2u position;
+  Page* page = nullptr;
+
+  for (Page& candidate : pages) {
+    if (Place(candidate, paddedWidth, paddedHeight, position)) {
+      page = &candidate;
+      break;
+    }
+  }
+
+  if (!page) {
+    page = NewPage();
+
+    if (!page || !Place(*page, paddedWidth, paddedHeight, position)) {
+      Logger::Logf(LogLevel::warning, "Texture atlas is full with %u pages", maxPages);
+      return {};
+    }
+  }
+
+  const unsigned x = position.x + BN_TEXTURE_ATLAS_PADDING;
+  const unsigned y = position.y + BN_TEXTURE_ATLAS_PADDING;
+  page->texture->update(image, x, y);
+
+  TextureRegion region{ page->texture, sf::IntRect(static_cast<int>(x), static_cast<int>(y), static_cast<int>(size.x), static_cast<int>(size.y)) };
+  lookup[texture.get()] = Entry{ texture, region };
+
+  stats.regions++;
+  stats.sourceBytes += static_cast<size_t>(size.x) * size.y * 4u;
+
+  return region;
+}
+
+bool TextureAtlas::Owns(const sf::Texture* texture) const
+{
+  std::scoped_lock lock(mutex);
+
+  return std::any_of(pages.begin(), pages.end(), [texture](const Page& page) {
+    return page.texture.get() == texture;
+  });
+}
+
+TextureAtlas::Stats TextureAtlas::GetStats() const
+{
+  std::scoped_lock lock(mutex);
+  return stats;
+}
+
+void TextureAtlas::LogUsage(const std::string& name) const
+{
+  Stats stats = GetStats();
+
+  Logger::Logf(LogLevel::info, "%s atlas: %zu textures in %zu pages. %zu KB as separate textures, %zu KB packed",
+    name.c_str(), stats.regions, stats.pages, stats.sourceBytes / 1024, stats.pageBytes / 1024);
+}
+
+bool TextureAtlas::Place(Page& page, unsigned width, unsigned height, sf::Vector2u& position)
+{
+  Shelf* best = nullptr;
+
+  for (Shelf& shelf : page.shelves) {
+    if (shelf.height < height || shelf.x + width > pageSize) continue;
+
+    if (!best || shelf.height < best->height) {
+      best = &shelf;
+    }
+  }
+
+  if (!best) {
+    if (page.nextShelfY + height > pageSize) return false;
+
+    page.shelves.push_back(Shelf{ page.nextShelfY, height, 0 });
+    page.nextShelfY += height;
+    best = &page.shelves.back();
+  }
+
+  position = sf::Vector2u(best->x, best->y);
+  best->x += width;
+  return true;
+}
+
+TextureAtlas::Page* TextureAtlas::NewPage()
+{
+  if (pages.size() >= maxPages) return nullptr;
+
+  auto texture = std::make_shared<sf::Texture>();
+
+  if (!texture->create(pageSize, pageSize)) {
+    Logger::Log(LogLevel::critical, "Failed to create a texture atlas page");
+    return nullptr;
+  }
+
+  // pages start with undefined contents so clear the padding texels
+  sf::Image clear;
+  clear.create(pageSize, pageSize, sf::Color::Transparent);
+  texture->update(clear);
+
+  pages.push_back(Page{ texture, {}, 0 });
+  stats.pages++;
+  stats.pageBytes += static_cast<size_t>(pageSize) * pageSize * 4u;
+
+  return &pages.back();
+}
@@ -0,0 +1,92 @@
+/*! \brief Packs many small textures into a few large pages
+ *
+ * Sprites drawn from the same page share one texture, so a list of card icons
+ * can be drawn without switching textures between them. Each added texture is
+ * copied into the first page with room for it and the caller draws the
+ * returned sub-rect of that page instead of the original texture.
+ *
+ * Pages are filled with shelves: rows as tall as the first texture placed in
+ * them. A texture goes on the open shelf that wastes the least height, or a
+ * new shelf is opened below the last one. Regions are never freed, which fits
+ * content registered once at load such as package icons.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define BN_TEXTURE_ATLAS_PAGE_SIZE 1024
+#define BN_TEXTURE_ATLAS_MAX_PAGES 4
+#define BN_TEXTURE_ATLAS_PADDING 1 //!< Empty texels around each region so neighbors never bleed in
+
+/*! \brief Part of a texture to draw */
+struct TextureRegion {
+  std::shared_ptr<sf::Texture> texture;
+  sf::IntRect rect;
+
+  /**
+   * @brief Region covering all of a texture
+   */
+  static TextureRegion Whole(const std::shared_ptr<sf::Texture>& texture);
+
+  explicit operator bool() const { return texture != nullptr; }
+};
+
+class TextureAtlas {
+public:
+  struct Stats {
+    size_t pages{};
+    size_t regions{};
+    size_t sourceBytes{}; /*!< Memory the added textures take on their own */
+    size_t pageBytes{}; /*!< Memory the pages take */
+  };
+
+  explicit TextureAtlas(unsigned pageSize = BN_TEXTURE_ATLAS_PAGE_SIZE, unsigned maxPages = BN_TEXTURE_ATLAS_MAX_PAGES);
+
+  /**
+   * @brief Copies a texture into a page. Adding the same texture again returns the same region.
+   * @return empty region if the texture is empty, larger than a page, or every page is full
+   */
+  TextureRegion Add(const std::shared_ptr<sf::Texture>& texture);
+
+  /**
+   * @brief true if the texture is one of this atlas' pages
+   */
+  bool Owns(const sf::Texture* texture) const;
+
+  Stats GetStats() const;
+
+  /**
+   * @brief Logs the memory of the added textures against the memory of the pages
+   */
+  void LogUsage(const std::string& name) const;
+
+private:
+  struct Shelf {
+    unsigned y{}, height{}, x{}; /*!< x is where the next region on this shelf goes */
+  };
+
+  struct Page {
+    std::shared_ptr<sf::Texture> texture;
+    std::vector<Shelf> shelves;
+    unsigned nextShelfY{};
+  };
+
+  struct Entry {
+    std::weak_ptr<sf::Texture> source; /*!< Address may be reused once this expires */
+    TextureRegion region;
+  };
+
+  mutable std::mutex mutex;
+  unsigned pageSize{}, maxPages{};
+  std::vector<Page> pages;
+  std::unordered_map<const sf::Texture*, Entry> lookup;
+  Stats stats;
+
+  bool Place(Page& page, unsigned width, unsigned height, sf::Vector2u& position);
+  Page* NewPage();
+};
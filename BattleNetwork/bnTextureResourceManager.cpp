@@ -5,6 +5,7 @@
 #include <sstream>
 #include <fstream>
 #include <mutex>
+#include <algorithm>
 
 using std::ifstream;
 using std::stringstream;
@@ -18,33 +19,65 @@ void TextureResourceManager::LoadAllTextures(std::atomic<int>& status)
 
 void TextureResourceManager::HandleExpiredTextureCache()
 {
-  // std::scoped_lock lock(mutex);
+  texturesFromPath.EvictExpired(BN_TEXTURE_CACHE_EXPIRE_SECONDS);
 
-  auto iter = texturesFromPath.begin();
-  while (iter != texturesFromPath.end()) {
-    if (iter->second.GetSecondsSinceLastRequest() > 60.0f) {
-      if (iter->second.IsInUse()) {
-        iter++; continue;
-      }
-
-      // 1 minute is long enough
-      Logger::Logf(LogLevel::debug, "Texture data %s expired", iter->first.c_str());
-      iter = texturesFromPath.erase(iter);
-      continue;
-    }
+  ResourceCacheStats stats = texturesFromPath.GetStats();
 
-    iter++;
+  if (stats.evictions != loggedEvictions) {
+    loggedEvictions = stats.evictions;
+    Logger::Logf(LogLevel::debug, "Texture cache: %zu textures, %zu KB, %zu hits, %zu misses, %zu evicted",
+      stats.count, stats.bytes / 1024, stats.hits, stats.misses, stats.evictions);
   }
 }
 
+void TextureResourceManager::SetCacheBudget(size_t bytes)
+{
+  texturesFromPath.SetBudget(bytes);
+}
+
+ResourceCacheStats TextureResourceManager::GetCacheStats() const
+{
+  return texturesFromPath.GetStats();
+}
+
+void TextureResourceManager::RecordCacheMisses(bool enabled)
+{
+  texturesFromPath.RecordMisses(enabled);
+}
+
+vector<string> TextureResourceManager::TakeCacheMisses()
+{
+  return texturesFromPath.TakeMissedKeys();
+}
+
 std::shared_ptr<Texture> TextureResourceManager::LoadFromFile(string _path) {
-  //std::scoped_lock lock(mutex);
+  return Load(_path, false);
+}
+
+std::shared_ptr<Texture> TextureResourceManager::LoadPinnedFromFile(const string& path) {
+  return Load(path, true);
+}
 
-  auto iter = texturesFromPath.find(_path);
+std::shared_ptr<Texture> TextureResourceManager::Load(const string& _path, bool pin) {
+  if (headless) {
+    return headlessTexture;
+  }
 
   // check cache first
-  if (iter != texturesFromPath.end()) {
-    return iter->second.GetResource();
+  if (std::shared_ptr<Texture> cached = texturesFromPath.Find(_path, pin)) {
+    return cached;
+  }
+
+  // if the path is being decoded in the background, load it now into the texture already handed out
+  PendingTexture request;
+
+  {
+    std::scoped_lock lock(asyncMutex);
+
+    if (auto iter = pending.find(_path); iter != pending.end()) {
+      request = std::move(iter->second);
+      pending.erase(iter);
+    }
   }
 
   auto pathsIter = std::find(paths.begin(), paths.end(), _path);
@@ -55,7 +88,7 @@ std::shared_ptr<Texture> TextureResourceManager::LoadFromFile(string _path) {
     skipCaching = true;
   }
 
-  std::shared_ptr<Texture> texture = std::make_shared<Texture>();
+  std::shared_ptr<Texture> texture = request.texture ? request.texture : std::make_shared<Texture>();
   
   if (!texture->loadFromFile(_path)) {
     Logger::Logf(LogLevel::critical, "Failed loading texture: %s", _path.c_str());
@@ -64,14 +97,169 @@ std::shared_ptr<Texture> TextureResourceManager::LoadFromFile(string _path) {
   }
 
   if (!skipCaching) {
-    texturesFromPath.insert(std::make_pair(_path, texture));
+    sf::Vector2u size = texture->getSize();
+    texturesFromPath.Insert(_path, texture, static_cast<size_t>(size.x) * size.y * 4u, pin);
+  }
+
+  // callers may be on any thread, so callbacks waiting on this path wait for the render thread
+  if (!request.callbacks.empty()) {
+    std::scoped_lock lock(asyncMutex);
+    request.texture = texture;
+    loadedEarly.push_back(std::move(request));
   }
 
   return texture;
 }
 
-TextureResourceManager::TextureResourceManager() {
+std::shared_ptr<Texture> TextureResourceManager::LoadFromFileAsync(const string& path, const TextureCallback& onLoaded)
+{
+  std::shared_ptr<Texture> texture = headless ? headlessTexture : texturesFromPath.Find(path);
+
+  if (texture) {
+    if (onLoaded) onLoaded(texture);
+    return texture;
+  }
+
+  {
+    std::scoped_lock lock(asyncMutex);
+
+    auto [iter, inserted] = pending.try_emplace(path);
+    PendingTexture& request = iter->second;
+
+    if (onLoaded) {
+      request.callbacks.push_back(onLoaded);
+    }
+
+    if (!inserted) {
+      return request.texture;
+    }
+
+    request.texture = texture = std::make_shared<Texture>();
+    decodeQueue.push_back(path);
+
+    if (decodeThreads.empty()) {
+      for (unsigned i = 0; i < BN_TEXTURE_DECODE_THREADS; i++) {
+        decodeThreads.emplace_back(&TextureResourceManager::DecodeLoop, this);
+      }
+    }
+  }
+
+  decodeReady.notify_one();
+  return texture;
+}
+
+void TextureResourceManager::UploadDecodedTextures(size_t byteBudget)
+{
+  vector<PendingTexture> early;
+
+  {
+    std::scoped_lock lock(asyncMutex);
+    early.swap(loadedEarly);
+  }
+
+  for (const PendingTexture& request : early) {
+    for (const TextureCallback& callback : request.callbacks) {
+      callback(request.texture);
+    }
+  }
+
+  size_t uploaded = 0;
+
+  while (uploaded == 0 || uploaded < byteBudget) {
+    DecodedImage image;
+
+    {
+      std::scoped_lock lock(asyncMutex);
+
+      if (decoded.empty()) break;
+
+      image = std::move(decoded.front());
+      decoded.pop_front();
+    }
+
+    sf::Vector2u size = image.image.getSize();
+    uploaded += std::max<size_t>(static_cast<size_t>(size.x) * size.y * 4u, 1u);
+
+    FinishPending(image);
+  }
+}
+
+void TextureResourceManager::DecodeLoop()
+{
+  while (true) {
+    DecodedImage image;
+
+    {
+      std::unique_lock lock(asyncMutex);
+      decodeReady.wait(lock, [this] { return quitDecoding || !decodeQueue.empty(); });
+
+      if (quitDecoding) return;
+
+      image.path = std::move(decodeQueue.front());
+      decodeQueue.pop_front();
+    }
+
+    image.ok = image.image.loadFromFile(image.path);
+
+    std::scoped_lock lock(asyncMutex);
+    decoded.push_back(std::move(image));
+  }
+}
+
+void TextureResourceManager::FinishPending(DecodedImage& image)
+{
+  PendingTexture request;
+
+  {
+    std::scoped_lock lock(asyncMutex);
+    auto iter = pending.find(image.path);
+
+    // LoadFromFile() already loaded it
+    if (iter == pending.end()) return;
+
+    request = std::move(iter->second);
+    pending.erase(iter);
+  }
+
+  if (!image.ok || !request.texture->loadFromImage(image.image)) {
+    Logger::Logf(LogLevel::critical, "Failed loading texture: %s", image.path.c_str());
+  }
+  else {
+    Logger::Logf(LogLevel::info, "Loaded texture: %s", image.path.c_str());
+  }
+
+  sf::Vector2u size = request.texture->getSize();
+  texturesFromPath.Insert(image.path, request.texture, static_cast<size_t>(size.x) * size.y * 4u);
+
+  for (const TextureCallback& callback : request.callbacks) {
+    callback(request.texture);
+  }
+}
+
+void TextureResourceManager::SetHeadless(bool enabled)
+{
+  headless = enabled;
+
+  // sf::Texture does not create a GL texture until it is loaded
+  if (headless && !headlessTexture) {
+    headlessTexture = std::make_shared<Texture>();
+  }
+}
+
+TextureResourceManager::TextureResourceManager() :
+  texturesFromPath(static_cast<size_t>(BN_TEXTURE_CACHE_BUDGET_MB) * 1024u * 1024u)
+{
 }
 
 TextureResourceManager::~TextureResourceManager() {
+  {
+    std::scoped_lock lock(asyncMutex);
+    quitDecoding = true;
+  }
+
+  decodeReady.notify_all();
+
+  for (std::thread& thread : decodeThreads) {
+    thread.join();
+  }
 }
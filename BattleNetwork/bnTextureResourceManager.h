@@ -4,18 +4,27 @@
  * 
  * Texture resource manager provides utilities to load textures from disc 
  * as well as hard-coded textures loaded at startup.
+ *
+ * LoadFromFileAsync() decodes images on background threads. Decoded images
+ * are uploaded to the GPU by UploadDecodedTextures() on the render thread,
+ * a few per frame, so a scene touching many new textures does not stall.
  */
 
 #pragma once
 #include "bnTextureType.h"
 #include "bnLogger.h"
-#include "bnCachedResource.h"
+#include "bnResourceCache.h"
 
 #include <SFML/Graphics.hpp>
 #include <map>
 #include <vector>
 #include <iostream>
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 using std::cerr;
 using std::endl;
@@ -25,6 +34,11 @@ using std::pair;
 using sf::Texture;
 using std::string;
 
+#define BN_TEXTURE_CACHE_BUDGET_MB 256 //!< Default memory for decoded textures kept after they are no longer used
+#define BN_TEXTURE_CACHE_EXPIRE_SECONDS 60.0f //!< Unused textures not requested for this long are dropped even under budget
+#define BN_TEXTURE_DECODE_THREADS 2 //!< Threads decoding images for LoadFromFileAsync()
+#define BN_TEXTURE_UPLOAD_BYTES_PER_FRAME (4u * 1024u * 1024u) //!< Decoded pixels uploaded per frame. At least one texture is always uploaded.
+
 class TextureResourceManager {
 public:
   TextureResourceManager();
@@ -43,16 +57,100 @@ public:
   * @brief will clean expired textures from the cache and free image data
   */
   void HandleExpiredTextureCache();
+
+  /**
+   * @brief Sets how many bytes of texture data may stay cached. Least recently used textures are evicted first.
+   * @param bytes 0 is unlimited
+   */
+  void SetCacheBudget(size_t bytes);
+
+  ResourceCacheStats GetCacheStats() const;
+
+  /**
+   * @brief While enabled, paths requested before they are cached are kept for TakeCacheMisses()
+   */
+  void RecordCacheMisses(bool enabled);
+
+  /**
+   * @brief Paths missed while recording since the last call
+   */
+  vector<string> TakeCacheMisses();
   
   /**
    * @brief Given a file path, returns a pointer to the loaded texture
    * @param _path Relative path to the application
-   * @return Texture. The texture is cached.
+   * @return Texture. The texture is cached and may be evicted once every copy of the returned pointer is released
+   *
+   * Keep the returned pointer for as long as the texture is drawn, e.g. by handing it to SpriteProxyNode::setTexture()
    */
   std::shared_ptr<Texture> LoadFromFile(string _path);
 
+  /**
+   * @brief Same as LoadFromFile() but the texture stays cached for the rest of the program
+   *
+   * For callers that keep only a reference to the texture, e.g. `sf::Sprite(*LoadPinnedFromFile(path))`
+   */
+  std::shared_ptr<Texture> LoadPinnedFromFile(const string& path);
+
+  using TextureCallback = std::function<void(const std::shared_ptr<Texture>&)>;
+
+  /**
+   * @brief Decodes the image at a path on a background thread
+   * @param path Relative path to the application
+   * @param onLoaded called by UploadDecodedTextures() once the texture is uploaded, even when a LoadFromFile() for the same path loaded it first. Called immediately if the texture is cached.
+   * @return The texture, empty until it is uploaded. Every request for a path that is still loading shares it.
+   */
+  std::shared_ptr<Texture> LoadFromFileAsync(const string& path, const TextureCallback& onLoaded = nullptr);
+
+  /**
+   * @brief Uploads images decoded for LoadFromFileAsync() and calls their callbacks
+   * @param byteBudget decoded bytes to upload before waiting for the next call
+   *
+   * Must be called from the thread that draws
+   */
+  void UploadDecodedTextures(size_t byteBudget = BN_TEXTURE_UPLOAD_BYTES_PER_FRAME);
+
+  /**
+   * @brief When headless, no image data is read or uploaded to the GPU
+   * @param enabled if true, LoadFromFile() returns the same empty texture for every path
+   *
+   * Used to run battles on machines without a display or graphics context
+   */
+  void SetHeadless(bool enabled);
+
 private:
-  std::mutex mutex;
+  bool headless{ false };
+  std::shared_ptr<Texture> headlessTexture; /**< Empty texture shared by every request in headless mode */
   vector<string> paths; /**< Paths to all textures. Must be in order of TextureType @see TextureType */
-  map<std::string, CachedResource<Texture>> texturesFromPath; /**< Cache for textures loaded at run-time */
+  ResourceCache<Texture> texturesFromPath; /**< Cache for textures loaded at run-time */
+  size_t loggedEvictions{}; /**< Evictions already reported in the debug log */
+
+  //!< A texture requested by LoadFromFileAsync() that is not uploaded yet
+  struct PendingTexture {
+    std::shared_ptr<Texture> texture;
+    vector<TextureCallback> callbacks;
+  };
+
+  //!< Pixels decoded by a worker
+  struct DecodedImage {
+    string path;
+    sf::Image image;
+    bool ok{};
+  };
+
+  std::mutex asyncMutex; /**< Guards everything below */
+  std::condition_variable decodeReady;
+  bool quitDecoding{ false };
+  vector<std::thread> decodeThreads;
+  std::deque<string> decodeQueue; /**< Paths waiting for a worker */
+  std::deque<DecodedImage> decoded; /**< Images waiting for UploadDecodedTextures() */
+  map<string, PendingTexture> pending;
+  vector<PendingTexture> loadedEarly; /**< Loaded by LoadFromFile() while pending. Callbacks run in UploadDecodedTextures() */
+
+  void DecodeLoop();
+
+  // Uploads a decoded image into its pending texture
+  void FinishPending(DecodedImage& image);
+
+  std::shared_ptr<Texture> Load(const string& path, bool pin);
 };
\ No newline at end of file
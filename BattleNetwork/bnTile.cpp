@@ -70,11 +70,10 @@ namespace Battle {
       if (!isBattleOver) {
         this->volcanoErupt.SetFrame(1, this->volcanoSprite->getSprite()); // start over
         volcanoEruptTimer = seconds;
-        
-        std::shared_ptr<Field> field = fieldWeak.lock();
 
-        if (field && state == TileState::volcano) {
-          field->AddEntity(std::make_shared<VolcanoErupt>(), *this);
+        // This can run on a worker thread. Spawn the eruption in Update() instead.
+        if (!fieldWeak.expired() && state == TileState::volcano) {
+          volcanoErupting = true;
         }
       }
       else {
@@ -501,7 +500,7 @@ namespace Battle {
     queuedAttackers.push_back(attacker.GetID());
   }
 
-  void Tile::Update(Field& field, double _elapsed) {
+  void Tile::UpdateLocal(double _elapsed) {
     willHighlight = false;
     totalElapsed += _elapsed;
 
@@ -520,14 +519,6 @@ namespace Battle {
       volcanoSprite->setPosition(sf::Vector2f(TILE_WIDTH/2.f, 0));
     }
 
-    // We need a copy because we WILL invalidate the iterator
-    using CharacterSet = std::set<Character*, EntityComparitor>;
-    const CharacterSet deletingCharsCopy = deletingCharacters;
-    for (Character* character : deletingCharsCopy) {
-      // Can remove the character from the tile's deleting queue
-      field.UpdateEntityOnce(*character, _elapsed);
-    }
-
     // Update our tile animation and texture
     if (!isTimeFrozen) {
       if (teamCooldown > 0) {
@@ -569,6 +560,21 @@ namespace Battle {
     // animation will want to override the sprite's origin. Use setOrigin() to fix this.
     setOrigin(TILE_WIDTH / 2.0f, TILE_HEIGHT / 2.0f);
     highlightMode = TileHighlight::none;
+  }
+
+  void Tile::Update(Field& field, double _elapsed) {
+    if (volcanoErupting) {
+      volcanoErupting = false;
+      field.AddEntity(std::make_shared<VolcanoErupt>(), *this);
+    }
+
+    // We need a copy because we WILL invalidate the iterator
+    using CharacterSet = std::set<Character*, EntityComparitor>;
+    const CharacterSet deletingCharsCopy = deletingCharacters;
+    for (Character* character : deletingCharsCopy) {
+      // Can remove the character from the tile's deleting queue
+      field.UpdateEntityOnce(*character, _elapsed);
+    }
 
     // Process tile behaviors
     vector<std::shared_ptr<Character>> characters_copy = characters;
@@ -686,7 +692,7 @@ namespace Battle {
 
         if (GetState() == TileState::lava) {
           if (character.Hit(Hit::Properties({ 50, Hit::flash, Element::none, 0, Direction::none }))) {
-            field.AddEntity(std::make_shared<Explosion>(), GetX(), GetY());
+            field.AddEntity(field.AllocEntity<Explosion>(), GetX(), GetY());
             SetState(TileState::normal);
           }
         }
@@ -240,11 +240,21 @@ namespace Battle {
     void AffectEntities(Entity& attacker);
 
     /**
-     * @brief Updates all entities occupying this tile
+     * @brief Updates deleting characters, tile behaviors, and spawns from UpdateLocal()
      * @param _elapsed in seconds
+     * @warning Call after UpdateLocal() for the same frame
      */
     void Update(Field& field, double _elapsed);
 
+    /**
+     * @brief Advances timers, animation, texture, and highlight of this tile only
+     *
+     * Touches no other tile or entity so the field may run it for every tile at
+     * once. Effects on the field are queued until Update().
+     * @param _elapsed in seconds
+     */
+    void UpdateLocal(double _elapsed);
+
     /**
      * @brief Triggers this tile and all entities to behave as if time is frozen
      * @param state
@@ -368,6 +378,7 @@ namespace Battle {
     Animation animation;
     Animation volcanoErupt;
     double volcanoEruptTimer{ 4 }; // seconds
+    bool volcanoErupting{ false }; /**< Eruption queued by UpdateLocal() for Update() to spawn */
     std::shared_ptr<SpriteProxyNode> volcanoSprite;
   };
 
@@ -123,7 +123,7 @@ void TitleScene::onUpdate(double elapsed)
       std::string path = "resources/ow/prog/";
       std::string msg = "Looks like you need a Player Mod to continue.\nDownload one and put it under:\n\n`resources/\n mods/\n players/`\nThen re-launch to start playing!";
       sf::Sprite spr;
-      spr.setTexture(*Textures().LoadFromFile(path+"prog_mug.png"));
+      spr.setTexture(*Textures().LoadPinnedFromFile(path+"prog_mug.png"));
       currMessage = new Message(msg);
       currMessage->ShowEndMessageCursor();
       textbox.EnqueMessage(spr, path + "prog_mug.animation", currMessage);
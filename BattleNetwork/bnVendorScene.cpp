@@ -71,18 +71,18 @@ VendorScene::VendorScene(
 {
   label.setScale(2.f, 2.f);
 
-  moreItems.setTexture(*Textures().LoadFromFile(TexturePaths::TEXT_BOX_NEXT_CURSOR));
+  moreItems.setTexture(*Textures().LoadPinnedFromFile(TexturePaths::TEXT_BOX_NEXT_CURSOR));
   moreItems.setScale(2.f, 2.f);
 
-  wallet.setTexture(*Textures().LoadFromFile("resources/scenes/vendors/price.png"), true);
+  wallet.setTexture(*Textures().LoadPinnedFromFile("resources/scenes/vendors/price.png"), true);
   wallet.setScale(0.f, 0.f); // hide
   wallet.setPosition(340, 0.f);
 
-  list.setTexture(*Textures().LoadFromFile("resources/scenes/vendors/list.png"), true);
+  list.setTexture(*Textures().LoadPinnedFromFile("resources/scenes/vendors/list.png"), true);
   list.setScale(0.f, 0.f); // hide
   list.setPosition(0.f, 0.f);
 
-  cursor.setTexture(*Textures().LoadFromFile(TexturePaths::TEXT_BOX_CURSOR));
+  cursor.setTexture(*Textures().LoadPinnedFromFile(TexturePaths::TEXT_BOX_CURSOR));
   cursor.setScale(2.f, 2.f);
 
   bg = new VendorBackground;
@@ -4,6 +4,8 @@
 
 void VirtualInputState::Process()
 {
+  processedQueue = queuedState;
+
   // Prioritize press events only (discard release events)
   for (auto iter = queuedState.begin(); iter != queuedState.end(); /* skip */) {
     auto& event = *iter;
@@ -54,6 +56,11 @@ const std::unordered_map<std::string, InputState> VirtualInputState::ToHash() co
   return state;
 }
 
+const std::unordered_map<std::string, InputState>& VirtualInputState::EventsThisFrame() const
+{
+  return processedQueue;
+}
+
 bool VirtualInputState::Has(InputEvent event) const
 {
   auto it = state.find(event.name);
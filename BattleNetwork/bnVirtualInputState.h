@@ -9,10 +9,19 @@ using std::vector;
 class VirtualInputState {
 private:
   std::unordered_map<std::string, InputState> state, stateLastFrame, queuedState;
+  std::unordered_map<std::string, InputState> processedQueue; /*!< Key events the last Process() call consumed */
 
 public:
   void Process();
   const std::unordered_map<std::string, InputState> ToHash() const;
+
+  /**
+   * @brief The raw key events the last Process() call turned into this frame's state
+   *
+   * Queuing these again with VirtualKeyEvent() on another input state reproduces the same
+   * pressed, held, and released states. Replays record these instead of the processed state.
+   */
+  const std::unordered_map<std::string, InputState>& EventsThisFrame() const;
   /**
    * @brief Queries if an input event has been fired
    * @param _event the event to look for.
@@ -0,0 +1,205 @@
+// Entry point for the headless battle simulator.
+// Runs a single mob battle with scripted inputs and no window, rendering, or audio.
+// Intended for stress-testing player, mob, and card packages on machines without a display.
+
+#include "../bnHeadlessBattle.h"
+#include "../bnLogger.h"
+#include "../bnProfiler.h"
+#include "../cxxopts/cxxopts.hpp"
+
+#include "../bnBattleReplay.h"
+#include "../bnVirtualInputState.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <map>
+
+static cxxopts::Options options("ONBHeadless", "Open Net Battle headless battle simulator");
+
+namespace {
+  using FrameState = std::map<std::string, InputState>;
+
+  FrameState Sorted(const std::unordered_map<std::string, InputState>& state) {
+    FrameState sorted;
+
+    for (auto& [name, value] : state) {
+      if (value != InputState::none) {
+        sorted[name] = value;
+      }
+    }
+
+    return sorted;
+  }
+
+  /**
+   * @brief Records scripted key events into a replay, saves and loads it, plays it back
+   * through a fresh input state, and compares the processed state of every frame
+   */
+  int TestReplayRoundTrip() {
+    const frame_time_t length = frames(120);
+
+    // Raw events as the input manager queues them: held keys are sent every frame,
+    // some keys are released explicitly, taps last a single frame
+    auto eventsOn = [](int64_t frame) {
+      std::unordered_map<std::string, InputState> events;
+
+      if (frame >= 10 && frame < 30) events["Shoot"] = InputState::pressed;
+      if (frame == 30) events["Shoot"] = InputState::released;
+      if (frame >= 31 && frame < 33) events["Shoot"] = InputState::pressed;
+      if (frame % 7 == 0) events["Move Left"] = InputState::pressed;
+      if (frame >= 50 && frame < 90) events["Use Card"] = InputState::pressed;
+      if (frame == 60 || frame == 61) events["Move Up"] = InputState::released;
+
+      return events;
+    };
+
+    BattleReplay recording;
+    VirtualInputState live;
+    std::vector<FrameState> expected;
+
+    for (frame_time_t frame{}; frame < length; frame++) {
+      for (auto& [name, state] : eventsOn(frame.count())) {
+        live.VirtualKeyEvent(InputEvent{ name, state });
+      }
+
+      live.Process();
+      recording.RecordFrame(0, frame, live.EventsThisFrame());
+      expected.push_back(Sorted(live.ToHash()));
+    }
+
+    const std::string path = (std::filesystem::temp_directory_path() / "onb_replay_round_trip.onbr").string();
+
+    if (!recording.Save(path)) return EXIT_FAILURE;
+
+    stx::result_t<BattleReplay> loaded = BattleReplay::Load(path);
+    std::error_code error;
+    std::filesystem::remove(path, error);
+
+    if (loaded.is_error()) {
+      std::cerr << loaded.error_cstr() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    VirtualInputState replayed;
+    size_t mismatches{};
+
+    for (frame_time_t frame{}; frame < length; frame++) {
+      loaded.value().PlayFrame(0, frame, [&replayed](const InputEvent& event) {
+        replayed.VirtualKeyEvent(event);
+      });
+
+      replayed.Process();
+
+      if (Sorted(replayed.ToHash()) != expected[static_cast<size_t>(frame.count())]) {
+        std::cerr << "Replayed input state differs on frame " << frame.count() << std::endl;
+        mismatches++;
+      }
+    }
+
+    std::printf("replay round trip: %lld frames, %zu mismatches\n", static_cast<long long>(length.count()), mismatches);
+    return mismatches ? EXIT_FAILURE : EXIT_SUCCESS;
+  }
+}
+
+int main(int argc, char** argv) {
+  options.add_options()
+    ("h,help", "Print all options")
+    ("v,verbose", "Print engine logs")
+    ("mob", "name of mob package", cxxopts::value<std::string>()->default_value(""))
+    ("player", "name of player package", cxxopts::value<std::string>()->default_value(""))
+    ("folder", "path to folder list on disk where each line contains a card package name and code e.g. `com.example.MockCard A`", cxxopts::value<std::string>()->default_value(""))
+    ("inputs", "path to input script on disk where each line contains an inclusive frame range and input name e.g. `120 125 Move Up`", cxxopts::value<std::string>()->default_value(""))
+    ("seed", "seed for the battle's random number generators", cxxopts::value<unsigned int>()->default_value("0"))
+    ("frames", "max number of frames to simulate", cxxopts::value<int64_t>()->default_value("18000"))
+    ("profile", "path to write a Chrome trace JSON of the profiler zones to", cxxopts::value<std::string>()->default_value(""))
+    ("record", "path to write an input replay of the battle to", cxxopts::value<std::string>()->default_value(""))
+    ("replay", "path to an input replay to play back. Replaces `player`, `mob`, `folder`, `inputs`, and `seed`", cxxopts::value<std::string>()->default_value(""))
+    ("test-replay-round-trip", "Record scripted inputs, play them back, and exit with an error if any frame's input state differs");
+
+  try {
+    cxxopts::ParseResult parsedOptions = options.parse(argc, argv);
+
+    if (parsedOptions.count("help")) {
+      std::cout << options.help() << std::endl;
+      return EXIT_SUCCESS;
+    }
+
+    Logger::SetLogLevel(parsedOptions["verbose"].as<bool>() ? LogLevel::all : LogLevel::critical);
+
+    if (parsedOptions.count("test-replay-round-trip")) {
+      return TestReplayRoundTrip();
+    }
+
+    HeadlessBattleProps props;
+    props.playerPackage = parsedOptions["player"].as<std::string>();
+    props.mobPackage = parsedOptions["mob"].as<std::string>();
+    props.folderPath = parsedOptions["folder"].as<std::string>();
+    props.seed = parsedOptions["seed"].as<unsigned int>();
+    props.maxFrames = frames(parsedOptions["frames"].as<int64_t>());
+
+    BattleReplay replay;
+    const std::string replayPath = parsedOptions["replay"].as<std::string>();
+    if (!replayPath.empty()) {
+      stx::result_t<BattleReplay> result = BattleReplay::Load(replayPath);
+
+      if (result.is_error()) {
+        std::cerr << result.error_cstr() << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      replay = result.value();
+      props.replay = &replay;
+    }
+
+    if (!props.replay && (props.playerPackage.empty() || props.mobPackage.empty())) {
+      std::cerr << "Headless mode needs `player` and `mob` input arguments" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    const std::string inputPath = parsedOptions["inputs"].as<std::string>();
+    if (!inputPath.empty()) {
+      props.inputs = HeadlessBattle::LoadInputsFromFile(inputPath);
+    }
+
+    const std::string profilePath = parsedOptions["profile"].as<std::string>();
+    Profiler::SetEnabled(!profilePath.empty());
+
+    HeadlessBattle battle;
+    battle.LoadPackages();
+
+    HeadlessBattleResults results = battle.Run(props);
+
+    const double fps = results.wallSeconds > 0.0 ? results.frames.count() / results.wallSeconds : 0.0;
+
+    std::printf("outcome: %s\n", HeadlessBattleResults::OutcomeName(results.outcome));
+    std::printf("frames: %lld\n", static_cast<long long>(results.frames.count()));
+    std::printf("wall time: %.6f secs (%.1f fps)\n", results.wallSeconds, fps);
+
+    for (size_t i = 0; i < results.phaseSeconds.size(); i++) {
+      auto phase = static_cast<HeadlessBattleResults::Phase>(i);
+      std::printf("  %-6s %.6f secs\n", HeadlessBattleResults::PhaseName(phase), results.phaseSeconds[i]);
+    }
+
+    std::printf("state hash: %016llx\n", static_cast<unsigned long long>(results.stateHash));
+
+    if (!profilePath.empty()) {
+      Profiler::ExportChromeTrace(profilePath);
+    }
+
+    const std::string recordPath = parsedOptions["record"].as<std::string>();
+    if (!recordPath.empty() && !results.replay.Save(recordPath)) {
+      return EXIT_FAILURE;
+    }
+  }
+  catch (cxxopts::OptionException& e) {
+    std::cerr << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  catch (std::exception& e) {
+    Logger::Log(LogLevel::critical, e.what());
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
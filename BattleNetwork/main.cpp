@@ -17,6 +17,9 @@
 #include "bnPlayer.h"
 #include "bnEmotions.h"
 #include "bnCardFolder.h"
+#include "bnBattleReplay.h"
+#include "bnAnimationBinary.h"
+#include "bnFileUtil.h"
 #include "stx/string.h"
 #include "stx/result.h"
 #include "cxxopts/cxxopts.hpp"
@@ -26,6 +29,9 @@
 #include <Poco/URI.h>
 #include <Poco/StreamCopier.h>
 
+#include <chrono>
+#include <filesystem>
+
 // Launches the standard game with full setup and configuration
 int LaunchGame(Game& g, const cxxopts::ParseResult& results);
 
@@ -36,15 +42,18 @@ int HandleBattleOnly(Game& g, TaskGroup tasks, const std::string& playerpath, co
 template<typename ScriptedDataType, typename PackageManager>
 stx::result_t<std::string> DownloadPackageFromURL(const std::string& url, PackageManager& packageManager);
 
-// Feeds battle-mode with a list of card mods for ez testing
-std::unique_ptr<CardFolder> LoadFolderFromFile(const std::string& filePath, CardPackageManager& packageManager);
-
 // If filter is empty, lists all packages and hash pairs.
 void PrintPackageHash(Game& g, TaskGroup tasks);
 
 // Reads a zip mod on disk and displays the package ID and hash
 void ReadPackageAndHash(const std::string& path, const std::string& modType);
 
+// Writes the compiled form of every .animation file found under a directory
+int CompileAnimations(const std::string& directory);
+
+// Times parsing every .animation file under a directory as text and as compiled data
+int BenchmarkAnimations(const std::string& directory);
+
 static cxxopts::Options options("ONB", "Open Net Battle Engine");
 
 int main(int argc, char** argv) {
@@ -58,7 +67,12 @@ int main(int argc, char** argv) {
     ("p,port", "port for PVP", cxxopts::value<int>()->default_value("0"))
     ("r,remotePort", "remote port for main hub", cxxopts::value<int>()->default_value(std::to_string(NetPlayConfig::OBN_PORT)))
     ("w,cyberworld", "ip address of main hub", cxxopts::value<std::string>()->default_value(""))
-    ("m,mtu", "Maximum Transmission Unit - adjust to send big packets", cxxopts::value<uint16_t>()->default_value(std::to_string(NetManager::DEFAULT_MAX_PAYLOAD_SIZE)));
+    ("m,mtu", "Maximum Transmission Unit - adjust to send big packets", cxxopts::value<uint16_t>()->default_value(std::to_string(NetManager::DEFAULT_MAX_PAYLOAD_SIZE)))
+    ("interpolate", "draw overworld actors between logic ticks and pace frames with vsync instead of capping them at 60 fps", cxxopts::value<bool>()->default_value("true"))
+    ("profile", "record profiler zones from startup and write a Chrome trace JSON to this path on exit", cxxopts::value<std::string>()->default_value(""))
+    ("texture-budget", "megabytes of unused textures to keep cached. 0 is unlimited", cxxopts::value<int>()->default_value(std::to_string(BN_TEXTURE_CACHE_BUDGET_MB)))
+    ("audio-budget", "megabytes of unused sound effects to keep cached. 0 is unlimited", cxxopts::value<int>()->default_value(std::to_string(BN_AUDIO_CACHE_BUDGET_MB)))
+    ("rebuild-package-cache", "zip and hash every package again instead of reusing fingerprints of unchanged packages");
 
   // Battle-only specific flags
   options.add_options("Battle Only Mode")
@@ -66,13 +80,17 @@ int main(int argc, char** argv) {
     ("mob", "path to mob package", cxxopts::value<std::string>()->default_value(""))
     ("moburl", "path to mob file to download from a web address", cxxopts::value<std::string>()->default_value(""))
     ("player", "name of player package", cxxopts::value<std::string>()->default_value(""))
-    ("folder", "path to folder list on disk where each line contains a card package name and code e.g. `com.example.MockCard A`", cxxopts::value<std::string>()->default_value(""));
+    ("folder", "path to folder list on disk where each line contains a card package name and code e.g. `com.example.MockCard A`", cxxopts::value<std::string>()->default_value(""))
+    ("record", "path to write an input replay of the battle to", cxxopts::value<std::string>()->default_value(""))
+    ("replay", "path to an input replay to play back. Replaces `player`, `mob`, and `folder`", cxxopts::value<std::string>()->default_value(""));
 
   // Utility specific flags
   options.add_options("Utilities")
     ("i,installed", "List the successfully loaded mods and their hashes")
     ("j,hash", "path to a mod .zip anywhere on disk then display the md5 and package id pair to screen", cxxopts::value<std::string>()->default_value(""))
-    ("t,type", "specifies the one type of mod to parse [player|block|card|mob|lib]", cxxopts::value<std::string>()->default_value(""));
+    ("t,type", "specifies the one type of mod to parse [player|block|card|mob|lib]", cxxopts::value<std::string>()->default_value(""))
+    ("compile-animations", "compile every .animation file under this directory to a " ANIMATION_BINARY_EXTENSION " file next to it", cxxopts::value<std::string>()->default_value(""))
+    ("benchmark-animations", "compare loading every .animation file under this directory from text and from its compiled file", cxxopts::value<std::string>()->default_value(""));
 
   // Prevent throwing exceptions on bad input
   options.allow_unrecognised_options();
@@ -86,6 +104,15 @@ int main(int argc, char** argv) {
       return EXIT_SUCCESS;
     }
 
+    // Animation tools do not need a window
+    if (const std::string& dir = parsedOptions["compile-animations"].as<std::string>(); !dir.empty()) {
+      return CompileAnimations(dir);
+    }
+
+    if (const std::string& dir = parsedOptions["benchmark-animations"].as<std::string>(); !dir.empty()) {
+      return BenchmarkAnimations(dir);
+    }
+
     DrawWindow win;
     win.Initialize("Open Net Battle v2.0a", DrawWindow::WindowMode::window);
     Game game{ win };
@@ -182,13 +209,14 @@ int LaunchGame(Game& g, const cxxopts::ParseResult& results) {
     std::string moburl = g.CommandLineValue<std::string>("moburl");
     std::string folderpath = g.CommandLineValue<std::string>("folder");
     bool url = false;
+    bool replay = !g.CommandLineValue<std::string>("replay").empty();
 
-    if (playerpath.empty()) {
+    if (playerpath.empty() && !replay) {
       Logger::Logf(LogLevel::critical, "Battleonly mode needs `player` input argument");
       return EXIT_FAILURE;
     }
 
-    if (mobpath.empty() && moburl.empty()) {
+    if (mobpath.empty() && moburl.empty() && !replay) {
       Logger::Logf(LogLevel::critical, "Battleonly mode needs `mob` or `moburl` input argument");
       return EXIT_FAILURE;
     }
@@ -251,6 +279,38 @@ int HandleBattleOnly(Game& g, TaskGroup tasks, const std::string& playerpath, co
     tasks.DoNextTask();
   }
 
+  std::string playerid = playerpath;
+  std::unique_ptr<BattleReplay> replay;
+  const std::string& replayPath = g.CommandLineValue<std::string>("replay");
+  const std::string& recordPath = g.CommandLineValue<std::string>("record");
+
+  auto& playerPackages = g.PlayerPackagePartitioner().GetPartition(Game::LocalPartition);
+  auto& mobPackages = g.MobPackagePartitioner().GetPartition(Game::LocalPartition);
+  auto& cardPackages = g.CardPackagePartitioner().GetPartition(Game::LocalPartition);
+
+  if (!replayPath.empty()) {
+    auto result = BattleReplay::Load(replayPath);
+    if (result.is_error()) {
+      Logger::Log(LogLevel::critical, result.error_cstr());
+      return EXIT_FAILURE;
+    }
+
+    replay = std::make_unique<BattleReplay>(result.value());
+
+    bool hasPlayer = BattleReplay::VerifyPackage(playerPackages, replay->player) || playerPackages.HasPackage(replay->player.packageId);
+    bool hasMob = BattleReplay::VerifyPackage(mobPackages, replay->mob) || mobPackages.HasPackage(replay->mob.packageId);
+
+    if (!hasPlayer || !hasMob) {
+      return EXIT_FAILURE;
+    }
+
+    playerid = replay->player.packageId;
+    mobid = replay->mob.packageId;
+  }
+
+  // Reseed right before the battle is built so recordings and playback consume the same random numbers
+  g.SeedRand(replay ? replay->seed : g.GetRandSeed());
+
   ResourceHandle handle;
 
   // Play the pre battle rumble sound
@@ -262,19 +322,41 @@ int HandleBattleOnly(Game& g, TaskGroup tasks, const std::string& playerpath, co
   auto field = std::make_shared<Field>(6, 3);
 
   // Get the navi we selected
-  auto& playermeta = g.PlayerPackagePartitioner().GetPartition(Game::LocalPartition).FindPackageByID(playerpath);
+  auto& playermeta = playerPackages.FindPackageByID(playerid);
   const std::string& image = playermeta.GetMugshotTexturePath();
   Animation mugshotAnim = Animation() << playermeta.GetMugshotAnimationPath();
   const std::string& emotionsTexture = playermeta.GetEmotionsTexturePath();
-  auto mugshot = handle.Textures().LoadFromFile(image);
+  auto mugshot = handle.Textures().LoadPinnedFromFile(image);
   auto emotions = handle.Textures().LoadFromFile(emotionsTexture);
   auto player = std::shared_ptr<Player>(playermeta.GetData());
 
-  auto& mobmeta = g.MobPackagePartitioner().GetPartition(Game::LocalPartition).FindPackageByID(mobid);
+  auto& mobmeta = mobPackages.FindPackageByID(mobid);
   Mob* mob = mobmeta.GetData()->Build(field);
 
-  // Shuffle our new folder
-  std::unique_ptr<CardFolder> folder = LoadFolderFromFile(folderPath, g.CardPackagePartitioner().GetPartition(Game::LocalPartition));
+  std::unique_ptr<CardFolder> folder;
+
+  if (replay) {
+    // Replays store the folder already shuffled
+    folder = replay->BuildFolder(cardPackages);
+  }
+  else {
+    // Shuffle our new folder
+    folder = LoadFolderFromFile(folderPath, cardPackages);
+    folder->Shuffle();
+  }
+
+  if (!recordPath.empty()) {
+    BattleReplay header;
+    header.seed = g.GetRandSeed();
+    header.player = BattleReplay::DescribePackage(playerPackages, playerid);
+    header.mob = BattleReplay::DescribePackage(mobPackages, mobid);
+    header.RecordFolder(*folder, cardPackages);
+    g.RecordReplay(header, recordPath);
+  }
+
+  if (replay) {
+    g.PlayReplay(*replay);
+  }
 
   // Queue screen transition to Battle Scene with a white fade effect
   // just like the game
@@ -285,7 +367,7 @@ int HandleBattleOnly(Game& g, TaskGroup tasks, const std::string& playerpath, co
   static PA programAdvance;
 
   MobBattleProperties props{
-    { player, programAdvance, std::move(folder), field, mob->GetBackground() },
+    { player, programAdvance, std::move(folder), field, mob->GetBackground(), { PackageAssets::Of(mobmeta), PackageAssets::Of(playermeta) } },
     MobBattleProperties::RewardBehavior::take,
     { mob },
     sf::Sprite(*mugshot),
@@ -331,39 +413,6 @@ stx::result_t<std::string> DownloadPackageFromURL(const std::string& url, Packag
   return packageManager.template LoadPackageFromZip<ScriptedDataType>(outpath);
 }
 
-std::unique_ptr<CardFolder> LoadFolderFromFile(const std::string& filePath, CardPackageManager& packageManager) {
-  std::unique_ptr<CardFolder> folder = std::make_unique<CardFolder>();
-  std::fstream file;
-  file.open(filePath, std::ios::in); 
-  const char space = ' ';
-
-  if (file.is_open()) {
-    std::string line;
-    while (std::getline(file, line)) { 
-      std::vector<std::string> tokens = stx::tokenize(line, space);
-
-      if (tokens.size() < 2) {
-        Logger::Logf(LogLevel::debug, "Card folder list needs two entries per line: `PACKAGE_ID CODE`");
-        continue;
-      }
-      const std::string packageID = tokens[0];
-      char code = tokens[1][0];
-      code = std::isalpha(code) ? code : '*';
-
-      if (packageManager.HasPackage(packageID)) {
-        Battle::Card::Properties props = packageManager.FindPackageByID(packageID).GetCardProperties();
-        props.code = code;
-        folder->AddCard(props);
-      }
-    }
-
-    file.close();
-  }
-
-  folder->Shuffle();
-  return folder;
-}
-
 //!< Takes in a package manager and filters output before storing it in an output buffer `outStr` and storing the max line length for further decorating
 template<typename PackageManagerT>
 void FormatPackageHashOutput(PackageManagerT& pm, std::string& outStr, size_t& maxLineLen) {
@@ -501,4 +550,103 @@ void ReadPackageAndHash(const std::string& path, const std::string& modType) {
   }
 
   std::cout << hash << " " << id;
-}
\ No newline at end of file
+}
+
+namespace {
+  std::vector<std::string> FindAnimationFiles(const std::string& directory) {
+    std::vector<std::string> paths;
+    std::error_code error;
+
+    for (auto iter = std::filesystem::recursive_directory_iterator(directory, error); !error && iter != std::filesystem::recursive_directory_iterator(); iter.increment(error)) {
+      if (iter->is_regular_file() && iter->path().extension() == ANIMATION_EXTENSION) {
+        paths.push_back(iter->path().generic_string());
+      }
+    }
+
+    if (error) {
+      std::cerr << "Could not read directory " << directory << ": " << error.message() << std::endl;
+    }
+
+    return paths;
+  }
+}
+
+int CompileAnimations(const std::string& directory) {
+  size_t compiled{};
+  std::vector<std::string> paths = FindAnimationFiles(directory);
+
+  for (const std::string& path : paths) {
+    if (AnimationBinary::Compile(path)) {
+      compiled++;
+    }
+    else {
+      std::cerr << "Failed to compile " << path << std::endl;
+    }
+  }
+
+  std::cout << "Compiled " << compiled << " of " << paths.size() << " animation files" << std::endl;
+  return compiled == paths.size() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int BenchmarkAnimations(const std::string& directory) {
+  using clock = std::chrono::steady_clock;
+  constexpr int rounds = 20;
+
+  // Only files with a usable compiled file next to them are compared
+  std::vector<std::string> paths;
+  size_t textBytes{}, binaryBytes{}, skipped{};
+
+  for (const std::string& path : FindAnimationFiles(directory)) {
+    Animation::FrameLists lists;
+
+    if (!AnimationBinary::Load(path, lists)) {
+      skipped++;
+      continue;
+    }
+
+    std::error_code error;
+    textBytes += static_cast<size_t>(std::filesystem::file_size(path, error));
+    binaryBytes += static_cast<size_t>(std::filesystem::file_size(AnimationBinary::CompiledPath(path), error));
+    paths.push_back(path);
+  }
+
+  // Both sides are timed from the file on disk as Animation::LoadShared() loads them.
+  // The compiled side includes the stale check, mapping and decoding.
+  clock::duration textTime{}, binaryTime{};
+  size_t mismatches{};
+
+  for (int i = 0; i < rounds; i++) {
+    for (const std::string& path : paths) {
+      auto start = clock::now();
+      const std::string source = FileUtil::Read(path);
+      Animation::FrameLists text = Animation::Parse(source, path);
+      auto middle = clock::now();
+      Animation::FrameLists binary;
+      bool ok = AnimationBinary::Load(path, binary);
+      auto end = clock::now();
+
+      textTime += middle - start;
+      binaryTime += end - middle;
+
+      if (i == 0 && (!ok || AnimationBinary::Encode(binary, source) != AnimationBinary::Encode(text, source))) {
+        std::cerr << "Compiled data does not match the text for " << path << std::endl;
+        mismatches++;
+      }
+    }
+  }
+
+  auto milliseconds = [](clock::duration time) {
+    return std::chrono::duration<double, std::milli>(time).count() / rounds;
+  };
+
+  std::cout << paths.size() << " compiled animation files, " << textBytes << " bytes of text, " << binaryBytes << " bytes compiled" << std::endl;
+
+  if (skipped) {
+    std::cout << skipped << " files skipped without a usable compiled file. Run with --compile-animations first." << std::endl;
+  }
+
+  std::cout << "read and parse text:        " << milliseconds(textTime) << " ms per pass" << std::endl;
+  std::cout << "check, map and decode file: " << milliseconds(binaryTime) << " ms per pass" << std::endl;
+
+  return mismatches ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -822,8 +822,9 @@ void DownloadScene::onDraw(sf::RenderTexture& surface)
     remainingTokens = std::max(0u, (unsigned)(remainingTokens - str.size()));
 
     sf::FloatRect bounds = label.GetLocalBounds();
-    if (std::shared_ptr<sf::Texture> iconTexture = meta.GetIconTexture()) {
-      icon.setTexture(*iconTexture, true);
+    if (const TextureRegion& region = meta.GetIconRegion()) {
+      icon.setTexture(*region.texture);
+      icon.setTextureRect(region.rect);
       float iconHeight = icon.getLocalBounds().height;
       icon.setPosition(20, h);
       icon.setOrigin(0, iconHeight/4);
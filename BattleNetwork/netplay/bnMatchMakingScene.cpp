@@ -587,7 +587,7 @@ void MatchMakingScene::onUpdate(double elapsed) {
       const std::string& image = meta.GetMugshotTexturePath();
       const std::string& mugshotAnim = meta.GetMugshotAnimationPath();
       const std::string& emotionsTexture = meta.GetEmotionsTexturePath();
-      std::shared_ptr<sf::Texture> mugshot = Textures().LoadFromFile(image);
+      std::shared_ptr<sf::Texture> mugshot = Textures().LoadPinnedFromFile(image);
       std::shared_ptr<sf::Texture> emotions = Textures().LoadFromFile(emotionsTexture);
       std::shared_ptr<Player> player = std::shared_ptr<Player>(meta.GetData());
 
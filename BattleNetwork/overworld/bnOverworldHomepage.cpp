@@ -118,7 +118,7 @@ Overworld::Homepage::Homepage(swoosh::ActivityController& controller) :
 
       // Play message
       sf::Sprite face;
-      face.setTexture(*Textures().LoadFromFile("resources/ow/prog/prog_mug.png"));
+      face.setTexture(*Textures().LoadPinnedFromFile("resources/ow/prog/prog_mug.png"));
 
       std::string message = "If you're seeing this message, something has gone horribly wrong with the next area.";
       message += "For your safety you cannot enter the next area!";
@@ -160,7 +160,7 @@ Overworld::Homepage::Homepage(swoosh::ActivityController& controller) :
 
       // Play message
       sf::Sprite face;
-      face.setTexture(*Textures().LoadFromFile("resources/ow/prog/prog_mug.png"));
+      face.setTexture(*Textures().LoadPinnedFromFile("resources/ow/prog/prog_mug.png"));
 
       std::string message = "CHANGE YOUR WARP DESTINATION?";
 
@@ -329,7 +329,7 @@ void Overworld::Homepage::onUpdate(double elapsed)
     PlayerMeta& meta = getController().PlayerPackagePartitioner().GetPartition(Game::LocalPartition).FindPackageByID(GetCurrentNaviID());
     const std::string& image = meta.GetMugshotTexturePath();
     const std::string& anim = meta.GetMugshotAnimationPath();
-    auto mugshot = Textures().LoadFromFile(image);
+    auto mugshot = Textures().LoadPinnedFromFile(image);
 
     auto& menuSystem = GetMenuSystem();
     menuSystem.SetNextSpeaker(sf::Sprite(*mugshot), anim);
@@ -153,7 +153,7 @@ void Overworld::OnlineArea::SetAvatarAsSpeaker() {
   PlayerMeta& meta = getController().PlayerPackagePartitioner().GetPartition(Game::LocalPartition).FindPackageByID(GetCurrentNaviID());
   const std::string& image = meta.GetMugshotTexturePath();
   const std::string& anim = meta.GetMugshotAnimationPath();
-  std::shared_ptr<sf::Texture> mugshot = Textures().LoadFromFile(image);
+  std::shared_ptr<sf::Texture> mugshot = Textures().LoadPinnedFromFile(image);
   GetMenuSystem().SetNextSpeaker(sf::Sprite(*mugshot), anim);
 }
 
@@ -375,12 +375,12 @@ void Overworld::OnlineArea::updatePlayer(double elapsed) {
   if (lastFrameNaviId != currentNaviId) {
     sendAvatarChangeSignal();
     lastFrameNaviId = currentNaviId;
-
-    // move the emote above the player's head
-    float emoteY = -GetPlayer()->getSprite().getOrigin().y - 10;
-    emoteNode->setPosition(0, emoteY);
   }
 
+  // move the emote above the player's head. The new navi's origin arrives with its sheet, frames after the switch.
+  float emoteY = -GetPlayer()->getSprite().getOrigin().y - 10;
+  emoteNode->setPosition(0, emoteY);
+
   if (!IsInputLocked()) {
     auto& menuSystem = GetMenuSystem();
 
@@ -1963,7 +1963,7 @@ void Overworld::OnlineArea::receiveMessageSignal(BufferReader& reader, const Poc
   auto mugAnimationPath = reader.ReadString<uint16_t>(buffer);
 
   sf::Sprite face;
-  face.setTexture(*GetTexture(mugTexturePath));
+  face.setTexture(*GetPinnedTexture(mugTexturePath));
 
   Animation animation;
   animation.LoadWithData(GetText(mugAnimationPath));
@@ -1982,7 +1982,7 @@ void Overworld::OnlineArea::receiveQuestionSignal(BufferReader& reader, const Po
   auto mugAnimationPath = reader.ReadString<uint16_t>(buffer);
 
   sf::Sprite face;
-  face.setTexture(*GetTexture(mugTexturePath));
+  face.setTexture(*GetPinnedTexture(mugTexturePath));
 
   Animation animation;
   animation.LoadWithData(GetText(mugAnimationPath));
@@ -2003,7 +2003,7 @@ void Overworld::OnlineArea::receiveQuizSignal(BufferReader& reader, const Poco::
   auto mugAnimationPath = reader.ReadString<uint16_t>(buffer);
 
   sf::Sprite face;
-  face.setTexture(*GetTexture(mugTexturePath));
+  face.setTexture(*GetPinnedTexture(mugTexturePath));
   Animation animation;
 
   animation.LoadWithData(GetText(mugAnimationPath));
@@ -2318,7 +2318,7 @@ void Overworld::OnlineArea::receivePVPSignal(BufferReader& reader, const Poco::B
     const std::string& image = meta.GetMugshotTexturePath();
     const std::string& mugshotAnim = meta.GetMugshotAnimationPath();
     const std::string& emotionsTexture = meta.GetEmotionsTexturePath();
-    auto mugshot = Textures().LoadFromFile(image);
+    auto mugshot = Textures().LoadPinnedFromFile(image);
     auto emotions = Textures().LoadFromFile(emotionsTexture);
     auto player = std::shared_ptr<Player>(meta.GetData());
 
@@ -2487,6 +2487,7 @@ void Overworld::OnlineArea::receiveMobSignal(BufferReader& reader, const Poco::B
 
   std::unique_ptr<MobFactory> mobFactory = std::unique_ptr<MobFactory>(mobMeta.GetData());
   Mob* mob = mobFactory->Build(std::make_shared<Field>(6, 3), GetText(data_path));
+  PackageAssets mobAssets = PackageAssets::Of(mobMeta);
 
   AddSceneChangeTask([=, &playerPackages, &mobPackages] {
     // Play the pre battle rumble sound
@@ -2500,7 +2501,7 @@ void Overworld::OnlineArea::receiveMobSignal(BufferReader& reader, const Poco::B
     const std::string& image = playerMeta.GetMugshotTexturePath();
     const std::string& mugshotAnim = playerMeta.GetMugshotAnimationPath();
     const std::string& emotionsTexture = playerMeta.GetEmotionsTexturePath();
-    std::shared_ptr<sf::Texture> mugshot = Textures().LoadFromFile(image);
+    std::shared_ptr<sf::Texture> mugshot = Textures().LoadPinnedFromFile(image);
     std::shared_ptr<sf::Texture> emotions = Textures().LoadFromFile(emotionsTexture);
     std::shared_ptr<Player> player = std::shared_ptr<Player>(playerMeta.GetData());
 
@@ -2540,11 +2541,13 @@ void Overworld::OnlineArea::receiveMobSignal(BufferReader& reader, const Poco::B
       sendBattleResultsSignal(results);
     };
 
+    std::vector<PackageAssets> preloadPackages = { mobAssets, PackageAssets::Of(playerMeta) };
+
     // Queue screen transition to Battle Scene with a white fade effect
     // just like the game
     if (mob->IsFreedomMission()) {
       FreedomMissionProps props{
-        { player, GetProgramAdvance(), std::move(folder), mob->GetField(), mob->GetBackground() },
+        { player, GetProgramAdvance(), std::move(folder), mob->GetField(), mob->GetBackground(), preloadPackages },
         { mob },
         mob->GetTurnLimit(),
         sf::Sprite(*mugshot),
@@ -2558,7 +2561,7 @@ void Overworld::OnlineArea::receiveMobSignal(BufferReader& reader, const Poco::B
     }
     else {
       MobBattleProperties props{
-        { player, GetProgramAdvance(), std::move(folder), mob->GetField(), mob->GetBackground() },
+        { player, GetProgramAdvance(), std::move(folder), mob->GetField(), mob->GetBackground(), preloadPackages },
         MobBattleProperties::RewardBehavior::take,
         { mob },
         sf::Sprite(*mugshot),
@@ -2992,6 +2995,13 @@ std::shared_ptr<sf::Texture> Overworld::OnlineArea::GetTexture(const std::string
   return Overworld::SceneBase::GetTexture(path);
 }
 
+std::shared_ptr<sf::Texture> Overworld::OnlineArea::GetPinnedTexture(const std::string& path) {
+  if (path.find("/server", 0) == 0) {
+    return serverAssetManager.GetPinnedTexture(path);
+  }
+  return Textures().LoadPinnedFromFile(path);
+}
+
 std::shared_ptr<sf::SoundBuffer> Overworld::OnlineArea::GetAudio(const std::string& path) {
   if (path.find("/server", 0) == 0) {
     return serverAssetManager.GetAudio(path);
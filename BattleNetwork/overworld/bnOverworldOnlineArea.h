@@ -211,6 +211,7 @@ namespace Overworld {
     virtual std::string GetText(const std::string& path);
     virtual std::shared_ptr<sf::Texture> GetTexture(const std::string& path);
     virtual std::shared_ptr<sf::SoundBuffer> GetAudio(const std::string& path);
+    std::shared_ptr<sf::Texture> GetPinnedTexture(const std::string& path); //!< GetTexture() for textures drawn by reference, such as textbox faces
 
 
   public:
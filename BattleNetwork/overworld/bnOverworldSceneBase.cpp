@@ -55,6 +55,27 @@ using namespace swoosh::types;
 
 /// \brief Thunk to populate menu options to callbacks
 namespace {
+  // UI of the folder and library scenes, which stalled while they loaded on open
+  const char* MENU_SCENE_TEXTURES[] = {
+    TexturePaths::FOLDER_INFO_BG,
+    TexturePaths::FOLDER_SCROLLBAR,
+    TexturePaths::FOLDER_BOX,
+    "resources/ui/folder_disabled.png",
+    TexturePaths::FOLDER_BOX_CURSOR,
+    TexturePaths::FOLDER_EQUIP,
+    TexturePaths::FOLDER_MB,
+    TexturePaths::FOLDER_OPTIONS,
+    TexturePaths::FOLDER_OPTIONS_NEW,
+    TexturePaths::FOLDER_VIEW_BG,
+    TexturePaths::FOLDER_DOCK,
+    TexturePaths::FOLDER_CURSOR,
+    TexturePaths::FOLDER_RARITY,
+    TexturePaths::FOLDER_CHIP_HOLDER,
+    TexturePaths::ELEMENT_ICON,
+    TexturePaths::TEXT_BOX_CURSOR,
+    TexturePaths::MUG_NAVIGATOR
+  };
+
   auto MakeOptions = [](Overworld::SceneBase* scene) -> Overworld::PersonalMenu::OptionsList {
     return {
       { "chip_folder", std::bind(&Overworld::SceneBase::GotoChipFolder, scene) },
@@ -112,6 +133,11 @@ Overworld::SceneBase::SceneBase(swoosh::ActivityController& controller) :
   menuSystem.BindMenu(InputEvents::pressed_pause, personalMenu);
   menuSystem.BindMenu(InputEvents::pressed_map, minimap);
   minimap->setScale(2.f, 2.f);
+
+  // Decoded in the background so the scenes find them cached when opened from the menu
+  for (const char* path : MENU_SCENE_TEXTURES) {
+    menuSceneTextures.push_back(Textures().LoadFromFileAsync(path));
+  }
 }
 
 void Overworld::SceneBase::onStart() {
@@ -531,6 +557,7 @@ void Overworld::SceneBase::RefreshNaviSprite()
     currentNaviId = packageManager.FirstValidPackage();
   }
 
+  const bool firstNavi = lastSelectedNaviId.empty();
   lastSelectedNaviId = currentNaviId;
 
   auto& meta = packageManager.FindPackageByID(currentNaviId);
@@ -543,10 +570,33 @@ void Overworld::SceneBase::RefreshNaviSprite()
   const auto& owPath = meta.GetOverworldAnimationPath();
 
   if (owPath.size()) {
-    if (auto tex = Textures().LoadFromFile(meta.GetOverworldTexturePath())) {
-      playerActor->setTexture(tex);
+    if (firstNavi) {
+      // Loaded now so the actor has its texture and origin as soon as the scene uses it
+      naviTextureRequest.reset();
+
+      if (auto tex = Textures().LoadFromFile(meta.GetOverworldTexturePath())) {
+        playerActor->setTexture(tex);
+      }
+      playerActor->LoadAnimations(owPath);
+    }
+    else {
+      // The sheet decodes in the background, the current navi stays until it is uploaded.
+      // Replacing the request makes callbacks for a navi picked before this one do nothing.
+      naviTextureRequest = std::make_shared<std::string>(currentNaviId);
+
+      std::weak_ptr<Actor> weakActor = playerActor;
+      std::weak_ptr<std::string> weakRequest = naviTextureRequest;
+      std::string animationPath = owPath;
+
+      Textures().LoadFromFileAsync(meta.GetOverworldTexturePath(), [weakActor, weakRequest, animationPath](const std::shared_ptr<sf::Texture>& tex) {
+        auto actor = weakActor.lock();
+
+        if (!actor || weakRequest.expired()) return;
+
+        actor->setTexture(tex);
+        actor->LoadAnimations(animationPath);
+      });
     }
-    playerActor->LoadAnimations(owPath);
 
     auto iconTexture = meta.GetIconTexture();
 
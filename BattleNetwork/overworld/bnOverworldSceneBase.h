@@ -64,6 +64,7 @@ namespace Overworld {
     sf::Vector3f cameraTrackPoint{}; // used for smooth cameras
     std::shared_ptr<PersonalMenu> personalMenu;
     std::shared_ptr<Minimap> minimap;
+    std::vector<std::shared_ptr<sf::Texture>> menuSceneTextures; /*!< Held so the folder and library UI stays cached */
 
     // Bunch of sprites and their attachments
     std::shared_ptr<Background> bg{ nullptr }; /*!< Background image pointer */
@@ -77,6 +78,7 @@ namespace Overworld {
 
     /*!< Current player package selection */
     std::string currentNaviId, lastSelectedNaviId;
+    std::shared_ptr<std::string> naviTextureRequest; /*!< Navi whose overworld sheet is loading. Replaced per request. */
 
     CardFolderCollection* folders{ nullptr }; /*!< Collection of folders */
     PA programAdvance;
@@ -151,6 +153,9 @@ namespace Overworld {
 
     /**
     * @brief Update's the player sprites according to the most recent selection
+    *
+    * The first navi is loaded immediately. After a switch the sheet is decoded
+    * in the background and the previous navi is drawn until it is ready.
     */
     void RefreshNaviSprite();
 
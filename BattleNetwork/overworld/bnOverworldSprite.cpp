@@ -20,8 +20,33 @@ namespace Overworld {
     return { layerPosition.x, layerPosition.y, elevation };
   }
 
+  uint64_t WorldSprite::currentTick = 0;
+  float WorldSprite::interpolationAlpha = 1.0f;
+
+  void WorldSprite::SetInterpolation(uint64_t tick, float alpha) {
+    currentTick = tick;
+    interpolationAlpha = alpha;
+  }
+
   void WorldSprite::draw(sf::RenderTarget& target, sf::RenderStates states) const {
     states.transform *= preTransform;
+
+    sf::Vector2f position = getPosition();
+
+    if (lastTick != currentTick) {
+      // Only smooth over a single tick, anything else is a jump
+      previousPosition = lastTick + 1 == currentTick ? tickPosition : position;
+      tickPosition = position;
+      lastTick = currentTick;
+    }
+    else if (position != tickPosition) {
+      // Moved outside of a tick e.g. teleported by a scene
+      previousPosition = tickPosition = position;
+    }
+
+    sf::Vector2f drawPosition = previousPosition + (tickPosition - previousPosition) * interpolationAlpha;
+    states.transform.translate(drawPosition - position);
+
     SpriteProxyNode::draw(target, states);
   }
 }
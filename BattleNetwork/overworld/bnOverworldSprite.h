@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <SFML/Graphics.hpp>
 #include "../bnSpriteProxyNode.h"
@@ -17,8 +18,20 @@ namespace Overworld {
     sf::Vector3f Get3DPosition() const;
 
     virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    /**
+    * @brief Sprites are drawn `alpha` of the way from their position on the previous tick to the current tick
+    * @param tick number of logic ticks run so far
+    * @param alpha 1 to draw at the current position
+    */
+    static void SetInterpolation(uint64_t tick, float alpha);
   private:
     sf::Transform preTransform;
     float elevation{};
+
+    static uint64_t currentTick;
+    static float interpolationAlpha;
+    mutable uint64_t lastTick{};
+    mutable sf::Vector2f previousPosition, tickPosition;
   };
 }
@@ -1,6 +1,7 @@
 #include "bnServerAssetManager.h"
 
 #include "../bnLogger.h"
+#include "../bnAudioResourceManager.h"
 #include <fstream>
 #include <sstream>
 #include <string_view>
@@ -102,6 +103,8 @@ static std::tuple<std::string, uint64_t> decodeName(const std::string& name) {
 
 
 Overworld::ServerAssetManager::ServerAssetManager(const std::string& host, uint16_t port) :
+  textureAssets(static_cast<size_t>(BN_SERVER_TEXTURE_CACHE_BUDGET_MB) * 1024u * 1024u),
+  audioAssets(static_cast<size_t>(BN_SERVER_AUDIO_CACHE_BUDGET_MB) * 1024u * 1024u),
   cachePath(std::string(CACHE_FOLDER) + '/' + URIEncode(host + "_p" + std::to_string(port)))
 {
   // prefix with cached- to avoid reserved names such as COM
@@ -216,21 +219,38 @@ void Overworld::ServerAssetManager::PreloadText(const std::string& name) {
 }
 
 void Overworld::ServerAssetManager::PreloadTexture(const std::string& name) {
-  if (textureAssets.find(name) == textureAssets.end()) {
-    auto data = LoadFromCache(name);
-    auto texture = std::make_shared<sf::Texture>();
-    texture->loadFromMemory(data.data(), data.size());
-    textureAssets[name] = texture;
-  }
+  LoadTexture(name, false);
 }
 
 void Overworld::ServerAssetManager::PreloadAudio(const std::string& name) {
-  if (audioAssets.find(name) == audioAssets.end()) {
-    auto data = LoadFromCache(name);
-    auto audio = std::make_shared<sf::SoundBuffer>();
-    audio->loadFromMemory(data.data(), data.size());
-    audioAssets[name] = audio;
+  LoadAudio(name);
+}
+
+std::shared_ptr<sf::Texture> Overworld::ServerAssetManager::LoadTexture(const std::string& name, bool pin) {
+  if (auto texture = textureAssets.Find(name, pin)) {
+    return texture;
+  }
+
+  auto data = LoadFromCache(name);
+  auto texture = std::make_shared<sf::Texture>();
+  texture->loadFromMemory(data.data(), data.size());
+
+  sf::Vector2u size = texture->getSize();
+  textureAssets.Insert(name, texture, static_cast<size_t>(size.x) * size.y * 4u, pin);
+  return texture;
+}
+
+std::shared_ptr<sf::SoundBuffer> Overworld::ServerAssetManager::LoadAudio(const std::string& name) {
+  if (auto audio = audioAssets.Find(name)) {
+    return audio;
   }
+
+  auto data = LoadFromCache(name);
+  auto audio = std::make_shared<sf::SoundBuffer>();
+  audio->loadFromMemory(data.data(), data.size());
+
+  audioAssets.Insert(name, audio, AudioResourceManager::SoundBufferBytes(*audio));
+  return audio;
 }
 
 std::string Overworld::ServerAssetManager::GetText(const std::string& name) {
@@ -239,13 +259,15 @@ std::string Overworld::ServerAssetManager::GetText(const std::string& name) {
 }
 
 std::shared_ptr<sf::Texture> Overworld::ServerAssetManager::GetTexture(const std::string& name) {
-  PreloadTexture(name);
-  return textureAssets[name];
+  return LoadTexture(name, false);
+}
+
+std::shared_ptr<sf::Texture> Overworld::ServerAssetManager::GetPinnedTexture(const std::string& name) {
+  return LoadTexture(name, true);
 }
 
 std::shared_ptr<sf::SoundBuffer> Overworld::ServerAssetManager::GetAudio(const std::string& name) {
-  PreloadAudio(name);
-  return audioAssets[name];
+  return LoadAudio(name);
 }
 
 std::vector<char> Overworld::ServerAssetManager::GetData(const std::string& name) {
@@ -297,8 +319,9 @@ void Overworld::ServerAssetManager::SetTexture(const std::string& name, uint64_t
   auto texture = std::make_shared<sf::Texture>();
   texture->loadFromMemory(data, length);
 
-  textureAssets.erase(name);
-  textureAssets.emplace(name, texture);
+  // assets that were not written to disk cannot be reloaded after eviction
+  sf::Vector2u size = texture->getSize();
+  textureAssets.Insert(name, texture, static_cast<size_t>(size.x) * size.y * 4u, !cache);
 }
 
 void Overworld::ServerAssetManager::SetAudio(const std::string& name, uint64_t lastModified, const char* data, size_t length, bool cache) {
@@ -309,8 +332,7 @@ void Overworld::ServerAssetManager::SetAudio(const std::string& name, uint64_t l
   auto audio = std::make_shared<sf::SoundBuffer>();
   audio->loadFromMemory(data, length);
 
-  audioAssets.erase(name);
-  audioAssets.emplace(name, audio);
+  audioAssets.Insert(name, audio, AudioResourceManager::SoundBufferBytes(*audio), !cache);
 }
 
 void Overworld::ServerAssetManager::SetData(const std::string& name, uint64_t lastModified, const char* data, size_t length, bool cache) {
@@ -338,3 +360,11 @@ void Overworld::ServerAssetManager::RemoveAsset(const std::string& name) {
   
   cachedAssets.erase(name);
 }
+
+ResourceCacheStats Overworld::ServerAssetManager::GetTextureCacheStats() const {
+  return textureAssets.GetStats();
+}
+
+ResourceCacheStats Overworld::ServerAssetManager::GetAudioCacheStats() const {
+  return audioAssets.GetStats();
+}
@@ -5,6 +5,12 @@
 #include <Poco/Buffer.h>
 #include <memory>
 #include <unordered_map>
+#include "../bnResourceCache.h"
+
+// Memory for decoded server textures and sounds kept while unused. Anything
+// not cached on disk stays in memory regardless because it cannot be reloaded.
+#define BN_SERVER_TEXTURE_CACHE_BUDGET_MB 128
+#define BN_SERVER_AUDIO_CACHE_BUDGET_MB 32
 
 namespace Overworld {
   std::string URIEncode(const std::string& name);
@@ -18,8 +24,8 @@ namespace Overworld {
     };
 
     std::unordered_map<std::string, std::string> textAssets;
-    std::unordered_map<std::string, std::shared_ptr<sf::Texture>> textureAssets;
-    std::unordered_map<std::string, std::shared_ptr<sf::SoundBuffer>> audioAssets;
+    ResourceCache<sf::Texture> textureAssets;
+    ResourceCache<sf::SoundBuffer> audioAssets;
     std::unordered_map<std::string, std::vector<char>> dataAssets;
     std::string cachePath;
     std::string cachePrefix;
@@ -27,6 +33,8 @@ namespace Overworld {
 
     void CacheAsset(const std::string& name, uint64_t lastModified, const char* data, size_t size);
     std::vector<char> LoadFromCache(const std::string& name);
+    std::shared_ptr<sf::Texture> LoadTexture(const std::string& name, bool pin);
+    std::shared_ptr<sf::SoundBuffer> LoadAudio(const std::string& name);
   public:
     ServerAssetManager(const std::string& host, uint16_t port);
 
@@ -40,6 +48,11 @@ namespace Overworld {
 
     std::string GetText(const std::string& name);
     std::shared_ptr<sf::Texture> GetTexture(const std::string& name);
+
+    /**
+     * @brief Same as GetTexture() but the texture is never evicted, for callers that keep only a reference to it
+     */
+    std::shared_ptr<sf::Texture> GetPinnedTexture(const std::string& name);
     std::shared_ptr<sf::SoundBuffer> GetAudio(const std::string& name);
     std::vector<char> GetData(const std::string& name);
 
@@ -48,5 +61,8 @@ namespace Overworld {
     void SetAudio(const std::string& name, uint64_t lastModified, const char* data, size_t length, bool cache);
     void SetData(const std::string& name, uint64_t lastModified, const char* data, size_t length, bool cache);
     void RemoveAsset(const std::string& name);
+
+    ResourceCacheStats GetTextureCacheStats() const;
+    ResourceCacheStats GetAudioCacheStats() const;
   };
 }
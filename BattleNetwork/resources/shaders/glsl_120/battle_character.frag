@@ -5,7 +5,8 @@ const int BLACKOUT = 1;
 const int HIGHLIGHT = 2;
 
 uniform sampler2D texture;
-uniform sampler2D palette;
+uniform sampler2D palette; // atlas with one palette per row
+uniform float paletteRow; // v coordinate of this sprite's palette row
 uniform bool swapPalette;
 uniform bool additiveMode;
 uniform float states[3];
@@ -50,7 +51,7 @@ vec4 highlight(in vec4 pixel) {
 }
 
 vec4 palette_swap(in vec4 pixel) {
-    vec4 color = texture2D(palette, vec2(pixel.r,0));
+    vec4 color = texture2D(palette, vec2(pixel.r, paletteRow));
     color.a = pixel.a * gl_Color.a;
     return color;
 }